@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace bench {
+
+// Keep the optimizer from discarding a benchmarked result
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Run fn `iterations` times after a short warm-up and print ns per call
+template <typename Fn>
+double run(const std::string& name, uint64_t iterations, Fn&& fn) {
+    for (uint64_t i = 0; i < iterations / 10 + 1; ++i) {
+        fn();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+    std::printf("%-40s %12.1f ns/op\n", name.c_str(), ns);
+    return ns;
+}
+
+} // namespace bench
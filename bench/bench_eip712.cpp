@@ -0,0 +1,91 @@
+// EIP-712 order hashing microbenchmark
+// Compares the json-driven encoder (type strings parsed from a types object on
+// every call) with the static Descriptor<Order> encoder, including the json
+// construction the dynamic path needs per order.
+
+#include "bench_common.hpp"
+#include <clob/eip712_struct.hpp>
+
+namespace {
+
+clob::Order sample_order() {
+    clob::Order order;
+    order.salt = "479249096354";
+    order.maker = "0xf39Fd6e51aad88F6F4ce6aB8827279cffFb92266";
+    order.signer = "0xf39Fd6e51aad88F6F4ce6aB8827279cffFb92266";
+    order.taker = "0x0000000000000000000000000000000000000000";
+    order.token_id = "71321045679252212594626385532706912750332728571942532289631379312455583992563";
+    order.maker_amount = "50000000";
+    order.taker_amount = "100000000";
+    order.expiration = "0";
+    order.nonce = "0";
+    order.fee_rate_bps = "0";
+    order.side = 0;
+    order.signature_type = 0;
+    return order;
+}
+
+clob::json order_json(const clob::Order& order) {
+    return {
+        {"salt", order.salt},
+        {"maker", order.maker},
+        {"signer", order.signer},
+        {"taker", order.taker},
+        {"tokenId", order.token_id},
+        {"makerAmount", order.maker_amount},
+        {"takerAmount", order.taker_amount},
+        {"expiration", order.expiration},
+        {"nonce", order.nonce},
+        {"feeRateBps", order.fee_rate_bps},
+        {"side", order.side},
+        {"signatureType", order.signature_type}
+    };
+}
+
+clob::json order_types() {
+    return {
+        {"Order", clob::json::array({
+            {{"name", "salt"}, {"type", "uint256"}},
+            {{"name", "maker"}, {"type", "address"}},
+            {{"name", "signer"}, {"type", "address"}},
+            {{"name", "taker"}, {"type", "address"}},
+            {{"name", "tokenId"}, {"type", "uint256"}},
+            {{"name", "makerAmount"}, {"type", "uint256"}},
+            {{"name", "takerAmount"}, {"type", "uint256"}},
+            {{"name", "expiration"}, {"type", "uint256"}},
+            {{"name", "nonce"}, {"type", "uint256"}},
+            {{"name", "feeRateBps"}, {"type", "uint256"}},
+            {{"name", "side"}, {"type", "uint8"}},
+            {{"name", "signatureType"}, {"type", "uint8"}}
+        })}
+    };
+}
+
+} // namespace
+
+int main() {
+    using namespace clob;
+    Order order = sample_order();
+    json message = order_json(order);
+    json types = order_types();
+
+    double dynamic_ns = bench::run("hash_struct json (prebuilt)", 50000, [&]() {
+        bench::do_not_optimize(eip712::hash_struct("Order", message, types));
+    });
+    bench::run("hash_struct json (built per order)", 50000, [&]() {
+        bench::do_not_optimize(eip712::hash_struct("Order", order_json(order), order_types()));
+    });
+    double static_ns = bench::run("hash_struct Descriptor<Order>", 50000, [&]() {
+        bench::do_not_optimize(eip712::hash_struct(order));
+    });
+    std::printf("%-40s %12.1fx\n", "speedup (prebuilt json)", dynamic_ns / static_ns);
+
+    bench::run("type_hash json", 50000, [&]() {
+        bench::do_not_optimize(eip712::type_hash("Order", types));
+    });
+    bench::run("type_hash Descriptor<Order>", 50000, [&]() {
+        bench::do_not_optimize(eip712::type_hash<Order>());
+    });
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+// Hex codec microbenchmark
+// Compares clob::hex against the stringstream / substr + stoi implementations
+// it replaced, on the sizes that dominate the hot path: 20-byte addresses,
+// 32-byte hashes and keys, 65-byte signatures.
+
+#include "bench_common.hpp"
+#include <clob/hex.hpp>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+// Previous eip712::hex_to_bytes
+std::vector<uint8_t> legacy_hex_to_bytes(const std::string& hex) {
+    std::string clean_hex = hex;
+    if (clean_hex.substr(0, 2) == "0x" || clean_hex.substr(0, 2) == "0X") {
+        clean_hex = clean_hex.substr(2);
+    }
+
+    std::vector<uint8_t> bytes;
+    for (size_t i = 0; i < clean_hex.length(); i += 2) {
+        std::string byte_str = clean_hex.substr(i, 2);
+        bytes.push_back(static_cast<uint8_t>(std::stoi(byte_str, nullptr, 16)));
+    }
+    return bytes;
+}
+
+// Previous eip712::bytes_to_hex
+std::string legacy_bytes_to_hex(const std::vector<uint8_t>& bytes) {
+    std::ostringstream oss;
+    oss << "0x" << std::hex << std::setfill('0');
+    for (uint8_t byte : bytes) {
+        oss << std::setw(2) << static_cast<int>(byte);
+    }
+    return oss.str();
+}
+
+void bench_size(size_t len, uint64_t iterations) {
+    std::vector<uint8_t> bytes(len);
+    for (size_t i = 0; i < len; ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    std::string encoded = clob::hex::encode(bytes);
+    std::string suffix = " (" + std::to_string(len) + " bytes)";
+
+    double legacy_enc = bench::run("legacy bytes_to_hex" + suffix, iterations, [&]() {
+        bench::do_not_optimize(legacy_bytes_to_hex(bytes));
+    });
+    double fast_enc = bench::run("hex::encode" + suffix, iterations, [&]() {
+        bench::do_not_optimize(clob::hex::encode(bytes));
+    });
+
+    std::vector<char> out(len * 2);
+    bench::run("hex::encode_to" + suffix, iterations, [&]() {
+        clob::hex::encode_to(bytes.data(), bytes.size(), out.data());
+        bench::do_not_optimize(out[0]);
+    });
+
+    double legacy_dec = bench::run("legacy hex_to_bytes" + suffix, iterations, [&]() {
+        bench::do_not_optimize(legacy_hex_to_bytes(encoded));
+    });
+    double fast_dec = bench::run("hex::decode" + suffix, iterations, [&]() {
+        bench::do_not_optimize(clob::hex::decode(encoded));
+    });
+
+    std::vector<uint8_t> buf(len);
+    bench::run("hex::decode_to" + suffix, iterations, [&]() {
+        bench::do_not_optimize(clob::hex::decode_to(encoded, buf.data()));
+    });
+
+    std::printf("  speedup: encode %.1fx, decode %.1fx\n\n", legacy_enc / fast_enc, legacy_dec / fast_dec);
+}
+
+} // namespace
+
+int main() {
+    const uint64_t iterations = 200000;
+    for (size_t len : {20, 32, 65, 256}) {
+        bench_size(len, iterations);
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Signing throughput microbenchmark
+// Compares Signer (shared pre-randomized context, per-thread clones) with
+// creating a context per signature, which is what a throwaway Signer used to
+// cost, and measures multi-threaded throughput with per-thread contexts and
+// the cost of the recovery-based signature self-check.
+
+#include "bench_common.hpp"
+#include <clob/signer.hpp>
+#include <clob/hex.hpp>
+#include <secp256k1_recovery.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const std::string PRIVATE_KEY = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+
+std::array<uint8_t, 32> message_hash(uint64_t i) {
+    std::array<uint8_t, 32> hash{};
+    for (int b = 0; b < 8; ++b) {
+        hash[31 - b] = static_cast<uint8_t>(i >> (b * 8));
+    }
+    hash[0] = 0x5a;
+    return hash;
+}
+
+// Signatures per second across `threads` threads, each with its own Signer
+double threaded_throughput(unsigned threads, uint64_t per_thread) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            clob::Signer signer(PRIVATE_KEY, 137);
+            signer.sign(message_hash(t));  // warm this thread's context
+            while (!go.load()) {}
+            for (uint64_t i = 0; i < per_thread; ++i) {
+                bench::do_not_optimize(signer.sign(message_hash(i + t)));
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go = true;
+    for (auto& w : workers) w.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(threads * per_thread) / seconds;
+}
+
+} // namespace
+
+int main() {
+    clob::Signer signer(PRIVATE_KEY, 137);
+    auto hash = message_hash(1);
+
+    bench::run("Signer::sign (per-thread context)", 5000, [&]() {
+        bench::do_not_optimize(signer.sign(hash));
+    });
+
+    // Recovery-based self-check used by OrderBuilder's verification modes
+    std::string signature = signer.sign(hash);
+    bench::run("Signer::verify (recover + compare)", 5000, [&]() {
+        bench::do_not_optimize(signer.verify(hash, signature));
+    });
+
+    bench::run("Signer construction", 2000, [&]() {
+        clob::Signer s(PRIVATE_KEY, 137);
+        bench::do_not_optimize(s.address());
+    });
+
+    // Previous behavior: a fresh context for every throwaway Signer
+    auto seckey = clob::hex::decode_array<32>(PRIVATE_KEY);
+    bench::run("context create + sign + destroy", 500, [&]() {
+        secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN);
+        secp256k1_ecdsa_recoverable_signature sig;
+        secp256k1_ecdsa_sign_recoverable(ctx, &sig, hash.data(), seckey.data(), nullptr, nullptr);
+        bench::do_not_optimize(sig);
+        secp256k1_context_destroy(ctx);
+    });
+
+    std::printf("\n");
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        double per_sec = threaded_throughput(threads, 2000);
+        std::printf("%2u threads: %10.0f signatures/s\n", threads, per_sec);
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+// Google Benchmark suite for the signing and serialization hot paths.
+// Unlike the bench_* executables this one emits machine-readable results, so
+// runs can be compared over time:
+//
+//   ./clob_benchmarks --benchmark_out=results.json --benchmark_out_format=json
+//
+// create_l2_headers is private to ClobClient; BM_L2HmacSignature measures the
+// utils::build_hmac_signature call it is made of.
+
+#include <benchmark/benchmark.h>
+#include <clob/eip712.hpp>
+#include <clob/eip712_struct.hpp>
+#include <clob/keccak.hpp>
+#include <clob/order_builder.hpp>
+#include <clob/signer.hpp>
+#include <clob/utilities.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::string PRIVATE_KEY = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+const std::string TOKEN_ID = "71321045679252212594626385532706912750332728571942532289631379312455583992563";
+const std::string API_SECRET = "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA=";
+
+clob::Order sample_order() {
+    clob::Order order;
+    order.salt = "479249096354";
+    order.maker = "0xf39Fd6e51aad88F6F4ce6aB8827279cffFb92266";
+    order.signer = "0xf39Fd6e51aad88F6F4ce6aB8827279cffFb92266";
+    order.taker = "0x0000000000000000000000000000000000000000";
+    order.token_id = TOKEN_ID;
+    order.maker_amount = "50000000";
+    order.taker_amount = "100000000";
+    order.expiration = "0";
+    order.nonce = "0";
+    order.fee_rate_bps = "0";
+    order.side = 0;
+    order.signature_type = 0;
+    return order;
+}
+
+clob::OrderArgs sample_args() {
+    clob::OrderArgs args;
+    args.token_id = TOKEN_ID;
+    args.price = 0.5;
+    args.size = 100.0;
+    args.side = clob::Side::BUY;
+    args.fee_rate_bps = 0;
+    return args;
+}
+
+std::shared_ptr<clob::Signer> shared_signer() {
+    static auto signer = std::make_shared<clob::Signer>(PRIVATE_KEY, 137);
+    return signer;
+}
+
+} // namespace
+
+// ========== Hashing ==========
+
+static void BM_Keccak256(benchmark::State& state) {
+    std::vector<uint8_t> data(static_cast<size_t>(state.range(0)), 0xab);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(clob::keccak::hash256(data));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+// 32/64: single words; 136: one rate block; 416: an encoded Order struct
+BENCHMARK(BM_Keccak256)->Arg(32)->Arg(64)->Arg(136)->Arg(416)->Arg(1024)->Arg(4096);
+
+static void BM_OrderSigningHash(benchmark::State& state) {
+    clob::Order order = sample_order();
+    auto domain_separator = clob::eip712::hash_domain({
+        {"name", "Polymarket CTF Exchange"},
+        {"version", "1"},
+        {"chainId", 137},
+        {"verifyingContract", "0x4bFb41d5B3570DeFd03C39a9A4D8dE6Bd8B8982E"}
+    });
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(clob::eip712::signing_hash(domain_separator, order));
+    }
+}
+BENCHMARK(BM_OrderSigningHash);
+
+// ========== Signing ==========
+
+static void BM_SignerSign(benchmark::State& state) {
+    auto signer = shared_signer();
+    auto digest = clob::keccak::hash256(std::string("clob_benchmarks"));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(signer->sign(digest));
+    }
+}
+BENCHMARK(BM_SignerSign);
+
+// Rounding, amount conversion, struct hash and signature
+static void BM_CreateOrder(benchmark::State& state) {
+    clob::OrderBuilder builder(shared_signer());
+    clob::OrderArgs args = sample_args();
+    clob::CreateOrderOptions options{"0.01", false};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(builder.create_order(args, options));
+    }
+}
+BENCHMARK(BM_CreateOrder);
+
+static void BM_L2HmacSignature(benchmark::State& state) {
+    std::string body = R"({"order":{"tokenId":")" + TOKEN_ID + R"("},"owner":"key","orderType":"GTC"})";
+    int64_t timestamp = 1700000000;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(clob::utils::build_hmac_signature(API_SECRET, timestamp, "POST", "/order", body));
+    }
+}
+BENCHMARK(BM_L2HmacSignature);
+
+// ========== Serialization ==========
+
+static void BM_OrderToJsonDump(benchmark::State& state) {
+    clob::OrderBuilder builder(shared_signer());
+    clob::SignedOrder order = builder.create_order(sample_args(), {"0.01", false});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(clob::utils::order_to_json(order, "api-key", clob::OrderType::GTC).dump());
+    }
+}
+BENCHMARK(BM_OrderToJsonDump);
+
+static void BM_EncodeUint256TokenId(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(clob::eip712::encode_uint256(TOKEN_ID));
+    }
+}
+BENCHMARK(BM_EncodeUint256TokenId);
+
+// Same id through the per-thread token id cache
+static void BM_EncodeTokenIdCached(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(clob::eip712::encode_token_id(TOKEN_ID));
+    }
+}
+BENCHMARK(BM_EncodeTokenIdCached);
@@ -0,0 +1,424 @@
+#pragma once
+
+// API payload fixtures for the parsing benchmarks.
+//
+// Each fixture has a name and a generator that produces a deterministic
+// payload in the shape the CLOB returns. When CLOB_BENCH_FIXTURES names a
+// directory, <dir>/<name>.json is used instead if it exists, so recorded
+// responses can replace the generated ones without code changes;
+// write_all() seeds such a directory with the generated set.
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace bench {
+namespace fixtures {
+
+using json = nlohmann::json;
+
+// ========== Field generators ==========
+
+// 77-digit decimal token id, unique per i
+inline std::string token_id(size_t i) {
+    std::string id = "71321045679252212594626385532706912750332728571942532289631379312455583992563";
+    std::string suffix = std::to_string(i);
+    id.replace(id.size() - suffix.size(), suffix.size(), suffix);
+    return id;
+}
+
+// 0x-prefixed hex string of `digits` digits, unique per i
+inline std::string hex_id(size_t i, size_t digits) {
+    static const char* HEX = "0123456789abcdef";
+    std::string out = "0x" + std::string(digits, '0');
+    for (size_t pos = out.size() - 1; i > 0 && pos >= 2; --pos, i >>= 4) {
+        out[pos] = HEX[i & 0xf];
+    }
+    return out;
+}
+
+inline std::string condition_id(size_t i) { return hex_id(i + 0x1000, 64); }
+inline std::string address(size_t i) { return hex_id(i + 0x2000, 40); }
+inline std::string tx_hash(size_t i) { return hex_id(i + 0x3000, 64); }
+
+inline std::string uuid(size_t i) {
+    char buf[40];
+    std::snprintf(buf, sizeof(buf), "%08zx-1b2c-4d3e-8f40-%012zx", i, i * 7919);
+    return buf;
+}
+
+// Price with two decimals in (0, 1)
+inline std::string price(size_t i) {
+    char buf[8];
+    std::snprintf(buf, sizeof(buf), "0.%02zu", 1 + i % 98);
+    return buf;
+}
+
+inline std::string size(size_t i) {
+    return std::to_string(5 + (i * 37) % 5000) + "." + std::to_string(i % 100);
+}
+
+// ========== Payloads ==========
+
+inline json orderbook(size_t i, size_t levels) {
+    json bids = json::array();
+    json asks = json::array();
+    for (size_t l = 0; l < levels; ++l) {
+        bids.push_back({{"price", price(49 - l % 49)}, {"size", size(l)}});
+        asks.push_back({{"price", price(50 + l % 48)}, {"size", size(l + levels)}});
+    }
+    return {
+        {"market", condition_id(i)},
+        {"asset_id", token_id(i)},
+        {"timestamp", std::to_string(1735689600000ULL + i)},
+        {"hash", hex_id(i, 40).substr(2)},
+        {"bids", bids},
+        {"asks", asks},
+        {"min_order_size", "5"},
+        {"tick_size", "0.01"},
+        {"neg_risk", i % 2 == 0}
+    };
+}
+
+inline json rewards() {
+    return {
+        {"rates", json::array({{{"asset_address", address(1)}, {"rewards_daily_rate", 25.0}}})},
+        {"min_size", 50.0},
+        {"max_spread", 3.5}
+    };
+}
+
+inline json tokens(size_t i) {
+    return json::array({
+        {{"token_id", token_id(2 * i)}, {"outcome", "Yes"}, {"price", 0.535}, {"winner", false}},
+        {{"token_id", token_id(2 * i + 1)}, {"outcome", "No"}, {"price", 0.465}, {"winner", false}}
+    });
+}
+
+inline json market(size_t i) {
+    return {
+        {"enable_order_book", true},
+        {"active", true},
+        {"closed", false},
+        {"archived", false},
+        {"accepting_orders", true},
+        {"accepting_order_timestamp", "2025-01-01T00:00:00Z"},
+        {"minimum_order_size", 5},
+        {"minimum_tick_size", 0.01},
+        {"condition_id", condition_id(i)},
+        {"question_id", hex_id(i + 0x4000, 64)},
+        {"question", "Will market " + std::to_string(i) + " resolve Yes by the end of the quarter?"},
+        {"description", "This market resolves to Yes if the stated event occurs before the end date, "
+                        "according to the resolution source. Otherwise it resolves to No."},
+        {"market_slug", "market-" + std::to_string(i)},
+        {"end_date_iso", "2026-03-31T00:00:00Z"},
+        {"game_start_time", nullptr},
+        {"seconds_delay", 0},
+        {"fpmm", address(i)},
+        {"maker_base_fee", 0},
+        {"taker_base_fee", 0},
+        {"notifications_enabled", true},
+        {"neg_risk", i % 3 == 0},
+        {"neg_risk_market_id", hex_id(i + 0x5000, 64)},
+        {"neg_risk_request_id", hex_id(i + 0x6000, 64)},
+        {"icon", "https://polymarket-upload.s3.us-east-2.amazonaws.com/icon-" + std::to_string(i) + ".png"},
+        {"image", "https://polymarket-upload.s3.us-east-2.amazonaws.com/image-" + std::to_string(i) + ".png"},
+        {"rewards", rewards()},
+        {"is_50_50_outcome", false},
+        {"tokens", tokens(i)},
+        {"tags", json::array({"Politics", "Elections", "All"})}
+    };
+}
+
+inline json simplified_market(size_t i) {
+    return {
+        {"condition_id", condition_id(i)},
+        {"tokens", tokens(i)},
+        {"rewards", rewards()},
+        {"active", true},
+        {"closed", false},
+        {"archived", false},
+        {"accepting_orders", true}
+    };
+}
+
+inline json maker_order(size_t i) {
+    return {
+        {"order_id", tx_hash(i + 0x100)},
+        {"owner", uuid(i)},
+        {"maker_address", address(i)},
+        {"matched_amount", size(i)},
+        {"price", price(i)},
+        {"fee_rate_bps", "0"},
+        {"asset_id", token_id(i % 4)},
+        {"outcome", "Yes"},
+        {"side", i % 2 ? "SELL" : "BUY"}
+    };
+}
+
+inline json trade(size_t i) {
+    json makers = json::array();
+    for (size_t m = 0; m < 1 + i % 3; ++m) {
+        makers.push_back(maker_order(i * 3 + m));
+    }
+    return {
+        {"id", uuid(i)},
+        {"taker_order_id", tx_hash(i)},
+        {"market", condition_id(i % 16)},
+        {"asset_id", token_id(i % 4)},
+        {"side", i % 2 ? "SELL" : "BUY"},
+        {"size", size(i)},
+        {"fee_rate_bps", "0"},
+        {"price", price(i)},
+        {"status", "MATCHED"},
+        {"match_time", 1735689600 + static_cast<int64_t>(i)},
+        {"last_update", 1735689660 + static_cast<int64_t>(i)},
+        {"outcome", "Yes"},
+        {"bucket_index", i % 4},
+        {"owner", uuid(i + 1)},
+        {"maker_address", address(i)},
+        {"maker_orders", makers},
+        {"transaction_hash", tx_hash(i + 0x200)},
+        {"trader_side", i % 2 ? "MAKER" : "TAKER"}
+    };
+}
+
+inline json open_order(size_t i) {
+    return {
+        {"id", tx_hash(i)},
+        {"status", "LIVE"},
+        {"owner", uuid(0)},
+        {"maker_address", address(0)},
+        {"market", condition_id(i % 16)},
+        {"asset_id", token_id(i % 4)},
+        {"side", i % 2 ? "SELL" : "BUY"},
+        {"original_size", size(i)},
+        {"size_matched", "0"},
+        {"price", price(i)},
+        {"associate_trades", json::array()},
+        {"outcome", "Yes"},
+        {"created_at", 1735689600 + static_cast<int64_t>(i)},
+        {"expiration", 0},
+        {"order_type", "GTC"}
+    };
+}
+
+// POST /order response for a taker order that crossed `fills` makers
+inline json post_order(size_t i, size_t fills) {
+    json hashes = json::array();
+    json trade_ids = json::array();
+    for (size_t f = 0; f < fills; ++f) {
+        hashes.push_back(tx_hash(i * 16 + f));
+        trade_ids.push_back(uuid(i * 16 + f));
+    }
+    return {
+        {"errorMsg", ""},
+        {"orderID", tx_hash(i + 0x400)},
+        {"status", fills > 0 ? "MATCHED" : "LIVE"},
+        {"success", true},
+        {"making_amount", std::to_string(1000000 * (fills + 1))},
+        {"taking_amount", std::to_string(2000000 * (fills + 1))},
+        {"transaction_hashes", hashes},
+        {"trade_ids", trade_ids}
+    };
+}
+
+inline json notification(size_t i) {
+    return {
+        {"type", 1 + i % 4},
+        {"owner", uuid(0)},
+        {"payload", {
+            {"asset_id", token_id(i % 4)},
+            {"condition_id", condition_id(i % 16)},
+            {"eventSlug", "event-" + std::to_string(i % 16)},
+            {"icon", "https://polymarket-upload.s3.us-east-2.amazonaws.com/icon.png"},
+            {"image", "https://polymarket-upload.s3.us-east-2.amazonaws.com/image.png"},
+            {"market", condition_id(i % 16)},
+            {"market_slug", "market-" + std::to_string(i % 16)},
+            {"matched_size", size(i)},
+            {"order_id", tx_hash(i)},
+            {"original_size", size(i + 1)},
+            {"outcome", "Yes"},
+            {"outcome_index", 0},
+            {"owner", uuid(0)},
+            {"price", price(i)},
+            {"question", "Will market " + std::to_string(i % 16) + " resolve Yes?"},
+            {"remaining_size", "0"},
+            {"seriesSlug", "series"},
+            {"side", i % 2 ? "SELL" : "BUY"},
+            {"trade_id", uuid(i)},
+            {"transaction_hash", tx_hash(i + 0x200)},
+            {"type", "GTC"}
+        }}
+    };
+}
+
+inline json page(json data, const std::string& next_cursor = "MTAw") {
+    size_t count = data.size();
+    return {{"data", std::move(data)}, {"next_cursor", next_cursor}, {"limit", count}, {"count", count}};
+}
+
+template <typename Fn>
+json array_of(size_t n, Fn&& item) {
+    json arr = json::array();
+    for (size_t i = 0; i < n; ++i) {
+        arr.push_back(item(i));
+    }
+    return arr;
+}
+
+// ========== Fixture set ==========
+
+struct Fixture {
+    std::string name;
+    std::function<json()> generate;
+};
+
+// The reward endpoints' simdjson parsers read snake_case keys while the
+// nlohmann readers expect camelCase, so those fixtures carry both spellings.
+inline const std::vector<Fixture>& all() {
+    static const std::vector<Fixture> set = {
+        // Large responses
+        {"orderbook_deep", [] { return orderbook(0, 500); }},
+        {"books_batch", [] { return array_of(50, [](size_t i) { return orderbook(i, 50); }); }},
+        {"markets_page", [] { return page(array_of(500, market)); }},
+        {"simplified_markets_page", [] { return page(array_of(500, simplified_market)); }},
+        {"trades_page", [] { return page(array_of(500, trade)); }},
+        {"open_orders_page", [] { return page(array_of(500, open_order)); }},
+        {"post_order_fills", [] { return post_order(0, 12); }},
+        {"post_orders_batch", [] { return array_of(15, [](size_t i) { return post_order(i, i % 4); }); }},
+        {"notifications", [] { return array_of(100, notification); }},
+        {"last_trades_prices", [] {
+            return array_of(500, [](size_t i) {
+                return json{{"token_id", token_id(i)}, {"price", price(i)}, {"side", i % 2 ? "SELL" : "BUY"}};
+            });
+        }},
+        {"cancel_orders", [] {
+            json not_canceled = json::object();
+            for (size_t i = 0; i < 20; ++i) {
+                not_canceled[tx_hash(i + 0x800)] = "order can't be found - already canceled or matched";
+            }
+            return json{
+                {"canceled", array_of(200, [](size_t i) { return tx_hash(i); })},
+                {"not_canceled", not_canceled},
+                {"notCanceled", not_canceled}
+            };
+        }},
+
+        // Single-value responses
+        {"tick_size", [] { return json{{"minimum_tick_size", 0.01}}; }},
+        {"neg_risk", [] { return json{{"neg_risk", false}}; }},
+        {"fee_rate", [] { return json{{"base_fee", 0}}; }},
+        {"midpoint", [] { return json{{"mid", "0.535"}}; }},
+        {"price", [] { return json{{"price", "0.54"}}; }},
+        {"spread", [] { return json{{"spread", "0.01"}}; }},
+        {"last_trade_price", [] { return json{{"price", "0.53"}, {"side", "BUY"}}; }},
+        {"api_keys", [] { return json{{"apiKeys", array_of(3, uuid)}}; }},
+        {"balance_allowance", [] {
+            return json{
+                {"balance", "1000000000"},
+                {"allowances", {
+                    {"0x4bFb41d5B3570DeFd03C39a9A4D8dE6Bd8B8982E", "115792089237316195423570985008687907853269984665640564039457584007913129639935"},
+                    {"0xC5d563A36AE78145C45a50134d48A1215220f80a", "115792089237316195423570985008687907853269984665640564039457584007913129639935"},
+                    {"0xd91E80cF2E7be2e162c6513ceD06f1dD0dA35296", "0"}
+                }}
+            };
+        }},
+        {"ban_status", [] { return json{{"closed_only", false}}; }},
+        {"order_scoring", [] { return json{{"scoring", true}}; }},
+
+        // Rewards
+        {"user_earnings_page", [] {
+            return page(array_of(100, [](size_t i) {
+                return json{
+                    {"user", address(0)}, {"market", condition_id(i)}, {"asset_id", token_id(i)},
+                    {"assetId", token_id(i)}, {"date", "2025-01-01"}, {"amount", "1.25"}
+                };
+            }));
+        }},
+        {"total_user_earnings", [] {
+            return array_of(30, [](size_t i) {
+                return json{
+                    {"user", address(0)}, {"date", "2025-01-" + std::to_string(10 + i % 20)},
+                    {"total_earnings", "12.5"}, {"totalEarnings", "12.5"},
+                    {"earnings", array_of(4, [](size_t m) {
+                        return json{{"market", condition_id(m)}, {"assetId", token_id(m)}, {"amount", "3.125"}};
+                    })}
+                };
+            });
+        }},
+        {"rewards_percentages", [] {
+            json percentages = json::object();
+            for (size_t i = 0; i < 100; ++i) {
+                percentages[condition_id(i)] = "0." + std::to_string(i % 10);
+            }
+            return json{{"date", "2025-01-01"}, {"percentages", percentages}};
+        }},
+        {"current_rewards_page", [] {
+            return page(array_of(100, [](size_t i) {
+                return json{
+                    {"market", condition_id(i)}, {"asset_id", token_id(i)}, {"assetId", token_id(i)},
+                    {"rewards_daily_rate", "25"}, {"rewardsDailyRate", "25"},
+                    {"rewards_min_size", "50"}, {"rewardsMinSize", "50"},
+                    {"rewards_max_spread", "3.5"}, {"rewardsMaxSpread", "3.5"}
+                };
+            }));
+        }},
+        {"market_rewards_page", [] {
+            return page(array_of(50, [](size_t i) {
+                return json{
+                    {"market", condition_id(i)}, {"asset_id", token_id(i)}, {"assetId", token_id(i)},
+                    {"date", "2025-01-01"},
+                    {"marketInfo", json::array({{
+                        {"market", condition_id(i)}, {"assetId", token_id(i)}, {"rewardsDailyRate", "25"},
+                        {"userInfo", json::array({{{"user", address(i)}, {"makerOrders", json::array()}}})}
+                    }})}
+                };
+            }));
+        }},
+    };
+    return set;
+}
+
+inline const Fixture& find(const std::string& name) {
+    for (const auto& fixture : all()) {
+        if (fixture.name == name) {
+            return fixture;
+        }
+    }
+    throw std::runtime_error("Unknown fixture: " + name);
+}
+
+// Recorded payload from CLOB_BENCH_FIXTURES if present, else the generated one
+inline std::string load(const std::string& name) {
+    if (const char* dir = std::getenv("CLOB_BENCH_FIXTURES")) {
+        std::ifstream in(std::string(dir) + "/" + name + ".json", std::ios::binary);
+        if (in) {
+            std::ostringstream buffer;
+            buffer << in.rdbuf();
+            return buffer.str();
+        }
+    }
+    return find(name).generate().dump();
+}
+
+// Write every generated fixture to dir/<name>.json
+inline void write_all(const std::string& dir) {
+    for (const auto& fixture : all()) {
+        std::string path = dir + "/" + fixture.name + ".json";
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot write fixture: " + path);
+        }
+        out << fixture.generate().dump(2);
+    }
+}
+
+} // namespace fixtures
+} // namespace bench
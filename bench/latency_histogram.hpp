@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace bench {
+
+// Log-linear latency histogram in nanoseconds: exact below 64 ns, then 32
+// buckets per power of two (about 3% relative error) up to the full uint64
+// range. Fixed size and allocation-free, so recording from a hot loop costs
+// a count-leading-zeros and an increment. One per thread; merge() to report.
+class LatencyHistogram {
+public:
+    void record(uint64_t ns) {
+        counts_[index(ns)]++;
+        count_++;
+        sum_ += ns;
+        min_ = std::min(min_, ns);
+        max_ = std::max(max_, ns);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0; }
+
+    // Value at quantile q in [0, 1]: midpoint of the bucket holding it,
+    // clamped to the observed range
+    uint64_t percentile(double q) const {
+        if (count_ == 0) {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count_ - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                uint64_t mid = lower_bound(i) + width(i) / 2;
+                return std::min(std::max(mid, min_), max_);
+            }
+        }
+        return max_;
+    }
+
+private:
+    static constexpr int SUB_BITS = 6;
+    static constexpr uint64_t SUB = 1ULL << SUB_BITS;  // exact range
+    static constexpr uint64_t HALF = SUB / 2;          // buckets per octave above it
+    static constexpr size_t BUCKETS = HALF * (64 - SUB_BITS + 1) + SUB;
+
+    static size_t index(uint64_t ns) {
+        if (ns < SUB) {
+            return static_cast<size_t>(ns);
+        }
+        int shift = 63 - __builtin_clzll(ns) - (SUB_BITS - 1);
+        return static_cast<size_t>(HALF * shift + (ns >> shift));
+    }
+
+    static uint64_t lower_bound(size_t i) {
+        if (i < SUB) {
+            return i;
+        }
+        int shift = static_cast<int>(i / HALF) - 1;
+        return (i % HALF + HALF) << shift;
+    }
+
+    static uint64_t width(size_t i) {
+        return i < SUB ? 1 : 1ULL << (i / HALF - 1);
+    }
+
+    std::array<uint64_t, BUCKETS> counts_{};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ = 0;
+};
+
+} // namespace bench
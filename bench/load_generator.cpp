@@ -0,0 +1,500 @@
+// Sustained order/cancel load against the mock exchange, ramping the request
+// rate to find where one client process saturates.
+//
+// N threads share an AccountManager (one connection pool, M accounts) and
+// issue an open-loop mix of requests:
+//
+//   post    create_order x batch, then one post_orders (GTC, resting)
+//   cancel  cancel_orders for up to batch of this thread's resting orders
+//   book    get_order_book
+//
+// Each step holds a target rate for --step-seconds, then raises it. Latency
+// is measured from when a request was scheduled, not when it was sent, so a
+// client that falls behind shows it as latency instead of silently sending
+// less. A step is saturated when it achieves under 95% of its target or its
+// p99 exceeds --p99-factor times the first step's.
+//
+// CPU per request is reported for the client threads alone (thread CPU
+// clocks) and for the whole process, which includes the in-process mock.
+//
+//   ./load_generator --threads 8 --accounts 4 --mix post=1,cancel=1,book=2 --max-rate 20000
+
+#include <clob/account_manager.hpp>
+#include <clob/signer.hpp>
+#include <mock_exchange.hpp>
+#include <sys/resource.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fixtures.hpp"
+#include "latency_histogram.hpp"
+
+namespace {
+
+using namespace clob;
+using Clock = std::chrono::steady_clock;
+
+const std::string TOKEN_ID = bench::fixtures::token_id(0);
+
+enum Op { POST, CANCEL, BOOK, OPS };
+const char* OP_NAMES[OPS] = {"post", "cancel", "book"};
+
+struct Options {
+    size_t threads = 8;
+    size_t accounts = 4;
+    double weights[OPS] = {1.0, 1.0, 2.0};
+    size_t batch = 5;
+    double start_rate = 500.0;
+    double rate_step = 500.0;
+    double max_rate = 20000.0;
+    double step_seconds = 3.0;
+    double p99_factor = 3.0;
+    bool full_ramp = false;
+    bool verify_orders = false;
+    int64_t latency_us = 0;
+    std::string url;  // external mock; in-process when empty
+    std::string json_path;
+};
+
+// Per-thread counters for one step
+struct ThreadStats {
+    bench::LatencyHistogram latency[OPS];
+    bench::LatencyHistogram all;
+    uint64_t errors = 0;
+    uint64_t orders_posted = 0;
+    uint64_t orders_canceled = 0;
+    double cpu_seconds = 0.0;
+};
+
+struct StepResult {
+    double target_rate = 0.0;
+    double seconds = 0.0;
+    uint64_t requests = 0;
+    ThreadStats totals;
+    double process_cpu_seconds = 0.0;
+    bool saturated = false;
+
+    double achieved_rate() const { return static_cast<double>(requests) / seconds; }
+};
+
+double thread_cpu_seconds() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+double process_cpu_seconds() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    auto seconds = [](const timeval& tv) {
+        return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+    };
+    return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+}
+
+// Deterministic wallets: private keys 0x...1001, 0x...1002, ...
+std::vector<std::shared_ptr<Signer>> make_signers(size_t count) {
+    std::vector<std::shared_ptr<Signer>> signers;
+    for (size_t i = 0; i < count; ++i) {
+        signers.push_back(std::make_shared<Signer>(bench::fixtures::hex_id(0x1001 + i, 64), POLYGON));
+    }
+    return signers;
+}
+
+class LoadGenerator {
+public:
+    LoadGenerator(const Options& options, const std::string& url)
+        : options_(options),
+          manager_(url, manager_options(options)),
+          resting_(options.threads),
+          rngs_(options.threads) {
+        auto signers = make_signers(options.accounts);
+        auto derived = manager_.derive_api_keys(signers);
+        if (!derived.errors.empty()) {
+            throw std::runtime_error("Credential derivation failed: " + derived.errors.begin()->second);
+        }
+        for (size_t i = 0; i < signers.size(); ++i) {
+            // Effectively unthrottled: the point is to find the client's own limit
+            manager_.add_account("account-" + std::to_string(i), signers[i],
+                                 derived.creds.at(signers[i]->address()), 1e9, 1e9);
+        }
+        for (size_t t = 0; t < options.threads; ++t) {
+            rngs_[t].seed(static_cast<unsigned>(t + 1));
+        }
+    }
+
+    StepResult run_step(double rate) {
+        std::vector<ThreadStats> stats(options_.threads);
+        std::vector<uint64_t> requests(options_.threads, 0);
+        auto duration = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(options_.step_seconds)
+        );
+        // Each thread paces its share of the rate; offsets spread the threads
+        auto interval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(static_cast<double>(options_.threads) / rate)
+        );
+        auto start = Clock::now() + std::chrono::milliseconds(10);
+        auto end = start + duration;
+
+        double cpu_before = process_cpu_seconds();
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < options_.threads; ++t) {
+            pool.emplace_back([&, t] {
+                ClobClient& client = manager_.account("account-" + std::to_string(t % options_.accounts));
+                double cpu_start = thread_cpu_seconds();
+                auto scheduled = start + interval * static_cast<int64_t>(t) / static_cast<int64_t>(options_.threads);
+                while (scheduled < end) {
+                    std::this_thread::sleep_until(scheduled);
+                    issue(client, t, scheduled, stats[t]);
+                    requests[t]++;
+                    scheduled += interval;
+                }
+                stats[t].cpu_seconds = thread_cpu_seconds() - cpu_start;
+            });
+        }
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        StepResult result;
+        result.target_rate = rate;
+        result.seconds = elapsed;
+        result.process_cpu_seconds = process_cpu_seconds() - cpu_before;
+        for (size_t t = 0; t < options_.threads; ++t) {
+            result.requests += requests[t];
+            for (int op = 0; op < OPS; ++op) {
+                result.totals.latency[op].merge(stats[t].latency[op]);
+            }
+            result.totals.all.merge(stats[t].all);
+            result.totals.errors += stats[t].errors;
+            result.totals.orders_posted += stats[t].orders_posted;
+            result.totals.orders_canceled += stats[t].orders_canceled;
+            result.totals.cpu_seconds += stats[t].cpu_seconds;
+        }
+        return result;
+    }
+
+    // Cancel whatever is still resting so runs start from an empty book
+    void cleanup() {
+        manager_.for_each_parallel([](const std::string&, ClobClient& client) { client.cancel_all(); });
+    }
+
+private:
+    static AccountManager::Options manager_options(const Options& options) {
+        AccountManager::Options manager_options;
+        manager_options.pool_size = options.threads;
+        return manager_options;
+    }
+
+    Op pick(size_t t) {
+        double total = options_.weights[POST] + options_.weights[CANCEL] + options_.weights[BOOK];
+        double r = std::uniform_real_distribution<double>(0.0, total)(rngs_[t]);
+        if (r < options_.weights[POST]) return POST;
+        if (r < options_.weights[POST] + options_.weights[CANCEL]) return CANCEL;
+        return BOOK;
+    }
+
+    void issue(ClobClient& client, size_t t, Clock::time_point scheduled, ThreadStats& stats) {
+        Op op = pick(t);
+        auto& resting = resting_[t];
+        // Nothing of ours to cancel yet: post instead, so cancels stay real
+        if (op == CANCEL && resting.empty()) {
+            op = POST;
+        }
+
+        try {
+            switch (op) {
+                case POST: {
+                    std::vector<std::pair<SignedOrder, OrderType>> orders;
+                    orders.reserve(options_.batch);
+                    for (size_t i = 0; i < options_.batch; ++i) {
+                        // Resting bids on ten price levels below the seeded asks
+                        OrderArgs args;
+                        args.token_id = TOKEN_ID;
+                        args.price = static_cast<double>(40 + (resting.size() + i) % 10) / 100.0;
+                        args.size = 10.0;
+                        args.side = Side::BUY;
+                        orders.emplace_back(client.create_order(args, {"0.01", false}), OrderType::GTC);
+                    }
+                    for (const auto& response : client.post_orders(orders)) {
+                        if (response.success) {
+                            resting.push_back(response.order_id);
+                            stats.orders_posted++;
+                        } else {
+                            stats.errors++;
+                        }
+                    }
+                    break;
+                }
+                case CANCEL: {
+                    size_t n = std::min(options_.batch, resting.size());
+                    std::vector<std::string> ids(resting.begin(), resting.begin() + static_cast<std::ptrdiff_t>(n));
+                    auto response = client.cancel_orders(ids);
+                    // Dropped only once the exchange answered: after a failed
+                    // request the orders still rest and are retried later
+                    resting.erase(resting.begin(), resting.begin() + static_cast<std::ptrdiff_t>(n));
+                    stats.orders_canceled += response.canceled.size();
+                    stats.errors += response.not_canceled.size();
+                    break;
+                }
+                case BOOK:
+                    client.get_order_book(TOKEN_ID);
+                    break;
+                case OPS:
+                    break;
+            }
+        } catch (const std::exception&) {
+            stats.errors++;
+        }
+
+        auto ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - scheduled).count()
+        );
+        stats.latency[op].record(ns);
+        stats.all.record(ns);
+    }
+
+    Options options_;
+    AccountManager manager_;
+    std::vector<std::deque<std::string>> resting_;  // order ids per thread
+    std::vector<std::mt19937> rngs_;
+};
+
+void print_header() {
+    std::printf("%10s %10s %9s %9s %9s %9s %9s %9s %7s %10s %10s\n",
+                "target/s", "achieved/s", "orders/s", "cancels/s", "p50 ms", "p99 ms",
+                "post p99", "cncl p99", "errors", "client us", "process us");
+}
+
+void print_step(const StepResult& step) {
+    auto ms = [](uint64_t ns) { return static_cast<double>(ns) / 1e6; };
+    double requests = static_cast<double>(std::max<uint64_t>(step.requests, 1));
+    std::printf("%10.0f %10.0f %9.0f %9.0f %9.3f %9.3f %9.3f %9.3f %7llu %10.1f %10.1f%s\n",
+                step.target_rate, step.achieved_rate(),
+                static_cast<double>(step.totals.orders_posted) / step.seconds,
+                static_cast<double>(step.totals.orders_canceled) / step.seconds,
+                ms(step.totals.all.percentile(0.50)), ms(step.totals.all.percentile(0.99)),
+                ms(step.totals.latency[POST].percentile(0.99)), ms(step.totals.latency[CANCEL].percentile(0.99)),
+                static_cast<unsigned long long>(step.totals.errors),
+                step.totals.cpu_seconds * 1e6 / requests, step.process_cpu_seconds * 1e6 / requests,
+                step.saturated ? "  <- saturated" : "");
+}
+
+void write_json(const std::string& path, const Options& options, const std::vector<StepResult>& steps) {
+    json curve = json::array();
+    for (const auto& step : steps) {
+        double requests = static_cast<double>(std::max<uint64_t>(step.requests, 1));
+        json ops = json::object();
+        for (int op = 0; op < OPS; ++op) {
+            const auto& h = step.totals.latency[op];
+            ops[OP_NAMES[op]] = {
+                {"count", h.count()},
+                {"p50_ns", h.percentile(0.50)},
+                {"p99_ns", h.percentile(0.99)},
+                {"max_ns", h.max()}
+            };
+        }
+        curve.push_back({
+            {"target_rate", step.target_rate},
+            {"achieved_rate", step.achieved_rate()},
+            {"orders_per_second", static_cast<double>(step.totals.orders_posted) / step.seconds},
+            {"cancels_per_second", static_cast<double>(step.totals.orders_canceled) / step.seconds},
+            {"p50_ns", step.totals.all.percentile(0.50)},
+            {"p99_ns", step.totals.all.percentile(0.99)},
+            {"p999_ns", step.totals.all.percentile(0.999)},
+            {"errors", step.totals.errors},
+            {"client_cpu_us_per_request", step.totals.cpu_seconds * 1e6 / requests},
+            {"process_cpu_us_per_request", step.process_cpu_seconds * 1e6 / requests},
+            {"saturated", step.saturated},
+            {"ops", ops}
+        });
+    }
+    json out = {
+        {"threads", options.threads},
+        {"accounts", options.accounts},
+        {"batch", options.batch},
+        {"mix", {{"post", options.weights[POST]}, {"cancel", options.weights[CANCEL]}, {"book", options.weights[BOOK]}}},
+        {"curve", curve}
+    };
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+    file << out.dump(2) << "\n";
+}
+
+// "post=1,cancel=1,book=2"; omitted operations get weight 0
+void parse_mix(const std::string& mix, double (&weights)[OPS]) {
+    std::fill(weights, weights + OPS, 0.0);
+    size_t pos = 0;
+    while (pos < mix.size()) {
+        size_t comma = mix.find(',', pos);
+        if (comma == std::string::npos) {
+            comma = mix.size();
+        }
+        std::string item = mix.substr(pos, comma - pos);
+        size_t eq = item.find('=');
+        std::string name = item.substr(0, eq);
+        double weight = eq == std::string::npos ? 1.0 : std::stod(item.substr(eq + 1));
+        auto it = std::find_if(std::begin(OP_NAMES), std::end(OP_NAMES),
+                               [&](const char* op) { return name == op; });
+        if (it == std::end(OP_NAMES) || weight < 0.0) {
+            throw std::runtime_error("Invalid --mix entry: " + item);
+        }
+        weights[it - std::begin(OP_NAMES)] = weight;
+        pos = comma + 1;
+    }
+    if (weights[POST] + weights[CANCEL] + weights[BOOK] <= 0.0) {
+        throw std::runtime_error("--mix needs at least one positive weight");
+    }
+}
+
+void usage(const char* argv0) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "  --threads <n>        client threads (default 8)\n"
+        "  --accounts <n>       accounts, assigned to threads round-robin (default 4)\n"
+        "  --mix <spec>         request weights, e.g. post=1,cancel=1,book=2 (default)\n"
+        "  --batch <n>          orders per post_orders / ids per cancel_orders, max 15 (default 5)\n"
+        "  --start-rate <n>     first step, requests/s (default 500)\n"
+        "  --rate-step <n>      increase per step (default 500)\n"
+        "  --max-rate <n>       last step (default 20000)\n"
+        "  --step-seconds <s>   duration of each step (default 3)\n"
+        "  --p99-factor <f>     saturation when p99 exceeds f x the first step's (default 3)\n"
+        "  --full-ramp          keep ramping after saturation\n"
+        "  --verify-orders      in-process mock recovers every order signature\n"
+        "  --latency-us <n>     latency the in-process mock adds per response\n"
+        "  --url <url>          use a running mock_exchange instead (seed it with --book %s)\n"
+        "  --json <file>        also write the throughput-latency curve as JSON\n",
+        argv0, TOKEN_ID.c_str()
+    );
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::runtime_error("Missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--threads") options.threads = std::stoul(value());
+            else if (arg == "--accounts") options.accounts = std::stoul(value());
+            else if (arg == "--mix") parse_mix(value(), options.weights);
+            else if (arg == "--batch") options.batch = std::stoul(value());
+            else if (arg == "--start-rate") options.start_rate = std::stod(value());
+            else if (arg == "--rate-step") options.rate_step = std::stod(value());
+            else if (arg == "--max-rate") options.max_rate = std::stod(value());
+            else if (arg == "--step-seconds") options.step_seconds = std::stod(value());
+            else if (arg == "--p99-factor") options.p99_factor = std::stod(value());
+            else if (arg == "--full-ramp") options.full_ramp = true;
+            else if (arg == "--verify-orders") options.verify_orders = true;
+            else if (arg == "--latency-us") options.latency_us = std::stoll(value());
+            else if (arg == "--url") options.url = value();
+            else if (arg == "--json") options.json_path = value();
+            else if (arg == "--help" || arg == "-h") {
+                usage(argv[0]);
+                return 0;
+            } else {
+                std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        if (options.threads == 0 || options.accounts == 0 || options.batch == 0 || options.batch > 15 ||
+            options.start_rate <= 0.0 || options.rate_step <= 0.0 || options.step_seconds <= 0.0) {
+            throw std::runtime_error("Invalid options; see --help");
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 2;
+    }
+
+    try {
+        std::unique_ptr<mock::MockExchange> exchange;
+        std::string url = options.url;
+        if (url.empty()) {
+            mock::MockExchange::Options exchange_options;
+            exchange_options.verify_order_signatures = options.verify_orders;
+            exchange_options.latency = std::chrono::microseconds(options.latency_us);
+            // httplib pins a worker to each keep-alive connection
+            exchange_options.threads = options.threads + 2;
+            exchange = std::make_unique<mock::MockExchange>(exchange_options);
+            exchange->add_book(TOKEN_ID, {{"0.39", "1000"}}, {{"0.51", "1000"}});
+            exchange->start();
+            url = exchange->url();
+        }
+
+        LoadGenerator generator(options, url);
+        std::printf("Load against %s: %zu threads, %zu accounts, batch %zu, mix post=%g cancel=%g book=%g\n\n",
+                    url.c_str(), options.threads, options.accounts, options.batch,
+                    options.weights[POST], options.weights[CANCEL], options.weights[BOOK]);
+        print_header();
+
+        std::vector<StepResult> steps;
+        const StepResult* saturation = nullptr;
+        for (double rate = options.start_rate; rate <= options.max_rate; rate += options.rate_step) {
+            StepResult step = generator.run_step(rate);
+            uint64_t baseline_p99 = steps.empty() ? step.totals.all.percentile(0.99)
+                                                  : steps.front().totals.all.percentile(0.99);
+            step.saturated = step.achieved_rate() < 0.95 * rate ||
+                             static_cast<double>(step.totals.all.percentile(0.99)) >
+                                 options.p99_factor * static_cast<double>(baseline_p99);
+            steps.push_back(step);
+            print_step(steps.back());
+            if (step.totals.latency[CANCEL].count() > 0 && step.totals.orders_canceled == 0) {
+                std::fprintf(stderr, "warning: no cancel succeeded at %.0f req/s; cancel throughput is not "
+                             "measured (does the exchange serve DELETE /orders?)\n", rate);
+            }
+            if (step.saturated && !options.full_ramp) {
+                break;
+            }
+        }
+        for (const auto& step : steps) {
+            if (step.saturated) {
+                saturation = &step;
+                break;
+            }
+        }
+
+        if (saturation && saturation != &steps.front()) {
+            const StepResult& sustained = *(saturation - 1);
+            std::printf("\nSaturation at %.0f req/s target; last sustained step: %.0f req/s "
+                        "(%.0f orders/s, %.0f cancels/s), p99 %.3f ms\n",
+                        saturation->target_rate, sustained.achieved_rate(),
+                        static_cast<double>(sustained.totals.orders_posted) / sustained.seconds,
+                        static_cast<double>(sustained.totals.orders_canceled) / sustained.seconds,
+                        static_cast<double>(sustained.totals.all.percentile(0.99)) / 1e6);
+        } else if (saturation) {
+            std::printf("\nSaturated at the first step (%.0f req/s); lower --start-rate\n", saturation->target_rate);
+        } else {
+            std::printf("\nNo saturation up to %.0f req/s; raise --max-rate\n", options.max_rate);
+        }
+
+        if (!options.json_path.empty()) {
+            write_json(options.json_path, options, steps);
+        }
+        generator.cleanup();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
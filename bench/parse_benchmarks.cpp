@@ -0,0 +1,163 @@
+// Response parsing benchmarks: every parse_*_simd function against the
+// nlohmann from_json path for the same payload, reporting bytes/s and
+// objects/s (book levels, page entries or array elements).
+//
+//   ./clob_parse_benchmarks --benchmark_out=parse.json --benchmark_out_format=json
+//
+// Payloads come from bench/fixtures.hpp. To benchmark recorded responses,
+// seed a directory with --write-fixtures=<dir>, replace files with captures
+// of the same name, and run with CLOB_BENCH_FIXTURES=<dir>.
+
+#include <benchmark/benchmark.h>
+#include <clob/utilities.hpp>
+#include <simdjson.h>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "fixtures.hpp"
+
+namespace {
+
+using namespace clob;
+using SimdParse = std::function<size_t(const simdjson::dom::element&)>;
+using LegacyParse = std::function<size_t(const json&)>;
+
+// Objects produced by one parse, for items/s
+template <typename T>
+size_t count(const T&) { return 1; }
+
+template <typename T>
+size_t count(const std::vector<T>& items) { return items.size(); }
+
+template <typename T>
+size_t count(const Page<T>& page) { return page.data.size(); }
+
+size_t count(const OrderBookSummaryResponse& book) { return book.bids.size() + book.asks.size(); }
+size_t count(const CancelOrdersResponse& resp) { return resp.canceled.size() + resp.not_canceled.size(); }
+size_t count(const RewardsPercentagesResponse& resp) { return resp.percentages.size(); }
+
+struct ParseCase {
+    std::string fixture;
+    SimdParse simd;
+    LegacyParse legacy;
+};
+
+template <typename T>
+ParseCase single(const std::string& fixture, T (*parse)(const simdjson::dom::element&)) {
+    return {
+        fixture,
+        [parse](const simdjson::dom::element& elem) { return count(parse(elem)); },
+        [](const json& j) { return count(j.get<T>()); }
+    };
+}
+
+template <typename T>
+ParseCase paged(const std::string& fixture, T (*parse)(const simdjson::dom::element&)) {
+    return {
+        fixture,
+        [parse](const simdjson::dom::element& elem) { return count(utils::parse_page_simd<T>(elem, parse)); },
+        [](const json& j) { return count(j.get<Page<T>>()); }
+    };
+}
+
+template <typename T>
+ParseCase listed(const std::string& fixture, T (*parse)(const simdjson::dom::element&)) {
+    return {
+        fixture,
+        [parse](const simdjson::dom::element& elem) {
+            return count(utils::parse_vector_simd<T>(elem.get_array().value(), parse));
+        },
+        [](const json& j) { return count(j.get<std::vector<T>>()); }
+    };
+}
+
+std::vector<ParseCase> parse_cases() {
+    return {
+        single("orderbook_deep", utils::parse_orderbook_simd),
+        listed("books_batch", utils::parse_orderbook_simd),
+        paged("markets_page", utils::parse_market_simd),
+        paged("simplified_markets_page", utils::parse_simplified_market_simd),
+        paged("trades_page", utils::parse_trade_simd),
+        paged("open_orders_page", utils::parse_open_order_simd),
+        single("post_order_fills", utils::parse_post_order_simd),
+        listed("post_orders_batch", utils::parse_post_order_simd),
+        listed("notifications", utils::parse_notification_simd),
+        listed("last_trades_prices", utils::parse_last_trades_prices_simd),
+        single("cancel_orders", utils::parse_cancel_orders_simd),
+        single("tick_size", utils::parse_tick_size_simd),
+        single("neg_risk", utils::parse_neg_risk_simd),
+        single("fee_rate", utils::parse_fee_rate_simd),
+        single("midpoint", utils::parse_midpoint_simd),
+        single("price", utils::parse_price_simd),
+        single("spread", utils::parse_spread_simd),
+        single("last_trade_price", utils::parse_last_trade_price_simd),
+        single("api_keys", utils::parse_api_keys_simd),
+        single("balance_allowance", utils::parse_balance_allowance_simd),
+        single("ban_status", utils::parse_ban_status_simd),
+        single("order_scoring", utils::parse_order_scoring_simd),
+        paged("user_earnings_page", utils::parse_user_earning_simd),
+        listed("total_user_earnings", utils::parse_total_user_earning_simd),
+        single("rewards_percentages", utils::parse_rewards_percentages_simd),
+        paged("current_rewards_page", utils::parse_current_reward_simd),
+        paged("market_rewards_page", utils::parse_market_reward_simd),
+    };
+}
+
+// Both variants include tokenizing the payload, as the client does per response
+void register_case(const ParseCase& parse_case) {
+    auto payload = std::make_shared<const std::string>(bench::fixtures::load(parse_case.fixture));
+
+    benchmark::RegisterBenchmark(("simdjson/" + parse_case.fixture).c_str(),
+        [payload, simd = parse_case.simd](benchmark::State& state) {
+            simdjson::dom::parser parser;
+            simdjson::padded_string padded(*payload);
+            size_t items = 0;
+            for (auto _ : state) {
+                simdjson::dom::element elem = parser.parse(padded);
+                items = simd(elem);
+                benchmark::DoNotOptimize(items);
+            }
+            state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload->size()));
+            state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * items));
+        });
+
+    benchmark::RegisterBenchmark(("nlohmann/" + parse_case.fixture).c_str(),
+        [payload, legacy = parse_case.legacy](benchmark::State& state) {
+            size_t items = 0;
+            for (auto _ : state) {
+                items = legacy(json::parse(*payload));
+                benchmark::DoNotOptimize(items);
+            }
+            state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload->size()));
+            state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * items));
+        });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string write_flag = "--write-fixtures=";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind(write_flag, 0) == 0) {
+            bench::fixtures::write_all(arg.substr(write_flag.size()));
+            std::printf("Wrote %zu fixtures to %s\n", bench::fixtures::all().size(),
+                        arg.substr(write_flag.size()).c_str());
+            return 0;
+        }
+    }
+
+    for (const auto& parse_case : parse_cases()) {
+        register_case(parse_case);
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,500 @@
+// Tick-to-order latency against an in-process mock exchange.
+//
+// Each iteration takes one book update through the full order path and
+// times every stage:
+//
+//   decide     parse the book update (simdjson), price it with
+//              calculate_buy_market_price
+//   sign       create_market_order (EIP-712 hash + secp256k1)
+//   serialize  order_to_json(...).dump()
+//   hmac       L2 POLY_SIGNATURE over the body
+//   send       request written to the socket
+//   ttfb       send complete -> first response byte
+//   parse      rest of the response read, parse_post_order_simd
+//
+// Requests go over a raw keep-alive socket per thread rather than
+// HttpClient, which would fold send and TTFB into a single call. Orders are
+// FOK so the mock reports them MATCHED without growing its book.
+//
+//   ./tick_to_order --iterations 200000 --threads 1,4,8 --json ttl.json
+
+#include <clob/order_builder.hpp>
+#include <clob/client.hpp>
+#include <clob/signer.hpp>
+#include <clob/utilities.hpp>
+#include <clob/constants.hpp>
+#include <mock_exchange.hpp>
+#include <simdjson.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fixtures.hpp"
+#include "latency_histogram.hpp"
+
+namespace {
+
+using namespace clob;
+using Clock = std::chrono::steady_clock;
+
+const std::string PRIVATE_KEY = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+const std::string TOKEN_ID = bench::fixtures::token_id(0);
+constexpr size_t BOOK_UPDATES = 64;
+constexpr size_t WARMUP = 1000;
+
+enum Stage { DECIDE, SIGN, SERIALIZE, HMAC, SEND, TTFB, PARSE, TOTAL, STAGES };
+const char* STAGE_NAMES[STAGES] = {"decide", "sign", "serialize", "hmac", "send", "ttfb", "parse", "total"};
+
+struct Options {
+    uint64_t iterations = 200000;
+    std::vector<size_t> threads = {1, 4};
+    bool verify_orders = false;
+    int64_t latency_us = 0;
+    std::string json_path;
+};
+
+struct StageHistograms {
+    bench::LatencyHistogram stage[STAGES];
+    uint64_t errors = 0;
+
+    void merge(const StageHistograms& other) {
+        for (int s = 0; s < STAGES; ++s) {
+            stage[s].merge(other.stage[s]);
+        }
+        errors += other.errors;
+    }
+};
+
+struct LevelResult {
+    size_t threads = 0;
+    double seconds = 0.0;
+    StageHistograms histograms;
+};
+
+uint64_t elapsed_ns(Clock::time_point from, Clock::time_point to) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+}
+
+// Book updates as they would arrive from the feed, asks best-first
+std::vector<simdjson::padded_string> book_updates() {
+    std::vector<simdjson::padded_string> updates;
+    for (size_t i = 0; i < BOOK_UPDATES; ++i) {
+        auto book = bench::fixtures::orderbook(i, 10);
+        book["asset_id"] = TOKEN_ID;
+        book["neg_risk"] = false;
+        updates.emplace_back(book.dump());
+    }
+    return updates;
+}
+
+// One keep-alive HTTP/1.1 connection to the mock, Nagle off
+class Connection {
+public:
+    explicit Connection(int port) : buffer_(1 << 16) {
+        fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd_ < 0) {
+            throw std::runtime_error("socket() failed");
+        }
+        int one = 1;
+        ::setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(port));
+        ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        if (::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(fd_);
+            throw std::runtime_error("connect() to mock exchange failed");
+        }
+    }
+
+    ~Connection() { ::close(fd_); }
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    void send_all(const std::string& request) {
+        size_t sent = 0;
+        while (sent < request.size()) {
+            ssize_t n = ::send(fd_, request.data() + sent, request.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) {
+                throw std::runtime_error("send() failed");
+            }
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    // Block until the first bytes of the response arrive
+    void await_first_byte() {
+        filled_ = 0;
+        receive();
+    }
+
+    // Read the rest of the response; returns the body, which stays valid
+    // (with simdjson padding after it) until the next request
+    std::pair<const char*, size_t> finish_response(int& status) {
+        size_t header_end;
+        while ((header_end = find_header_end()) == std::string::npos) {
+            receive();
+        }
+        status = std::atoi(buffer_.data() + 9);  // "HTTP/1.1 200"
+        size_t length = content_length(header_end);
+        size_t body = header_end + 4;
+        if (body + length + simdjson::SIMDJSON_PADDING > buffer_.size()) {
+            throw std::runtime_error("response larger than receive buffer");
+        }
+        while (filled_ < body + length) {
+            receive();
+        }
+        std::memset(buffer_.data() + body + length, 0, simdjson::SIMDJSON_PADDING);
+        return {buffer_.data() + body, length};
+    }
+
+private:
+    void receive() {
+        ssize_t n = ::recv(fd_, buffer_.data() + filled_, buffer_.size() - filled_ - simdjson::SIMDJSON_PADDING, 0);
+        if (n <= 0) {
+            throw std::runtime_error("connection closed by mock exchange");
+        }
+        filled_ += static_cast<size_t>(n);
+    }
+
+    size_t find_header_end() const {
+        for (size_t i = 0; i + 3 < filled_; ++i) {
+            if (std::memcmp(buffer_.data() + i, "\r\n\r\n", 4) == 0) {
+                return i;
+            }
+        }
+        return std::string::npos;
+    }
+
+    size_t content_length(size_t header_end) const {
+        static const char NAME[] = "content-length:";
+        const size_t name_len = sizeof(NAME) - 1;
+        for (size_t i = 0; i + name_len < header_end; ++i) {
+            if (buffer_[i] == '\n' && strncasecmp(buffer_.data() + i + 1, NAME, name_len) == 0) {
+                return std::strtoull(buffer_.data() + i + 1 + name_len, nullptr, 10);
+            }
+        }
+        throw std::runtime_error("response without Content-Length");
+    }
+
+    int fd_ = -1;
+    std::vector<char> buffer_;
+    size_t filled_ = 0;
+};
+
+struct Worker {
+    Worker(int port, const ApiCreds& creds)
+        : signer(std::make_shared<Signer>(PRIVATE_KEY, POLYGON)),
+          builder(signer),
+          creds(creds),
+          connection(port),
+          host_line("Host: 127.0.0.1:" + std::to_string(port) + "\r\n") {}
+
+    // One tick-to-order pass; records into `out` unless warming up
+    void iterate(const simdjson::padded_string& update, double amount, StageHistograms* out) {
+        auto t0 = Clock::now();
+
+        simdjson::dom::element book_elem = parser.parse(update);
+        OrderBookSummaryResponse book = utils::parse_orderbook_simd(book_elem);
+        MarketOrderArgs args;
+        args.token_id = book.asset_id;
+        args.amount = amount;
+        args.side = Side::BUY;
+        args.order_type = OrderType::FOK;
+        args.price = builder.calculate_buy_market_price(book.asks, amount, OrderType::FOK);
+        auto t1 = Clock::now();
+
+        // Tick size as the client caches it from /tick-size (the mock's default)
+        SignedOrder order = builder.create_market_order(args, {"0.01", book.neg_risk});
+        auto t2 = Clock::now();
+
+        std::string body = utils::order_to_json(order, creds.api_key, OrderType::FOK).dump();
+        auto t3 = Clock::now();
+
+        int64_t timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count();
+        std::string signature = utils::build_hmac_signature(
+            creds.api_secret, timestamp, "POST", endpoints::POST_ORDER, body
+        );
+        auto t4 = Clock::now();
+
+        std::string request;
+        request.reserve(body.size() + 512);
+        request += "POST ";
+        request += endpoints::POST_ORDER;
+        request += " HTTP/1.1\r\n";
+        request += host_line;
+        request += "Content-Type: application/json\r\nContent-Length: ";
+        request += std::to_string(body.size());
+        request += "\r\nPOLY_ADDRESS: ";
+        request += signer->address();
+        request += "\r\nPOLY_API_KEY: ";
+        request += creds.api_key;
+        request += "\r\nPOLY_PASSPHRASE: ";
+        request += creds.api_passphrase;
+        request += "\r\nPOLY_SIGNATURE: ";
+        request += signature;
+        request += "\r\nPOLY_TIMESTAMP: ";
+        request += std::to_string(timestamp);
+        request += "\r\n\r\n";
+        request += body;
+        connection.send_all(request);
+        auto t5 = Clock::now();
+
+        connection.await_first_byte();
+        auto t6 = Clock::now();
+
+        int status = 0;
+        auto response = connection.finish_response(status);
+        bool accepted = false;
+        if (status == 200) {
+            simdjson::dom::element response_elem = parser.parse(response.first, response.second, false);
+            accepted = utils::parse_post_order_simd(response_elem).success;
+        }
+        auto t7 = Clock::now();
+
+        if (!out) {
+            return;
+        }
+        if (!accepted) {
+            out->errors++;
+        }
+        out->stage[DECIDE].record(elapsed_ns(t0, t1));
+        out->stage[SIGN].record(elapsed_ns(t1, t2));
+        out->stage[SERIALIZE].record(elapsed_ns(t2, t3));
+        out->stage[HMAC].record(elapsed_ns(t3, t4));
+        out->stage[SEND].record(elapsed_ns(t4, t5));
+        out->stage[TTFB].record(elapsed_ns(t5, t6));
+        out->stage[PARSE].record(elapsed_ns(t6, t7));
+        out->stage[TOTAL].record(elapsed_ns(t0, t7));
+    }
+
+    std::shared_ptr<Signer> signer;
+    OrderBuilder builder;
+    ApiCreds creds;
+    Connection connection;
+    std::string host_line;
+    simdjson::dom::parser parser;
+};
+
+LevelResult run_level(int port, const ApiCreds& creds, size_t threads, uint64_t iterations,
+                      const std::vector<simdjson::padded_string>& updates) {
+    std::vector<StageHistograms> per_thread(threads);
+    std::vector<std::thread> pool;
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::atomic<bool> failed{false};
+    std::vector<std::string> errors(threads);
+
+    for (size_t t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            try {
+                Worker worker(port, creds);
+                for (size_t i = 0; i < WARMUP; ++i) {
+                    worker.iterate(updates[i % updates.size()], 50.0, nullptr);
+                }
+                ready++;
+                while (!go) {
+                    std::this_thread::yield();
+                }
+                uint64_t share = iterations / threads + (t < iterations % threads ? 1 : 0);
+                for (uint64_t i = 0; i < share; ++i) {
+                    // 50-225 USDC: mostly the top ask, sometimes the second level
+                    double amount = 50.0 + 25.0 * static_cast<double>((i + t) % 8);
+                    worker.iterate(updates[(i + t) % updates.size()], amount, &per_thread[t]);
+                }
+            } catch (const std::exception& e) {
+                errors[t] = e.what();
+                failed = true;
+                ready++;
+            }
+        });
+    }
+
+    while (ready < threads) {
+        std::this_thread::yield();
+    }
+    auto start = Clock::now();
+    go = true;
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (failed) {
+        for (const auto& error : errors) {
+            if (!error.empty()) {
+                throw std::runtime_error(error);
+            }
+        }
+    }
+
+    LevelResult result;
+    result.threads = threads;
+    result.seconds = seconds;
+    for (const auto& histograms : per_thread) {
+        result.histograms.merge(histograms);
+    }
+    return result;
+}
+
+void print_level(const LevelResult& level) {
+    const auto& total = level.histograms.stage[TOTAL];
+    std::printf("\n%zu thread(s): %llu orders in %.2f s, %.0f orders/s, %llu rejected\n",
+                level.threads, static_cast<unsigned long long>(total.count()), level.seconds,
+                static_cast<double>(total.count()) / level.seconds,
+                static_cast<unsigned long long>(level.histograms.errors));
+    std::printf("%-10s %10s %10s %10s %10s %10s %10s\n", "stage (us)", "mean", "p50", "p90", "p99", "p99.9", "max");
+    for (int s = 0; s < STAGES; ++s) {
+        const auto& h = level.histograms.stage[s];
+        std::printf("%-10s %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n", STAGE_NAMES[s],
+                    h.mean() / 1e3, h.percentile(0.50) / 1e3, h.percentile(0.90) / 1e3,
+                    h.percentile(0.99) / 1e3, h.percentile(0.999) / 1e3, h.max() / 1e3);
+    }
+}
+
+void write_json(const std::string& path, const std::vector<LevelResult>& levels) {
+    json out = json::array();
+    for (const auto& level : levels) {
+        json stages = json::object();
+        for (int s = 0; s < STAGES; ++s) {
+            const auto& h = level.histograms.stage[s];
+            stages[STAGE_NAMES[s]] = {
+                {"count", h.count()},
+                {"mean_ns", h.mean()},
+                {"min_ns", h.min()},
+                {"p50_ns", h.percentile(0.50)},
+                {"p90_ns", h.percentile(0.90)},
+                {"p99_ns", h.percentile(0.99)},
+                {"p999_ns", h.percentile(0.999)},
+                {"max_ns", h.max()}
+            };
+        }
+        out.push_back({
+            {"threads", level.threads},
+            {"seconds", level.seconds},
+            {"rejected", level.histograms.errors},
+            {"stages", stages}
+        });
+    }
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+    file << out.dump(2) << "\n";
+}
+
+std::vector<size_t> parse_thread_list(const std::string& list) {
+    std::vector<size_t> threads;
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t comma = list.find(',', pos);
+        if (comma == std::string::npos) {
+            comma = list.size();
+        }
+        size_t n = std::stoul(list.substr(pos, comma - pos));
+        if (n == 0) {
+            throw std::runtime_error("thread counts must be positive");
+        }
+        threads.push_back(n);
+        pos = comma + 1;
+    }
+    return threads;
+}
+
+void usage(const char* argv0) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "  --iterations <n>     timed orders per concurrency level (default 200000)\n"
+        "  --threads <list>     comma-separated concurrency levels (default 1,4)\n"
+        "  --latency-us <n>     latency the mock adds per response\n"
+        "  --verify-orders      have the mock recover every order signature\n"
+        "  --json <file>        also write per-stage percentiles as JSON\n",
+        argv0
+    );
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--iterations") options.iterations = std::stoull(value());
+        else if (arg == "--threads") options.threads = parse_thread_list(value());
+        else if (arg == "--latency-us") options.latency_us = std::stoll(value());
+        else if (arg == "--verify-orders") options.verify_orders = true;
+        else if (arg == "--json") options.json_path = value();
+        else if (arg == "--help" || arg == "-h") {
+            usage(argv[0]);
+            return 0;
+        } else {
+            std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    mock::MockExchange::Options exchange_options;
+    exchange_options.verify_order_signatures = options.verify_orders;
+    exchange_options.latency = std::chrono::microseconds(options.latency_us);
+    // httplib pins a worker to each keep-alive connection
+    exchange_options.threads = *std::max_element(options.threads.begin(), options.threads.end()) + 2;
+
+    try {
+        mock::MockExchange exchange(exchange_options);
+        exchange.add_book(TOKEN_ID, {{"0.49", "1000"}}, {{"0.51", "1000"}});
+        int port = exchange.start();
+
+        ApiCreds creds;
+        {
+            // Scoped so its keep-alive connection does not hold a server worker
+            ClobClient l1(exchange.url(), std::make_shared<Signer>(PRIVATE_KEY, POLYGON));
+            creds = l1.create_or_derive_api_creds();
+        }
+
+        auto updates = book_updates();
+        std::printf("Tick-to-order against %s: %llu orders per level, order signatures %s\n",
+                    exchange.url().c_str(), static_cast<unsigned long long>(options.iterations),
+                    options.verify_orders ? "verified" : "not verified");
+
+        std::vector<LevelResult> levels;
+        for (size_t threads : options.threads) {
+            levels.push_back(run_level(port, creds, threads, options.iterations, updates));
+            print_level(levels.back());
+        }
+
+        if (!options.json_path.empty()) {
+            write_json(options.json_path, levels);
+        }
+        exchange.stop();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
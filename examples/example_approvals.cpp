@@ -43,13 +43,14 @@ int main() {
         // Create approval helper
         clob::ApprovalHelper helper(private_key);
         
-        // Check current status
+        // Check current status (all four checks in one multicall)
         std::cout << "=== Checking Current Approvals ===" << std::endl;
         
-        bool usdc_exchange = helper.has_usdc_exchange_approval();
-        bool usdc_neg_risk = helper.has_usdc_neg_risk_approval();
-        bool ctf_exchange = helper.has_ctf_exchange_approval();
-        bool ctf_neg_risk = helper.has_ctf_neg_risk_approval();
+        auto status = helper.check_approvals();
+        bool usdc_exchange = status.usdc_exchange;
+        bool usdc_neg_risk = status.usdc_neg_risk;
+        bool ctf_exchange = status.ctf_exchange;
+        bool ctf_neg_risk = status.ctf_neg_risk;
         
         std::cout << "USDC -> Exchange:          " << (usdc_exchange ? "[OK] Approved" : "[  ] Not approved") << std::endl;
         std::cout << "USDC -> Neg-Risk Exchange: " << (usdc_neg_risk ? "[OK] Approved" : "[  ] Not approved") << std::endl;
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "client.hpp"
+#include "credential_store.hpp"
+#include "http_client.hpp"
+
+namespace clob {
+
+// Token bucket rate limiter: refills at `rate` tokens per second up to `burst`
+class TokenBucket {
+public:
+    TokenBucket(double rate, double burst);
+
+    // Take tokens if available; never blocks
+    bool try_acquire(double tokens = 1.0);
+
+    // Take tokens, sleeping until the bucket has refilled enough
+    void acquire(double tokens = 1.0);
+
+    double available() const;
+    double rate() const { return rate_; }
+    double burst() const { return burst_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Tokens held at `now`; caller holds mutex_
+    double level(Clock::time_point now) const;
+
+    mutable std::mutex mutex_;
+    double rate_;
+    double burst_;
+    double tokens_;
+    Clock::time_point last_;
+};
+
+// Hosts many accounts (signer + API credentials) in one process over one
+// HttpClient connection pool and one market metadata cache. Each account is a
+// ClobClient, so requests carry that account's L1/L2 headers, and its L2
+// requests are throttled by the account's own TokenBucket.
+class AccountManager {
+public:
+    struct Options {
+        size_t pool_size = 4;               // shared keep-alive connections
+        double requests_per_second = 10.0;  // default per-account L2 rate
+        double burst = 20.0;                // default per-account burst
+    };
+
+    struct AccountResult {
+        std::string name;
+        bool success = false;
+        std::string error;
+    };
+
+    // Batch derivation outcome, keyed by lowercase wallet address
+    struct DerivedCredentials {
+        std::map<std::string, ApiCreds> creds;
+        std::map<std::string, std::string> errors;
+        size_t from_store = 0;  // entries served from the CredentialStore
+    };
+
+    explicit AccountManager(const std::string& host);
+    AccountManager(const std::string& host, const Options& options);
+    ~AccountManager();
+
+    AccountManager(const AccountManager&) = delete;
+    AccountManager& operator=(const AccountManager&) = delete;
+
+    // Register an account under `name` with the default rate limit, or an
+    // explicit one. Throws if the name is taken. The returned reference stays
+    // valid until the account is removed.
+    ClobClient& add_account(
+        const std::string& name,
+        std::shared_ptr<Signer> signer,
+        const std::optional<ApiCreds>& creds = std::nullopt
+    );
+    ClobClient& add_account(
+        const std::string& name,
+        std::shared_ptr<Signer> signer,
+        const std::optional<ApiCreds>& creds,
+        double requests_per_second,
+        double burst
+    );
+
+    bool remove_account(const std::string& name);
+    bool has_account(const std::string& name) const;
+    size_t size() const;
+    std::vector<std::string> account_names() const;
+
+    // Client for a registered account; throws if unknown
+    ClobClient& account(const std::string& name);
+    TokenBucket& rate_limiter(const std::string& name);
+
+    // Run fn once per account, concurrently (one task per account). Exceptions
+    // are caught and reported per account; results are in name order.
+    std::vector<AccountResult> for_each_parallel(
+        const std::function<void(const std::string&, ClobClient&)>& fn
+    );
+
+    // Derive API credentials for many wallets at once. L1 headers are signed
+    // on worker threads and the derive requests share the connection pool;
+    // a failed wallet is reported in errors without affecting the others.
+    DerivedCredentials derive_api_keys(
+        const std::vector<std::shared_ptr<Signer>>& signers,
+        std::optional<uint32_t> nonce = std::nullopt
+    );
+
+    // As above, but wallets already in store are not derived again, and newly
+    // derived credentials are merged into it
+    DerivedCredentials derive_api_keys(
+        const std::vector<std::shared_ptr<Signer>>& signers,
+        const CredentialStore& store,
+        std::optional<uint32_t> nonce = std::nullopt
+    );
+
+    // Shared transport and cache
+    HttpClient& transport() { return *http_; }
+    MarketMetadataCache& metadata() { return *metadata_; }
+
+    // One warm-up and heartbeat for all accounts
+    bool warm_connections() { return http_->warm_connection(); }
+    void start_heartbeat(int interval_seconds = 25) { http_->start_heartbeat(interval_seconds); }
+    void stop_heartbeat() { http_->stop_heartbeat(); }
+
+private:
+    struct Account {
+        std::unique_ptr<ClobClient> client;
+        std::shared_ptr<TokenBucket> limiter;
+    };
+
+    Options options_;
+    std::shared_ptr<HttpClient> http_;
+    std::shared_ptr<MarketMetadataCache> metadata_;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Account> accounts_;
+
+    Account& find(const std::string& name);
+};
+
+} // namespace clob
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <array>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
 #include <unordered_map>
 #include "types.hpp"
 #include "constants.hpp"
@@ -13,6 +17,43 @@ namespace clob {
 // Forward declare ConnectionStats (defined in http_client.hpp)
 struct ConnectionStats;
 
+// Forward declare TokenBucket (defined in account_manager.hpp)
+class TokenBucket;
+
+// Market metadata (tick size, neg risk, fee rate) by token id. Thread-safe,
+// so ClobClients on the same host can share one (see AccountManager).
+class MarketMetadataCache {
+public:
+    template <typename T>
+    std::optional<T> find(const std::string& token_id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto& map = std::get<Map<T>>(maps_);
+        auto it = map.find(token_id);
+        if (it == map.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+    
+    template <typename T>
+    void put(const std::string& token_id, const T& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::get<Map<T>>(maps_)[token_id] = value;
+    }
+    
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        maps_ = {};
+    }
+    
+private:
+    template <typename T>
+    using Map = std::unordered_map<std::string, T>;
+    
+    mutable std::mutex mutex_;
+    std::tuple<Map<TickSizeResponse>, Map<NegRiskResponse>, Map<FeeRateResponse>> maps_;
+};
+
 class ClobClient {
 public:
     // Constructor for different auth levels
@@ -29,6 +70,19 @@ public:
         const ApiCreds& creds
     );
     
+    // Shared transport: one client per account over a shared connection pool
+    // and metadata cache (see AccountManager). Mode follows signer / creds.
+    ClobClient(
+        std::shared_ptr<HttpClient> http,
+        std::shared_ptr<MarketMetadataCache> metadata,
+        std::shared_ptr<Signer> signer,
+        const std::optional<ApiCreds>& creds = std::nullopt
+    );
+    
+    // Throttle authenticated (L2) requests; each one takes a token, waiting
+    // if the bucket is empty. nullptr disables.
+    void set_rate_limiter(std::shared_ptr<TokenBucket> limiter) { rate_limiter_ = std::move(limiter); }
+    
     // Get current authentication level
     AuthLevel get_mode() const { return mode_; }
     
@@ -115,6 +169,13 @@ public:
         const CreateOrderOptions& options
     );
     
+    // Local signature self-check for created orders (see SignatureVerification)
+    // With Parallel, the check overlaps the HTTP send; post_order/post_orders
+    // wait for it after parsing the response; a failed check sets signature_verified = false
+    // and error_msg on that order's response instead of throwing, since the order may be live
+    void set_signature_verification(SignatureVerification mode);
+    OrderBuilder::VerificationStats get_verification_stats() const;
+    
     // Order queries
     OpenOrderResponse get_order(const std::string& order_id);
     Page<OpenOrderResponse> get_orders(
@@ -182,16 +243,28 @@ public:
 
 private:
     std::string host_;
-    std::unique_ptr<HttpClient> http_;
+    std::shared_ptr<HttpClient> http_;
     std::shared_ptr<Signer> signer_;
     std::optional<ApiCreds> creds_;
     std::unique_ptr<OrderBuilder> builder_;
     AuthLevel mode_;
     
-    // Local caches
-    std::unordered_map<std::string, TickSizeResponse> tick_sizes_;
-    std::unordered_map<std::string, NegRiskResponse> neg_risk_;
-    std::unordered_map<std::string, FeeRateResponse> fee_rates_;
+    // Market metadata cache (owned, or shared through AccountManager)
+    std::shared_ptr<MarketMetadataCache> metadata_;
+    std::shared_ptr<TokenBucket> rate_limiter_;
+    
+    // L1 auth: the ClobAuth encoding with the per-signer fields (type hash,
+    // address, message hash) filled in once, and the last signature, reused
+    // while the nonce and timestamp second match
+    struct L1AuthCache {
+        bool primed = false;
+        std::array<uint8_t, 32> domain_separator{};
+        std::array<uint8_t, 160> encoded{};  // encode_struct(ClobAuth)
+        uint32_t nonce = 0;
+        int64_t timestamp = -1;
+        std::string signature;
+    };
+    L1AuthCache l1_auth_;
     
     // Helper methods
     void assert_level_1_auth() const;
@@ -199,6 +272,7 @@ private:
     AuthLevel get_client_mode() const;
     
     // Header creation
+    const std::string& l1_signature(uint32_t nonce, int64_t timestamp);
     Headers create_l1_headers(std::optional<uint32_t> nonce = std::nullopt);
     Headers create_l2_headers(
         const std::string& method,
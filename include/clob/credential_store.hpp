@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include "types.hpp"
+
+namespace clob {
+
+// On-disk cache of API credentials keyed by lowercase wallet address,
+// encrypted with AES-256-GCM under a local 32-byte key. Lets a restart skip
+// L1 derivation for wallets it has already seen (see
+// AccountManager::derive_api_keys).
+//
+// File format (JSON): {"version": 1, "iv": hex, "tag": hex, "data": hex}, where
+// data is the ciphertext of {"<address>": {"apiKey", "secret", "passphrase"}}.
+// Writes go to a temporary file that is renamed over the target; both the
+// store and key files are created owner-read/write only.
+class CredentialStore {
+public:
+    using Key = std::array<uint8_t, 32>;
+
+    CredentialStore(const std::string& path, const Key& key);
+
+    // Read a key file (64 hex chars), creating it with a random key if missing
+    static Key load_or_create_key(const std::string& key_path);
+
+    // All stored credentials; empty if the file does not exist. Throws
+    // std::runtime_error if the file is malformed, was modified, or was
+    // written under a different key.
+    std::map<std::string, ApiCreds> load() const;
+
+    // Replace the stored set
+    void save(const std::map<std::string, ApiCreds>& creds) const;
+
+    // load(), then add or replace the given entries and save
+    void merge(const std::map<std::string, ApiCreds>& creds) const;
+
+    std::optional<ApiCreds> get(const std::string& address) const;
+
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+    Key key_;
+};
+
+} // namespace clob
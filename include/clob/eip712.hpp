@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <string_view>
 #include <nlohmann/json.hpp>
 
 namespace clob {
@@ -54,15 +55,22 @@ std::array<uint8_t, 32> signing_hash(
     const json& types
 );
 
-// Helper to convert hex string to bytes
+// Helper to convert hex string to bytes (wraps clob/hex.hpp; throws on invalid hex)
 std::vector<uint8_t> hex_to_bytes(const std::string& hex);
 
-// Helper to convert bytes to hex string
+// Helper to convert bytes to hex string (wraps clob/hex.hpp)
 std::string bytes_to_hex(const std::vector<uint8_t>& bytes, bool with_prefix = true);
 
 // Helper for uint256 encoding
 std::array<uint8_t, 32> encode_uint256(uint64_t value);
-std::array<uint8_t, 32> encode_uint256(const std::string& value);
+std::array<uint8_t, 32> encode_uint256(const std::string& value);  // decimal; throws if invalid
+
+// Parse a decimal string into a big-endian uint256 without exceptions
+// Returns false on empty input, non-digits or overflow
+bool parse_uint256(std::string_view decimal, std::array<uint8_t, 32>& out);
+
+// encode_uint256 for token ids, cached per thread (token ids repeat on every order hash)
+std::array<uint8_t, 32> encode_token_id(const std::string& token_id);
 
 // Helper for address encoding
 std::array<uint8_t, 32> encode_address(const std::string& address);
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "eip712.hpp"
+#include "hex.hpp"
+#include "keccak.hpp"
+#include "types.hpp"
+
+namespace clob {
+namespace eip712 {
+
+// Static EIP-712 encoding for structs we sign on every request
+//
+// A struct declares its fields once by specialising Descriptor<T>:
+//
+//     template <> struct Descriptor<ClobAuth> {
+//         static constexpr std::string_view name = "ClobAuth";
+//         static constexpr auto fields = std::make_tuple(
+//             field<sol::address>("address", &ClobAuth::address), ...);
+//     };
+//
+// type_string<T>() and type_hash<T>() are then compile-time constants and
+// hash_struct(value) encodes each member straight into a fixed-size buffer,
+// without building json or comparing type names. Only atomic field types are
+// supported; structs with nested struct members or arrays go through the
+// dynamic json encoder in eip712.hpp.
+
+// Solidity field types: name used in the type string, and a 32-byte encoder
+namespace sol {
+
+struct address {
+    static constexpr std::string_view name = "address";
+
+    static void encode(const std::string& value, uint8_t* out) {
+        auto digits = hex::strip_prefix(value);
+        if (digits.size() != 40) {
+            throw std::runtime_error("Invalid address length");
+        }
+        std::memset(out, 0, 12);
+        if (!hex::decode_to(digits, out + 12)) {
+            throw std::runtime_error("Invalid address: " + value);
+        }
+    }
+};
+
+namespace detail {
+
+inline void encode_integer(uint64_t value, uint8_t* out) {
+    std::memset(out, 0, 24);
+    for (int i = 0; i < 8; ++i) {
+        out[31 - i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+}
+
+} // namespace detail
+
+struct uint256 {
+    static constexpr std::string_view name = "uint256";
+
+    static void encode(const std::string& value, uint8_t* out) {
+        // Values beyond 19 digits are token ids; reuse their cached encoding
+        std::array<uint8_t, 32> encoded;
+        if (value.size() > 19) {
+            encoded = encode_token_id(value);
+        } else if (!parse_uint256(value, encoded)) {
+            throw std::runtime_error("Invalid uint256: " + value);
+        }
+        std::memcpy(out, encoded.data(), 32);
+    }
+
+    static void encode(uint64_t value, uint8_t* out) {
+        detail::encode_integer(value, out);
+    }
+};
+
+struct uint8 {
+    static constexpr std::string_view name = "uint8";
+
+    static void encode(uint8_t value, uint8_t* out) {
+        detail::encode_integer(value, out);
+    }
+};
+
+struct string {
+    static constexpr std::string_view name = "string";
+
+    static void encode(const std::string& value, uint8_t* out) {
+        auto hash = keccak::hash256(value);
+        std::memcpy(out, hash.data(), 32);
+    }
+};
+
+} // namespace sol
+
+// One EIP-712 field: its Solidity type, its name in the type string, and the
+// C++ member holding its value
+template <typename Sol, typename Owner, typename Member>
+struct Field {
+    using sol_type = Sol;
+    std::string_view name;
+    Member Owner::*member;
+};
+
+template <typename Sol, typename Owner, typename Member>
+constexpr Field<Sol, Owner, Member> field(std::string_view name, Member Owner::*member) {
+    return {name, member};
+}
+
+// Specialise for each statically encoded struct (see top of file)
+template <typename T>
+struct Descriptor;
+
+namespace detail {
+
+template <typename T>
+constexpr size_t field_count() {
+    return std::tuple_size_v<std::decay_t<decltype(Descriptor<T>::fields)>>;
+}
+
+template <typename T, size_t I>
+constexpr std::string_view field_type_name() {
+    using F = std::decay_t<decltype(std::get<I>(Descriptor<T>::fields))>;
+    return F::sol_type::name;
+}
+
+// "Name(type1 name1,type2 name2)"
+template <typename T, size_t... I>
+constexpr size_t type_string_size(std::index_sequence<I...>) {
+    return Descriptor<T>::name.size() + 2 + (sizeof...(I) > 0 ? sizeof...(I) - 1 : 0) +
+           (size_t{0} + ... + (field_type_name<T, I>().size() + 1 +
+                               std::get<I>(Descriptor<T>::fields).name.size()));
+}
+
+template <size_t N>
+constexpr void append(std::array<char, N>& out, size_t& pos, std::string_view s) {
+    for (char c : s) out[pos++] = c;
+}
+
+template <typename T, size_t N, size_t... I>
+constexpr std::array<char, N> build_type_string(std::index_sequence<I...>) {
+    std::array<char, N> out{};
+    size_t pos = 0;
+    append(out, pos, Descriptor<T>::name);
+    append(out, pos, "(");
+    ((append(out, pos, I == 0 ? "" : ","),
+      append(out, pos, field_type_name<T, I>()),
+      append(out, pos, " "),
+      append(out, pos, std::get<I>(Descriptor<T>::fields).name)), ...);
+    append(out, pos, ")");
+    return out;
+}
+
+template <typename T>
+struct StaticType {
+    using Indices = std::make_index_sequence<field_count<T>()>;
+    static constexpr size_t SIZE = type_string_size<T>(Indices{});
+    static constexpr std::array<char, SIZE> STRING = build_type_string<T, SIZE>(Indices{});
+    static constexpr std::array<uint8_t, 32> HASH =
+        keccak::hash256_constexpr(std::string_view(STRING.data(), SIZE));
+};
+
+template <typename T, size_t... I>
+constexpr size_t field_offset(std::string_view name, std::index_sequence<I...>) {
+    size_t offset = 0;
+    ((offset = (offset == 0 && std::get<I>(Descriptor<T>::fields).name == name) ? 32 * (I + 1) : offset), ...);
+    return offset != 0 ? offset : throw std::invalid_argument("Unknown EIP-712 field");
+}
+
+template <typename T, size_t... I>
+void encode_fields(const T& value, uint8_t* out, std::index_sequence<I...>) {
+    (std::decay_t<decltype(std::get<I>(Descriptor<T>::fields))>::sol_type::encode(
+         value.*(std::get<I>(Descriptor<T>::fields).member), out + 32 * I), ...);
+}
+
+} // namespace detail
+
+template <typename T>
+constexpr std::string_view type_string() {
+    return std::string_view(detail::StaticType<T>::STRING.data(), detail::StaticType<T>::SIZE);
+}
+
+template <typename T>
+constexpr const std::array<uint8_t, 32>& type_hash() {
+    return detail::StaticType<T>::HASH;
+}
+
+// Same bytes as encode_struct(Descriptor<T>::name, ...) on the json form
+template <typename T>
+std::array<uint8_t, 32 * (detail::field_count<T>() + 1)> encode_struct(const T& value) {
+    constexpr size_t N = detail::field_count<T>();
+    std::array<uint8_t, 32 * (N + 1)> out;
+    std::memcpy(out.data(), type_hash<T>().data(), 32);
+    detail::encode_fields(value, out.data() + 32, std::make_index_sequence<N>{});
+    return out;
+}
+
+// Byte offset of a named field within encode_struct(value), for callers that
+// keep an encoded struct and patch only the fields that change
+template <typename T>
+constexpr size_t field_offset(std::string_view name) {
+    return detail::field_offset<T>(name, std::make_index_sequence<detail::field_count<T>()>{});
+}
+
+template <typename T>
+std::array<uint8_t, 32> hash_struct(const T& value) {
+    auto encoded = encode_struct(value);
+    return keccak::hash256(encoded.data(), encoded.size());
+}
+
+// keccak256("\x19\x01" || domain_separator || struct_hash)
+inline std::array<uint8_t, 32> signing_digest(
+    const std::array<uint8_t, 32>& domain_separator,
+    const std::array<uint8_t, 32>& struct_hash
+) {
+    uint8_t data[66] = {0x19, 0x01};
+    std::memcpy(data + 2, domain_separator.data(), 32);
+    std::memcpy(data + 34, struct_hash.data(), 32);
+    return keccak::hash256(data, sizeof(data));
+}
+
+template <typename T>
+std::array<uint8_t, 32> signing_hash(const std::array<uint8_t, 32>& domain_separator, const T& message) {
+    return signing_digest(domain_separator, hash_struct(message));
+}
+
+// ==================== Descriptors ====================
+
+template <>
+struct Descriptor<ClobAuth> {
+    static constexpr std::string_view name = "ClobAuth";
+    static constexpr auto fields = std::make_tuple(
+        field<sol::address>("address", &ClobAuth::address),
+        field<sol::string>("timestamp", &ClobAuth::timestamp),
+        field<sol::uint256>("nonce", &ClobAuth::nonce),
+        field<sol::string>("message", &ClobAuth::message)
+    );
+};
+
+template <>
+struct Descriptor<Order> {
+    static constexpr std::string_view name = "Order";
+    static constexpr auto fields = std::make_tuple(
+        field<sol::uint256>("salt", &Order::salt),
+        field<sol::address>("maker", &Order::maker),
+        field<sol::address>("signer", &Order::signer),
+        field<sol::address>("taker", &Order::taker),
+        field<sol::uint256>("tokenId", &Order::token_id),
+        field<sol::uint256>("makerAmount", &Order::maker_amount),
+        field<sol::uint256>("takerAmount", &Order::taker_amount),
+        field<sol::uint256>("expiration", &Order::expiration),
+        field<sol::uint256>("nonce", &Order::nonce),
+        field<sol::uint256>("feeRateBps", &Order::fee_rate_bps),
+        field<sol::uint8>("side", &Order::side),
+        field<sol::uint8>("signatureType", &Order::signature_type)
+    );
+};
+
+} // namespace eip712
+} // namespace clob
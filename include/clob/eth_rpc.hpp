@@ -3,12 +3,27 @@
 #include <string>
 #include <optional>
 #include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <functional>
+#include <future>
+#include <thread>
+#include <condition_variable>
+#include <unordered_map>
+#include <chrono>
+#include <array>
+#include <string_view>
 #include <nlohmann/json.hpp>
+#include "http_client.hpp"
 
 namespace clob {
 
 using json = nlohmann::json;
 
+class Signer;
+
 // Contract addresses for Polymarket on Polygon
 namespace polygon_contracts {
     // USDC on Polygon
@@ -22,12 +37,82 @@ namespace polygon_contracts {
     
     // Conditional Tokens Framework
     constexpr const char* CTF = "0x4D97DCd97eC945f40cF65F87097ACe5EA0476045";
+    
+    // Multicall3 (same address on every chain)
+    constexpr const char* MULTICALL3 = "0xcA11bde05977b3631167028862bE2a173976CA11";
+}
+
+// A single JSON-RPC call, for batching
+struct RpcRequest {
+    std::string method;
+    json params;
+};
+
+// Result of one call within a JSON-RPC batch
+struct RpcResponse {
+    json result;
+    std::optional<std::string> error;
+    
+    bool ok() const { return !error.has_value(); }
+};
+
+// ABI encoding helpers
+namespace abi {
+    // Encode ERC20 approve(address spender, uint256 amount)
+    std::string encode_approve(const std::string& spender, const std::string& amount_hex);
+    
+    // Encode ERC1155 setApprovalForAll(address operator, bool approved)
+    std::string encode_set_approval_for_all(const std::string& operator_addr, bool approved);
+    
+    // Encode ERC20 allowance(address owner, address spender) call
+    std::string encode_allowance(const std::string& owner, const std::string& spender);
+    
+    // Encode ERC1155 isApprovedForAll(address account, address operator) call
+    std::string encode_is_approved_for_all(const std::string& account, const std::string& operator_addr);
+    
+    // A read-only contract call to aggregate through Multicall3
+    struct Call {
+        std::string target;        // contract address
+        std::string call_data;     // hex encoded calldata
+        bool allow_failure = true;
+    };
+    
+    // Per-call result decoded from an aggregate3 response
+    struct CallResult {
+        bool success = false;
+        std::string return_data;   // hex encoded return data
+    };
+    
+    // Encode Multicall3 aggregate3((address,bool,bytes)[] calls)
+    std::string encode_aggregate3(const std::vector<Call>& calls);
+    
+    // Decode the (bool,bytes)[] returned by aggregate3
+    std::vector<CallResult> decode_aggregate3(const std::string& result_hex);
+    
+    // True if a 32-byte return word is non-zero (bool / uint256 results)
+    bool is_nonzero_word(const std::string& return_data);
+    
+    // Encode ERC20 balanceOf(address account) call
+    std::string encode_balance_of(const std::string& account);
+    
+    // Encode ERC1155 balanceOf(address account, uint256 id) call (id in decimal)
+    std::string encode_erc1155_balance_of(const std::string& account, const std::string& token_id);
+    
+    // Decode a uint256 return word that must fit in 64 bits
+    uint64_t decode_uint64(const std::string& return_data);
 }
 
 // Ethereum JSON-RPC client for on-chain transactions
+// Keeps one persistent keep-alive connection per RPC URL (http or https,
+// any port, any path) and reuses it for every call.
 class EthRpcClient {
 public:
     explicit EthRpcClient(const std::string& rpc_url = "https://polygon-rpc.com");
+    ~EthRpcClient();
+    
+    // Disable copy (unique persistent connection)
+    EthRpcClient(const EthRpcClient&) = delete;
+    EthRpcClient& operator=(const EthRpcClient&) = delete;
     
     // Get the current nonce for an address
     uint64_t get_nonce(const std::string& address);
@@ -38,10 +123,27 @@ public:
     // Get chain ID
     uint64_t get_chain_id();
     
+    // eth_estimateGas for a contract call from `from`
+    uint64_t estimate_gas(
+        const std::string& from,
+        const std::string& to,
+        const std::string& data,
+        const std::string& value = "0x0"
+    );
+    
+    // eth_feeHistory over the last block_count blocks
+    // Returns the raw result (baseFeePerGas, gasUsedRatio, reward)
+    json get_fee_history(
+        uint64_t block_count,
+        const std::vector<double>& reward_percentiles,
+        const std::string& newest_block = "latest"
+    );
+    
     // Send a raw signed transaction
     std::string send_raw_transaction(const std::string& signed_tx_hex);
     
-    // Wait for transaction receipt
+    // Wait for transaction receipt (polls with backoff on the persistent connection)
+    // For many transactions at once, use ReceiptTracker instead
     json wait_for_receipt(const std::string& tx_hash, int timeout_seconds = 60);
     
     // Check ERC20 allowance
@@ -49,10 +151,37 @@ public:
     
     // Check ERC1155 isApprovedForAll
     bool is_approved_for_all(const std::string& token, const std::string& owner, const std::string& operator_addr);
+    
+    // ========== Batching ==========
+    
+    // Send several JSON-RPC calls in one HTTP round trip
+    // Results are returned in request order; per-call errors do not throw
+    std::vector<RpcResponse> batch_call(const std::vector<RpcRequest>& requests);
+    
+    // Aggregate read-only contract calls into a single eth_call via Multicall3
+    std::vector<abi::CallResult> multicall(
+        const std::vector<abi::Call>& calls,
+        const std::string& block = "latest"
+    );
+    
+    // ========== Low-Latency Optimizations ==========
+    
+    // Pre-warm TCP/TLS connection to the RPC node (issues eth_chainId)
+    bool warm_connection();
+    
+    // Get connection statistics (same surface as HttpClient)
+    ConnectionStats get_stats() const;
+    
+    // ========== Getters ==========
+    
+    std::string get_rpc_url() const { return rpc_url_; }
 
 private:
     std::string rpc_url_;
-    int request_id_ = 1;
+    std::string rpc_path_;              // Path component of rpc_url (e.g. "/v2/<key>")
+    std::unique_ptr<HttpClient> http_;  // Persistent connection, reused for all calls
+    std::atomic<int> request_id_{1};
+    std::atomic<bool> connection_warm_{false};
     
     json rpc_call(const std::string& method, const json& params);
 };
@@ -62,6 +191,35 @@ namespace rlp {
     std::vector<uint8_t> encode_string(const std::vector<uint8_t>& data);
     std::vector<uint8_t> encode_list(const std::vector<std::vector<uint8_t>>& items);
     std::vector<uint8_t> encode_integer(uint64_t value);
+    
+    // Encoded sizes, so a whole structure can be sized before encoding
+    size_t string_size(const uint8_t* data, size_t len);
+    size_t integer_size(uint64_t value);
+    size_t list_header_size(size_t payload_len);
+    
+    // Size of a hex field encoded as an RLP string
+    // numeric = true drops leading zero bytes (RLP integers must be minimal)
+    size_t hex_size(std::string_view hex, bool numeric);
+    
+    // Streaming encoder writing into one caller-provided buffer
+    // Sizes are computed up front with the *_size helpers; no allocations
+    class Writer {
+    public:
+        explicit Writer(uint8_t* out) : out_(out) {}
+        
+        void list_header(size_t payload_len);
+        void string(const uint8_t* data, size_t len);
+        void integer(uint64_t value);
+        void hex(std::string_view hex, bool numeric);  // decodes straight into the buffer
+        
+        size_t size() const { return pos_; }
+        
+    private:
+        uint8_t* out_;
+        size_t pos_ = 0;
+        
+        void length_prefix(uint8_t short_base, uint8_t long_base, size_t len);
+    };
 }
 
 // Transaction builder and signer
@@ -76,27 +234,334 @@ struct Transaction {
     
     // Sign the transaction and return hex-encoded signed tx
     std::string sign(const std::string& private_key) const;
+    
+    // Sign with an existing Signer (no per-call key parsing or context creation)
+    std::string sign(const Signer& signer) const;
+    
+    // EIP-155 signing hash: keccak256(rlp([nonce, gasPrice, gasLimit, to, value, data, chainId, 0, 0]))
+    std::array<uint8_t, 32> signing_hash() const;
 };
 
-// ABI encoding helpers
-namespace abi {
-    // Encode ERC20 approve(address spender, uint256 amount)
-    std::string encode_approve(const std::string& spender, const std::string& amount_hex);
+// EIP-1559 (type 0x02) transaction
+// Fees are in wei; no access list is attached
+struct Eip1559Transaction {
+    uint64_t chain_id;
+    uint64_t nonce;
+    uint64_t max_priority_fee_per_gas;
+    uint64_t max_fee_per_gas;
+    uint64_t gas_limit;
+    std::string to;             // address
+    std::string value;          // hex (usually "0x0")
+    std::string data;           // hex encoded calldata
     
-    // Encode ERC1155 setApprovalForAll(address operator, bool approved)
-    std::string encode_set_approval_for_all(const std::string& operator_addr, bool approved);
+    // Sign and return the hex-encoded typed transaction (0x02 || rlp([...]))
+    std::string sign(const std::string& private_key) const;
+    std::string sign(const Signer& signer) const;
     
-    // Encode ERC20 allowance(address owner, address spender) call
-    std::string encode_allowance(const std::string& owner, const std::string& spender);
+    // keccak256(0x02 || rlp([chainId, nonce, maxPriorityFee, maxFee, gasLimit, to, value, data, []]))
+    std::array<uint8_t, 32> signing_hash() const;
+};
+
+// Cached EIP-1559 fee estimates
+// Fetches eth_feeHistory at most once per TTL, so a burst of transactions
+// shares one fee round trip. The base fee is the pending block's base fee
+// from feeHistory; the priority fee is the median of per-block rewards at
+// the configured percentile, floored at min_priority_fee. Thread-safe.
+class FeeOracle {
+public:
+    struct Options {
+        std::chrono::milliseconds ttl{2000};        // About one Polygon block
+        uint64_t block_count = 5;
+        double reward_percentile = 50.0;
+        uint64_t min_priority_fee = 30000000000;    // 30 gwei (Polygon enforces a 25 gwei floor)
+        uint64_t base_fee_multiplier = 2;           // Headroom for base fee increases
+    };
     
-    // Encode ERC1155 isApprovedForAll(address account, address operator) call
-    std::string encode_is_approved_for_all(const std::string& account, const std::string& operator_addr);
-}
+    struct Fees {
+        uint64_t base_fee = 0;
+        uint64_t max_priority_fee_per_gas = 0;
+        uint64_t max_fee_per_gas = 0;
+    };
+    
+    explicit FeeOracle(EthRpcClient& rpc);
+    FeeOracle(EthRpcClient& rpc, Options options);
+    
+    // Cached fees, refreshed if older than the TTL
+    Fees get();
+    
+    // Fetch fresh fees regardless of the cache
+    Fees refresh();
+    
+    // Drop the cached value (e.g. after an underpriced error)
+    void invalidate();
+
+private:
+    EthRpcClient& rpc_;
+    Options options_;
+    
+    std::mutex mutex_;
+    std::optional<Fees> cached_;
+    std::chrono::steady_clock::time_point fetched_at_;
+    
+    Fees fetch();
+};
+
+// Gas limit cache for repeated contract calls
+// Entries are keyed by (to, selector, calldata length): calls to the same
+// function with the same argument layout use nearly the same gas, so one
+// eth_estimateGas serves every repeat. Stored limits include the headroom.
+// Entries are dropped on failure and optionally persisted to a JSON file,
+// so repeat operations need no pre-flight RPC even after a restart. Thread-safe.
+class GasCache {
+public:
+    struct Options {
+        double headroom = 1.25;     // Multiplier applied to eth_estimateGas
+        std::string path;           // Persist to this file when non-empty (best-effort)
+    };
+    
+    explicit GasCache(EthRpcClient& rpc);
+    GasCache(EthRpcClient& rpc, Options options);
+    
+    // Cached gas limit, estimating (and caching) on a miss
+    uint64_t gas_limit(const std::string& from, const std::string& to, const std::string& data);
+    
+    // Cached gas limit without any RPC
+    std::optional<uint64_t> lookup(const std::string& to, const std::string& data) const;
+    
+    // Store a raw estimate (headroom is applied); returns the stored limit
+    uint64_t record(const std::string& to, const std::string& data, uint64_t estimate);
+    
+    // Drop the entry after a failed or out-of-gas transaction
+    void invalidate(const std::string& to, const std::string& data);
+    
+    size_t size() const;
+    
+    // "<to>:<selector>:<calldata bytes>", lowercase
+    static std::string key(const std::string& to, const std::string& data);
+
+private:
+    EthRpcClient& rpc_;
+    Options options_;
+    
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, uint64_t> limits_;
+    
+    void load();
+    void save_locked() const;
+};
+
+// Local nonce allocator for pipelined transactions
+// Fetches the "pending" nonce once, then hands out increasing nonces locally
+// and tracks in-flight transactions, so several transactions from the same
+// address can be signed and broadcast back-to-back. Thread-safe.
+class NonceManager {
+public:
+    NonceManager(EthRpcClient& rpc, const std::string& address);
+    
+    // Reserve the next nonce (syncs with the node on first use / after errors)
+    uint64_t next();
+    
+    // Re-fetch the pending nonce from the node on the next call to next()
+    void resync();
+    
+    // Seed the next nonce without a round trip (e.g. from a batched fetch)
+    void reset(uint64_t next_nonce);
+    
+    // Sign a transaction for the reserved nonce and broadcast it
+    // On "nonce too low" the manager resyncs and re-signs (up to max_attempts)
+    // Returns the transaction hash; the transaction is tracked as in flight
+    std::string send(
+        const std::function<std::string(uint64_t nonce)>& sign_fn,
+        int max_attempts = 3
+    );
+    
+    // Record an externally broadcast transaction as in flight
+    void mark_sent(uint64_t nonce, const std::string& tx_hash);
+    
+    // Stop tracking a transaction once its receipt has been seen
+    void mark_confirmed(const std::string& tx_hash);
+    
+    // Number of broadcast transactions without a receipt yet
+    size_t in_flight() const;
+    
+    // In-flight transactions ordered by nonce
+    std::map<uint64_t, std::string> pending() const;
+    
+    const std::string& address() const { return address_; }
+    
+    // True if an RPC error indicates the nonce was already used
+    static bool is_nonce_too_low(const std::string& error_message);
+
+private:
+    EthRpcClient& rpc_;
+    std::string address_;
+    
+    mutable std::mutex mutex_;
+    bool synced_ = false;
+    uint64_t next_nonce_ = 0;
+    std::map<uint64_t, std::string> in_flight_;
+};
+
+// Background receipt tracker
+// A single thread watches every pending transaction hash, fetching all
+// receipts plus the latest block number in one JSON-RPC batch per poll.
+// Polling adapts to the observed block time: right after a new block it sleeps
+// for most of a block interval, otherwise it polls a few times per block.
+class ReceiptTracker {
+public:
+    using Callback = std::function<void(const std::string& tx_hash, const json& receipt, std::exception_ptr error)>;
+    
+    struct Options {
+        std::chrono::milliseconds initial_block_time{2000};  // Polygon ~2s
+        std::chrono::milliseconds min_poll_interval{100};
+        std::chrono::milliseconds max_poll_interval{5000};
+        size_t max_batch_size = 100;  // receipts per round trip; every pending hash is polled each cycle
+    };
+    
+    explicit ReceiptTracker(EthRpcClient& rpc);
+    ReceiptTracker(EthRpcClient& rpc, Options options);
+    ~ReceiptTracker();
+    
+    ReceiptTracker(const ReceiptTracker&) = delete;
+    ReceiptTracker& operator=(const ReceiptTracker&) = delete;
+    
+    // Resolve a future with the receipt once the transaction is mined
+    std::future<json> track(
+        const std::string& tx_hash,
+        std::chrono::seconds timeout = std::chrono::seconds(60)
+    );
+    
+    // Invoke a callback (on the tracker thread) once mined or timed out
+    void track(
+        const std::string& tx_hash,
+        Callback callback,
+        std::chrono::seconds timeout = std::chrono::seconds(60)
+    );
+    
+    // Number of transactions still waiting for a receipt
+    size_t pending() const;
+    
+    // Current block time estimate used to schedule polls
+    std::chrono::milliseconds estimated_block_time() const;
+    
+    // Stop the tracker thread; pending waiters fail with an exception
+    void stop();
+
+private:
+    struct Waiter {
+        std::chrono::steady_clock::time_point deadline;
+        std::shared_ptr<std::promise<json>> promise;
+        Callback callback;
+    };
+    
+    EthRpcClient& rpc_;
+    Options options_;
+    
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unordered_map<std::string, std::vector<Waiter>> waiters_;
+    bool running_ = false;
+    bool stopping_ = false;
+    std::thread thread_;
+    
+    // Block time estimation
+    uint64_t last_block_ = 0;
+    std::chrono::steady_clock::time_point last_block_seen_;
+    double block_time_ms_;
+    
+    void add_waiter(const std::string& tx_hash, Waiter waiter);
+    void run();
+    std::chrono::milliseconds poll_once();
+    static void resolve(const std::string& tx_hash, Waiter& waiter, const json& receipt, std::exception_ptr error);
+};
+
+// On-chain balance poller
+// Periodically reads USDC balances and CTF (ERC1155) position balances for a
+// set of wallets through batched Multicall3 eth_calls, keeps them in a local
+// table and reports only the balances that changed. Strategies can read
+// inventory from the table without any API call on the hot path.
+// Balances are raw token units (6 decimals for both USDC and CTF positions).
+class BalancePoller {
+public:
+    struct BalanceChange {
+        std::string wallet;         // lowercase address
+        std::string token_id;       // empty for USDC
+        uint64_t previous = 0;      // 0 on first observation
+        uint64_t current = 0;
+    };
+    using Callback = std::function<void(const BalanceChange& change)>;
+    
+    struct Options {
+        std::chrono::milliseconds interval{2000};   // About one Polygon block
+        size_t max_calls_per_multicall = 500;
+    };
+    
+    explicit BalancePoller(EthRpcClient& rpc);
+    BalancePoller(EthRpcClient& rpc, Options options);
+    ~BalancePoller();
+    
+    BalancePoller(const BalancePoller&) = delete;
+    BalancePoller& operator=(const BalancePoller&) = delete;
+    
+    // Track a wallet's USDC balance
+    void add_wallet(const std::string& wallet);
+    
+    // Track a wallet's balance of a CTF position token (decimal token id)
+    void add_position(const std::string& wallet, const std::string& token_id);
+    
+    // Register a callback for balance changes (invoked on the polling thread)
+    void on_change(Callback callback);
+    
+    // Read every tracked balance once, update the table and notify changes
+    // Returns the changes; failed individual calls keep their previous value
+    std::vector<BalanceChange> poll_once();
+    
+    // Poll in the background every interval
+    void start();
+    void stop();
+    
+    // Cached balances (nullopt until first read)
+    std::optional<uint64_t> usdc_balance(const std::string& wallet) const;
+    std::optional<uint64_t> position_balance(const std::string& wallet, const std::string& token_id) const;
+    
+    // Number of background polls that failed
+    size_t error_count() const { return errors_.load(); }
+
+private:
+    struct Entry {
+        std::string wallet;
+        std::string token_id;
+        std::string key;
+    };
+    
+    EthRpcClient& rpc_;
+    Options options_;
+    
+    mutable std::mutex mutex_;
+    std::vector<Entry> entries_;
+    std::unordered_map<std::string, uint64_t> balances_;
+    std::vector<Callback> callbacks_;
+    
+    std::condition_variable cv_;
+    bool running_ = false;
+    std::thread thread_;
+    std::atomic<size_t> errors_{0};
+    
+    static std::string make_key(const std::string& wallet, const std::string& token_id);
+    void add_entry(const std::string& wallet, const std::string& token_id);
+    std::optional<uint64_t> lookup(const std::string& key) const;
+    void run();
+};
 
 // High-level approval helper
 class ApprovalHelper {
 public:
-    ApprovalHelper(const std::string& private_key, const std::string& rpc_url = "https://polygon-rpc.com");
+    // gas_cache_path: where gas estimates are persisted (empty = in memory only)
+    ApprovalHelper(
+        const std::string& private_key,
+        const std::string& rpc_url = "https://polygon-rpc.com",
+        const std::string& gas_cache_path = ""
+    );
     
     // Check and set up all required approvals for Polymarket trading
     // Returns true if all approvals are already set, false if transactions were sent
@@ -108,6 +573,17 @@ public:
     std::string approve_ctf_for_exchange();
     std::string approve_ctf_for_neg_risk_exchange();
     
+    // All four approval flags, fetched in a single multicall
+    struct ApprovalStatus {
+        bool usdc_exchange = false;
+        bool usdc_neg_risk = false;
+        bool ctf_exchange = false;
+        bool ctf_neg_risk = false;
+        
+        bool all() const { return usdc_exchange && usdc_neg_risk && ctf_exchange && ctf_neg_risk; }
+    };
+    ApprovalStatus check_approvals();
+    
     // Check current approval status
     bool has_usdc_exchange_approval();
     bool has_usdc_neg_risk_approval();
@@ -115,9 +591,60 @@ public:
     bool has_ctf_neg_risk_approval();
 
 private:
-    std::string private_key_;
+    std::shared_ptr<Signer> signer_;  // Reused for every transaction
     std::string address_;
     EthRpcClient rpc_;
+    NonceManager nonces_;
+    ReceiptTracker receipts_;
+    FeeOracle fees_;
+    GasCache gas_;
+    
+    // Sign and broadcast a contract call without waiting for the receipt
+    std::string broadcast(const std::string& to, const std::string& data);
+    
+    // Wait for a broadcast transaction to be mined; throws if it reverted
+    void confirm(const std::string& tx_hash, const std::string& to, const std::string& data);
+    
+    // Throw (and drop the cached gas limit) if the receipt reports a revert
+    void check_receipt(const json& receipt, const std::string& to, const std::string& data);
+};
+
+// Approval provisioning for many wallets at once
+// Checks every wallet's approvals in one multicall, fetches all pending
+// nonces in one batch, signs the missing approvals locally with per-wallet
+// nonce tracking, broadcasts them in nonce order (one batch per round, the
+// r-th transaction of every wallet together) and waits on a single
+// ReceiptTracker. Results are reported per wallet; one wallet failing does
+// not stop the others, but stops that wallet's later nonces.
+class ApprovalProvisioner {
+public:
+    struct WalletResult {
+        std::string address;
+        ApprovalHelper::ApprovalStatus before;      // Status prior to provisioning
+        std::vector<std::string> tx_hashes;         // Transactions sent for this wallet
+        bool success = false;                       // All approvals in place afterwards
+        std::string error;                          // First failure, if any
+    };
+    
+    explicit ApprovalProvisioner(
+        const std::string& rpc_url = "https://polygon-rpc.com",
+        const std::string& gas_cache_path = ""
+    );
+    
+    // Approval status of every address, in one multicall
+    std::vector<ApprovalHelper::ApprovalStatus> check_approvals(const std::vector<std::string>& addresses);
+    
+    // Grant all missing approvals for every wallet and wait for the receipts
+    std::vector<WalletResult> provision(
+        const std::vector<std::string>& private_keys,
+        std::chrono::seconds timeout = std::chrono::seconds(120)
+    );
+
+private:
+    EthRpcClient rpc_;
+    ReceiptTracker receipts_;
+    FeeOracle fees_;
+    GasCache gas_;
 };
 
 } // namespace clob
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clob {
+namespace hex {
+
+// Table-driven hex codec shared by eip712, eth_rpc and signer
+// The *_to functions write into caller-provided buffers and never allocate;
+// the std::string / std::vector overloads allocate exactly once.
+// Encoding is lowercase. Decoding accepts either case and an optional 0x prefix.
+
+namespace detail {
+
+// Value of each ASCII hex digit, 0xff for anything else
+inline constexpr std::array<uint8_t, 256> make_decode_table() {
+    std::array<uint8_t, 256> table{};
+    for (auto& v : table) v = 0xff;
+    for (int c = '0'; c <= '9'; ++c) table[c] = static_cast<uint8_t>(c - '0');
+    for (int c = 'a'; c <= 'f'; ++c) table[c] = static_cast<uint8_t>(c - 'a' + 10);
+    for (int c = 'A'; c <= 'F'; ++c) table[c] = static_cast<uint8_t>(c - 'A' + 10);
+    return table;
+}
+
+inline constexpr std::array<uint8_t, 256> DECODE_TABLE = make_decode_table();
+
+// Two output characters per input byte
+inline constexpr std::array<char, 512> make_encode_table() {
+    constexpr char digits[] = "0123456789abcdef";
+    std::array<char, 512> table{};
+    for (int b = 0; b < 256; ++b) {
+        table[b * 2] = digits[b >> 4];
+        table[b * 2 + 1] = digits[b & 0x0f];
+    }
+    return table;
+}
+
+inline constexpr std::array<char, 512> ENCODE_TABLE = make_encode_table();
+
+} // namespace detail
+
+// Value of one hex digit, or -1 if c is not a hex digit
+inline int digit_value(char c) {
+    uint8_t v = detail::DECODE_TABLE[static_cast<uint8_t>(c)];
+    return v == 0xff ? -1 : v;
+}
+
+// Drop a leading "0x" / "0X"
+inline std::string_view strip_prefix(std::string_view hex) {
+    if (hex.size() >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+        hex.remove_prefix(2);
+    }
+    return hex;
+}
+
+// Number of characters encode_to writes for len bytes
+inline constexpr size_t encoded_size(size_t len, bool prefix = false) {
+    return len * 2 + (prefix ? 2 : 0);
+}
+
+// Write 2 * len lowercase hex characters to out (no prefix, no terminator)
+inline void encode_to(const uint8_t* data, size_t len, char* out) {
+    const char* table = detail::ENCODE_TABLE.data();
+    for (size_t i = 0; i < len; ++i) {
+        const char* pair = table + static_cast<size_t>(data[i]) * 2;
+        out[i * 2] = pair[0];
+        out[i * 2 + 1] = pair[1];
+    }
+}
+
+// Decode hex (optional 0x prefix, even length) into out, which must hold
+// strip_prefix(hex).size() / 2 bytes. Returns false on odd length or a non-hex
+// character; out may then be partially written.
+bool decode_to(std::string_view hex, uint8_t* out);
+
+// True if hex (optional 0x prefix) is an even-length run of hex digits
+bool is_valid(std::string_view hex);
+
+std::string encode(const uint8_t* data, size_t len, bool prefix = true);
+
+inline std::string encode(const std::vector<uint8_t>& bytes, bool prefix = true) {
+    return encode(bytes.data(), bytes.size(), prefix);
+}
+
+template <size_t N>
+std::string encode(const std::array<uint8_t, N>& bytes, bool prefix = true) {
+    return encode(bytes.data(), N, prefix);
+}
+
+// Decode hex (optional 0x prefix); throws std::runtime_error on invalid input
+std::vector<uint8_t> decode(std::string_view hex);
+
+// Decode exactly N bytes; throws if the length does not match
+template <size_t N>
+std::array<uint8_t, N> decode_array(std::string_view hex) {
+    std::string_view digits = strip_prefix(hex);
+    std::array<uint8_t, N> out{};
+    if (digits.size() != N * 2 || !decode_to(digits, out.data())) {
+        throw std::runtime_error("Invalid hex: expected " + std::to_string(N) + " bytes");
+    }
+    return out;
+}
+
+} // namespace hex
+} // namespace clob
@@ -8,6 +8,7 @@
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include <simdjson.h>
 
@@ -31,12 +32,24 @@ struct ConnectionStats {
     bool connection_warm = false;
 };
 
+// How an HttpClient reports its requests to the metrics registry
+// (clob/metrics.hpp). The path becomes the endpoint label, so clients whose
+// paths carry secrets (an RPC provider key in the URL) should redact it.
+enum class RequestMetrics {
+    Full,       // Normalized path as the endpoint label (default)
+    Redacted,   // Count and time requests under the endpoint label "redacted"
+    Off         // Record nothing per request
+};
+
 class HttpClient {
 public:
-    explicit HttpClient(const std::string& host);
+    // pool_size persistent connections to host; concurrent requests each take
+    // a free connection, so one HttpClient can be shared across threads and
+    // across ClobClients (see AccountManager)
+    explicit HttpClient(const std::string& host, size_t pool_size = 1);
     ~HttpClient();
     
-    // Disable copy (unique persistent connection)
+    // Disable copy (persistent connections)
     HttpClient(const HttpClient&) = delete;
     HttpClient& operator=(const HttpClient&) = delete;
     
@@ -46,7 +59,9 @@ public:
     
     // ========== HTTP Methods - SIMD JSON Interface ==========
     
-    // Returns simdjson::dom::element for fast parsing
+    // Returns simdjson::dom::element for fast parsing. The element points into
+    // a per-thread parser and stays valid until the next *_simd call on the
+    // same thread.
     simdjson::dom::element get_simd(
         const std::string& path,
         const std::optional<Headers>& headers = std::nullopt,
@@ -122,8 +137,8 @@ public:
     // Pre-warm TCP/TLS connection (call before trading)
     bool warm_connection();
     
-    // Start background heartbeat to keep connection alive
-    // Default: 25 seconds (servers typically timeout at 30-60s)
+    // Start background heartbeat to keep connections alive (pings each idle
+    // pooled connection). Default: 25 seconds (servers typically timeout at 30-60s)
     void start_heartbeat(int interval_seconds = 25);
     
     // Stop background heartbeat
@@ -135,18 +150,26 @@ public:
     // Get connection statistics
     ConnectionStats get_stats() const;
     
+    // Set before sharing the client across threads
+    void set_request_metrics(RequestMetrics mode) { request_metrics_ = mode; }
+    RequestMetrics get_request_metrics() const { return request_metrics_; }
+    
     // ========== Getters ==========
     
     std::string get_host() const { return host_; }
+    size_t pool_size() const { return pool_.size(); }
 
 private:
-    // Persistent HTTP clients (reused for all requests)
-    std::unique_ptr<httplib::SSLClient> ssl_client_;
-    std::unique_ptr<httplib::Client> client_;
+    // One persistent connection; exactly one of ssl / plain is set
+    struct Connection {
+        std::unique_ptr<httplib::SSLClient> ssl;
+        std::unique_ptr<httplib::Client> plain;
+        std::mutex mutex;
+    };
     
-    // SIMD JSON parser (reusable for performance)
-    simdjson::dom::parser parser_;
-    std::string parser_buffer_;  // Reusable buffer
+    // Persistent connections (reused for all requests)
+    std::vector<std::unique_ptr<Connection>> pool_;
+    std::atomic<size_t> next_connection_;
     
     // Connection info
     std::string host_;
@@ -155,7 +178,6 @@ private:
     int port_;
     
     // Thread safety
-    mutable std::mutex client_mutex_;
     mutable std::mutex stats_mutex_;
     
     // Background heartbeat
@@ -169,9 +191,18 @@ private:
     double last_latency_ms_;
     bool connection_warm_;
     
+    RequestMetrics request_metrics_ = RequestMetrics::Full;
+    
     // Helper methods
-    void init_client();
+    void init_client(Connection& conn);
+    
+    // Lock an idle connection, or wait for the next one in round-robin order
+    std::unique_lock<std::mutex> acquire(Connection*& conn);
+    
+    // Parse into this thread's reusable simdjson parser
+    static simdjson::dom::element parse_simd(const std::string& body);
     void parse_host();
+    void record_request(const char* method, const std::string& path, int status, uint64_t latency_ns) const;
     std::string build_query_string(const json& params) const;
     
     // Internal HTTP methods with timing
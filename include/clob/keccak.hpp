@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <cstring>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace clob {
@@ -36,12 +37,13 @@ inline constexpr int PILN[24] = {
     15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1
 };
 
-inline uint64_t rotl64(uint64_t x, int y) {
+constexpr uint64_t rotl64(uint64_t x, int y) {
     return (x << y) | (x >> (64 - y));
 }
 
-inline void keccakf(uint64_t st[25]) {
-    uint64_t t, bc[5];
+// constexpr so hash256_constexpr can fold type hashes at compile time
+constexpr void keccakf(uint64_t st[25]) {
+    uint64_t t = 0, bc[5] = {};
 
     for (int r = 0; r < 24; r++) {
         // Theta
@@ -131,6 +133,35 @@ inline std::array<uint8_t, 32> hash256(const std::string& data) {
     return hash256(reinterpret_cast<const uint8_t*>(data.data()), data.size());
 }
 
+// Keccak-256 evaluated at compile time, for constants such as EIP-712 type
+// hashes. Absorbs lane by lane instead of through a byte buffer; use hash256
+// for runtime data.
+constexpr std::array<uint8_t, 32> hash256_constexpr(std::string_view data) {
+    constexpr size_t RATE = 136;
+    
+    uint64_t st[25] = {};
+    size_t pt = 0;
+    
+    for (char c : data) {
+        st[pt / 8] ^= static_cast<uint64_t>(static_cast<uint8_t>(c)) << (8 * (pt % 8));
+        if (++pt == RATE) {
+            detail::keccakf(st);
+            pt = 0;
+        }
+    }
+    
+    st[pt / 8] ^= 0x01ULL << (8 * (pt % 8));
+    st[(RATE - 1) / 8] ^= 0x80ULL << (8 * ((RATE - 1) % 8));
+    detail::keccakf(st);
+    
+    std::array<uint8_t, 32> hash{};
+    for (size_t i = 0; i < 4; i++) {
+        for (int j = 0; j < 8; j++)
+            hash[i * 8 + j] = static_cast<uint8_t>(st[i] >> (8 * j));
+    }
+    return hash;
+}
+
 } // namespace keccak
 } // namespace clob
 
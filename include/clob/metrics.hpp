@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Forward declare httplib types to avoid including in header
+namespace httplib {
+    class Server;
+}
+
+namespace clob {
+namespace metrics {
+
+// Process-wide client metrics: HTTP requests by endpoint and status, metadata
+// cache hits, order signing time, order outcomes, transport errors, heartbeat
+// results and connection pool use. Every ClobClient and HttpClient records
+// into the same registry.
+//
+// Recording is lock-free: counters and histogram buckets are relaxed
+// atomics, and a new (method, endpoint, status) series is published into a
+// fixed open-addressing table with compare-and-swap. Read with snapshot() or
+// render with prometheus_text(); MetricsServer serves the latter on a port.
+
+// Latency histogram over fixed Prometheus-style buckets (seconds)
+class Histogram {
+public:
+    static constexpr std::array<double, 16> BOUNDS = {
+        0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025,
+        0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0
+    };
+
+    struct Snapshot {
+        std::array<uint64_t, BOUNDS.size() + 1> buckets{};  // per bucket, last is +Inf (not cumulative)
+        uint64_t count = 0;
+        double sum_seconds = 0.0;
+
+        double mean_seconds() const { return count ? sum_seconds / static_cast<double>(count) : 0.0; }
+    };
+
+    void observe_ns(uint64_t ns);
+    Snapshot snapshot() const;
+    void reset();
+
+private:
+    std::array<std::atomic<uint64_t>, BOUNDS.size() + 1> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_ns_{0};
+};
+
+enum class Cache { TICK_SIZE, NEG_RISK, FEE_RATE };
+
+struct RequestSnapshot {
+    std::string method;
+    std::string endpoint;  // path with id segments replaced by ":id"
+    int status = 0;        // 0: no response (transport error)
+    uint64_t count = 0;
+    Histogram::Snapshot latency;
+};
+
+struct CacheSnapshot {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    double hit_rate() const {
+        uint64_t total = hits + misses;
+        return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
+};
+
+struct Snapshot {
+    std::vector<RequestSnapshot> requests;  // sorted by endpoint, method, status
+    CacheSnapshot tick_size;
+    CacheSnapshot neg_risk;
+    CacheSnapshot fee_rate;
+    Histogram::Snapshot signing;            // EIP-712 hash + secp256k1 sign per order
+    uint64_t orders_posted = 0;             // orders sent in post_order / post_orders
+    uint64_t orders_filled = 0;             // accepted with status MATCHED
+    uint64_t orders_rejected = 0;           // success=false, or the request failed
+    uint64_t transport_errors = 0;          // requests without an HTTP response
+    uint64_t heartbeats_ok = 0;
+    uint64_t heartbeats_failed = 0;
+    int64_t pool_connections = 0;           // pooled connections across HttpClients
+    int64_t pool_in_use = 0;                // of which currently executing a request
+    uint64_t pool_waits = 0;                // requests that queued for a busy pool
+    Histogram::Snapshot pool_wait;          // time spent queued
+};
+
+// ========== Recording (called by the client) ==========
+
+void record_request(const char* method, const std::string& path, int status, uint64_t latency_ns);
+void record_cache(Cache cache, bool hit);
+void record_signing(uint64_t ns);
+void record_orders(uint64_t posted, uint64_t filled, uint64_t rejected);
+void record_heartbeat(bool ok);
+void record_pool_size(int64_t delta);
+void record_pool_in_use(int64_t delta);
+void record_pool_wait(uint64_t ns);
+
+// ========== Reading ==========
+
+Snapshot snapshot();
+
+// Prometheus text exposition format (version 0.0.4)
+std::string prometheus_text();
+
+// Zero every counter and histogram; pool gauges are kept
+void reset();
+
+// "/data/order/0xab12..." -> "/data/order/:id": segments that are hex (0x...),
+// long decimal ids, or 16+ characters mixing letters and digits (API keys,
+// UUIDs) are collapsed so each endpoint is one series and no secret becomes
+// a label
+std::string normalize_endpoint(const std::string& path);
+
+// Serves GET /metrics (prometheus_text) on a background thread
+class MetricsServer {
+public:
+    MetricsServer();
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    // Port 0 picks a free port. Returns the bound port; throws if binding fails.
+    int start(const std::string& host = "127.0.0.1", int port = 0);
+    void stop();
+
+    int port() const { return port_; }
+
+private:
+    std::unique_ptr<httplib::Server> server_;
+    std::thread thread_;
+    int port_ = 0;
+};
+
+} // namespace metrics
+} // namespace clob
@@ -1,11 +1,22 @@
 #pragma once
 
 #include <memory>
+#include <atomic>
+#include <future>
 #include "types.hpp"
 #include "signer.hpp"
 
 namespace clob {
 
+// Local self-check of order signatures: the signature must recover to the
+// order's signer field, the address the exchange validates, catching key
+// mix-ups before the exchange rejects them
+enum class SignatureVerification {
+    Off,        // No check (default)
+    Blocking,   // Verify before create_order returns; throws on mismatch
+    Parallel    // Verify on a shared worker pool; SignedOrder::verification holds the result
+};
+
 class OrderBuilder {
 public:
     OrderBuilder(
@@ -41,12 +52,54 @@ public:
     );
     
     SignatureType get_signature_type() const { return sig_type_; }
+    
+    // ========== Signature self-check ==========
+    
+    void set_signature_verification(SignatureVerification mode) { verification_ = mode; }
+    SignatureVerification get_signature_verification() const { return verification_; }
+    
+    // Cost of the recovery-based check, accumulated across all orders
+    struct VerificationStats {
+        uint64_t count = 0;
+        uint64_t failures = 0;
+        uint64_t total_ns = 0;
+        uint64_t max_ns = 0;
+        
+        double mean_us() const { return count ? static_cast<double>(total_ns) / count / 1000.0 : 0.0; }
+    };
+    VerificationStats get_verification_stats() const;
+    
+    // Re-run the configured check on an already-signed order, e.g. one loaded
+    // from storage (Blocking throws, Parallel replaces order.verification)
+    void verify_order(SignedOrder& signed_order, bool neg_risk = false);
 
 private:
     std::shared_ptr<Signer> signer_;
     SignatureType sig_type_;
     std::string funder_;
     
+    // Shared with in-flight parallel checks, which may outlive a call
+    struct VerificationCounters {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> failures{0};
+        std::atomic<uint64_t> total_ns{0};
+        std::atomic<uint64_t> max_ns{0};
+    };
+    SignatureVerification verification_ = SignatureVerification::Off;
+    std::shared_ptr<VerificationCounters> counters_ = std::make_shared<VerificationCounters>();
+    
+    // Sign the order struct and apply the configured verification mode
+    void sign_order(const json& domain, SignedOrder& signed_order);
+    void apply_verification(const std::array<uint8_t, 32>& hash, SignedOrder& signed_order);
+    json order_domain(bool neg_risk) const;
+    
+    static bool verify_signature(
+        const std::string& expected_signer,
+        const std::array<uint8_t, 32>& hash,
+        const std::string& signature,
+        VerificationCounters& counters
+    );
+    
     struct OrderAmounts {
         uint8_t side;
         std::string maker_amount;
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <secp256k1.h>
+
+namespace clob {
+
+// Process-wide secp256k1 contexts
+// Context creation (and, on older libsecp256k1 releases, building the signing
+// tables) is expensive, so it happens once per process instead of per Signer.
+// Every context is randomized for side-channel blinding.
+namespace secp256k1_ctx {
+
+// Shared sign+verify context, created and randomized on first use
+// libsecp256k1 functions taking a const context are safe to call from any
+// thread; do not randomize or otherwise mutate it.
+const secp256k1_context* shared();
+
+// This thread's clone of the shared context, randomized with its own seed
+// on first use in the thread and destroyed at thread exit. Used for signing,
+// and safe to re-randomize from the owning thread.
+secp256k1_context* local();
+
+// Re-randomize this thread's context (e.g. periodically in long-lived signers)
+void rerandomize_local();
+
+} // namespace secp256k1_ctx
+} // namespace clob
@@ -13,11 +13,14 @@ namespace clob {
 class Signer {
 public:
     // Constructor with hex private key (with or without 0x prefix)
+    // Uses the process-wide secp256k1 contexts (see secp256k1_context.hpp),
+    // so constructing a Signer never creates a context
     explicit Signer(const std::string& private_key_hex, uint64_t chain_id);
-    ~Signer();
     
-    // Get the public address derived from private key
-    std::string address() const;
+    // Public address derived from the private key, computed once at construction
+    const std::string& address() const { return address_; }                  // lowercase 0x-prefixed hex
+    const std::string& checksum_address() const { return checksum_address_; } // EIP-55 mixed case
+    const std::array<uint8_t, 20>& address_bytes() const { return address_bytes_; }
     
     // Get chain ID
     uint64_t get_chain_id() const { return chain_id_; }
@@ -33,6 +36,17 @@ public:
         uint8_t v;
     };
     SignatureComponents sign_hash(const std::vector<uint8_t>& hash) const;
+    SignatureComponents sign_hash(const std::array<uint8_t, 32>& hash) const;
+    
+    // Recover the signing address from a 65-byte r || s || v signature
+    // (v = 27/28 or 0/1). Throws on a malformed or unrecoverable signature.
+    static std::array<uint8_t, 20> recover_address(
+        const std::array<uint8_t, 32>& message_hash,
+        const std::string& signature_hex
+    );
+    
+    // True if the signature over message_hash recovers to this signer's address
+    bool verify(const std::array<uint8_t, 32>& message_hash, const std::string& signature_hex) const;
     
     // Sign EIP712 typed data
     std::string sign_typed_data(
@@ -44,12 +58,13 @@ public:
 
 private:
     std::array<uint8_t, 32> private_key_;
+    std::array<uint8_t, 20> address_bytes_;
     std::string address_;
+    std::string checksum_address_;
     uint64_t chain_id_;
-    secp256k1_context* ctx_;
     
     // Compute address from public key
-    static std::string compute_address(const std::vector<uint8_t>& public_key);
+    static std::array<uint8_t, 20> compute_address(const std::vector<uint8_t>& public_key);
 };
 
 } // namespace clob
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <unordered_map>
 #include <chrono>
+#include <future>
 #include <nlohmann/json.hpp>
 
 namespace clob {
@@ -147,6 +148,14 @@ struct ContractConfig {
     std::string conditional_tokens;
 };
 
+// EIP-712 message signed for L1 authentication (see eip712_struct.hpp)
+struct ClobAuth {
+    std::string address;
+    std::string timestamp;
+    uint64_t nonce = 0;
+    std::string message;
+};
+
 // ==================== Order Structures ====================
 
 struct Order {
@@ -191,6 +200,9 @@ struct SignedOrder {
     std::string signature;
     OrderType order_type;
     std::string owner;  // ApiKey (UUID as string)
+    
+    // Pending local signature check (valid only with SignatureVerification::Parallel)
+    std::shared_future<bool> verification;
 };
 
 inline void to_json(json& j, const SignedOrder& signed_order) {
@@ -687,6 +699,8 @@ struct PostOrderResponse {
     bool success;
     std::vector<std::string> transaction_hashes;
     std::vector<std::string> trade_ids;
+    // False when a Parallel local signature check failed after the order was sent
+    bool signature_verified = true;
 };
 
 inline void from_json(const json& j, PostOrderResponse& resp) {
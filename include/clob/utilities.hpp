@@ -115,6 +115,16 @@ std::string generate_orderbook_summary_hash(const OrderBookSummaryResponse& orde
 // Hex utilities
 std::string to_checksum_address(const std::string& address);
 
+// L2 auth: URL-safe base64 HMAC-SHA256 of timestamp + method + path + body,
+// keyed by the URL-safe base64 API secret (POLY_SIGNATURE header)
+std::string build_hmac_signature(
+    const std::string& secret,
+    int64_t timestamp,
+    const std::string& method,
+    const std::string& request_path,
+    const std::string& body = ""
+);
+
 } // namespace utils
 } // namespace clob
 
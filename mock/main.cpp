@@ -0,0 +1,133 @@
+// Standalone mock CLOB exchange for load and latency testing.
+//
+//   ./mock_exchange --port 8080 --latency-us 500 --jitter-us 200 --error-rate 0.01
+//
+// Point a client at http://127.0.0.1:8080. Stop with Ctrl-C; request and
+// order counters are printed on exit.
+
+#include "mock_exchange.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<bool> g_running{true};
+
+void on_signal(int) {
+    g_running = false;
+}
+
+void usage(const char* argv0) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "  --host <addr>          bind address (default 127.0.0.1)\n"
+        "  --port <n>             port, 0 for any free port (default 8080)\n"
+        "  --chain-id <n>         EIP-712 chain id (default 137)\n"
+        "  --threads <n>          server worker threads (default 8)\n"
+        "  --latency-us <n>       added latency per response\n"
+        "  --jitter-us <n>        extra uniform latency in [0, n]\n"
+        "  --error-rate <f>       fraction of requests failed with --error-status\n"
+        "  --error-status <n>     status for injected failures (default 500)\n"
+        "  --seed <n>             seed for jitter and error injection\n"
+        "  --book <token_id>      seed a book with 10 levels a side (repeatable)\n"
+        "  --no-verify-auth       accept any L1/L2 headers\n"
+        "  --no-verify-orders     skip EIP-712 order signature recovery\n",
+        argv0
+    );
+}
+
+// Ten levels either side of 0.50
+void seed_book(clob::mock::MockExchange& exchange, const std::string& token_id) {
+    std::vector<clob::OrderSummary> bids;
+    std::vector<clob::OrderSummary> asks;
+    for (int i = 1; i <= 10; ++i) {
+        char bid[8];
+        char ask[8];
+        std::snprintf(bid, sizeof(bid), "0.%02d", 50 - i);
+        std::snprintf(ask, sizeof(ask), "0.%02d", 50 + i);
+        std::string size = std::to_string(100 * i);
+        bids.push_back({bid, size});
+        asks.push_back({ask, size});
+    }
+    exchange.add_book(token_id, bids, asks);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    clob::mock::MockExchange::Options options;
+    std::string host = "127.0.0.1";
+    int port = 8080;
+    std::vector<std::string> books;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--host") host = value();
+        else if (arg == "--port") port = std::stoi(value());
+        else if (arg == "--chain-id") options.chain_id = std::stoull(value());
+        else if (arg == "--threads") options.threads = std::stoul(value());
+        else if (arg == "--latency-us") options.latency = std::chrono::microseconds(std::stoll(value()));
+        else if (arg == "--jitter-us") options.jitter = std::chrono::microseconds(std::stoll(value()));
+        else if (arg == "--error-rate") options.error_rate = std::stod(value());
+        else if (arg == "--error-status") options.error_status = std::stoi(value());
+        else if (arg == "--seed") options.seed = std::stoull(value());
+        else if (arg == "--book") books.push_back(value());
+        else if (arg == "--no-verify-auth") options.verify_auth = false;
+        else if (arg == "--no-verify-orders") options.verify_order_signatures = false;
+        else if (arg == "--help" || arg == "-h") {
+            usage(argv[0]);
+            return 0;
+        } else {
+            std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    clob::mock::MockExchange exchange(options);
+    for (const auto& token_id : books) {
+        seed_book(exchange, token_id);
+    }
+
+    try {
+        exchange.start(host, port);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    std::printf("Mock exchange listening on %s (chain %llu, %zu threads)\n",
+                exchange.url().c_str(), static_cast<unsigned long long>(options.chain_id), options.threads);
+    std::fflush(stdout);
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+    while (g_running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    exchange.stop();
+
+    auto stats = exchange.stats();
+    std::printf("requests=%llu orders_accepted=%llu orders_canceled=%llu auth_failures=%llu "
+                "signature_failures=%llu injected_errors=%llu\n",
+                static_cast<unsigned long long>(stats.requests),
+                static_cast<unsigned long long>(stats.orders_accepted),
+                static_cast<unsigned long long>(stats.orders_canceled),
+                static_cast<unsigned long long>(stats.auth_failures),
+                static_cast<unsigned long long>(stats.signature_failures),
+                static_cast<unsigned long long>(stats.injected_errors));
+    return 0;
+}
@@ -0,0 +1,851 @@
+#include "mock_exchange.hpp"
+#include <clob/constants.hpp>
+#include <clob/eip712.hpp>
+#include <clob/eip712_struct.hpp>
+#include <clob/hex.hpp>
+#include <clob/keccak.hpp>
+#include <clob/signer.hpp>
+#include <clob/utilities.hpp>
+#include <openssl/evp.h>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace clob {
+namespace mock {
+
+namespace {
+
+constexpr const char* AUTH_MESSAGE = "This message attests that I control the given wallet";
+constexpr size_t MAX_BATCH_ORDERS = 15;
+constexpr size_t ORDERS_PAGE_SIZE = 100;
+
+std::string lowercase(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+void send_json(httplib::Response& res, const json& body, int status = 200) {
+    res.status = status;
+    res.set_content(body.dump(), "application/json");
+}
+
+void send_error(httplib::Response& res, int status, const std::string& message) {
+    send_json(res, {{"error", message}}, status);
+}
+
+std::string base64(const std::string& data) {
+    std::string out(4 * ((data.size() + 2) / 3), '\0');
+    int len = EVP_EncodeBlock(reinterpret_cast<unsigned char*>(out.data()),
+                              reinterpret_cast<const unsigned char*>(data.data()),
+                              static_cast<int>(data.size()));
+    out.resize(static_cast<size_t>(len));
+    return out;
+}
+
+// Pagination cursors are base64 offsets, as on the venue ("MA==" is 0)
+std::string encode_cursor(size_t offset) {
+    return base64(std::to_string(offset));
+}
+
+size_t decode_cursor(const std::string& cursor) {
+    if (cursor.empty()) {
+        return 0;
+    }
+    std::string decoded(3 * cursor.size() / 4, '\0');
+    int len = EVP_DecodeBlock(reinterpret_cast<unsigned char*>(decoded.data()),
+                              reinterpret_cast<const unsigned char*>(cursor.data()),
+                              static_cast<int>(cursor.size()));
+    if (len < 0) {
+        throw std::runtime_error("Invalid next_cursor");
+    }
+    decoded.resize(static_cast<size_t>(len));
+    decoded.erase(decoded.find_last_not_of('\0') + 1);  // block padding
+    return std::stoull(decoded);
+}
+
+// Decimal string of a 1e-6 fixed-point amount, trailing zeros trimmed
+std::string from_micros(uint64_t micros) {
+    std::string out = std::to_string(micros / 1000000);
+    uint64_t fraction = micros % 1000000;
+    if (fraction != 0) {
+        char buf[8];
+        std::snprintf(buf, sizeof(buf), "%06llu", static_cast<unsigned long long>(fraction));
+        std::string digits = buf;
+        digits.erase(digits.find_last_not_of('0') + 1);
+        out += "." + digits;
+    }
+    return out;
+}
+
+uint64_t to_micros(const std::string& decimal) {
+    return static_cast<uint64_t>(std::llround(std::stod(decimal) * 1e6));
+}
+
+// Book prices are keyed at the tick's precision so levels compare as strings
+std::string format_price(double price, const std::string& tick_size) {
+    size_t dot = tick_size.find('.');
+    int decimals = dot == std::string::npos ? 0 : static_cast<int>(tick_size.size() - dot - 1);
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(decimals) << price;
+    return oss.str();
+}
+
+int64_t now_seconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+}
+
+int64_t now_millis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+}
+
+// Order from the POST /order wire format (see utils::order_to_json)
+Order order_from_json(const json& j) {
+    Order order;
+    const json& salt = j.at("salt");
+    order.salt = salt.is_string() ? salt.get<std::string>() : std::to_string(salt.get<uint64_t>());
+    j.at("maker").get_to(order.maker);
+    j.at("signer").get_to(order.signer);
+    j.at("taker").get_to(order.taker);
+    j.at("tokenId").get_to(order.token_id);
+    j.at("makerAmount").get_to(order.maker_amount);
+    j.at("takerAmount").get_to(order.taker_amount);
+    j.at("expiration").get_to(order.expiration);
+    j.at("nonce").get_to(order.nonce);
+    j.at("feeRateBps").get_to(order.fee_rate_bps);
+
+    const json& side = j.at("side");
+    if (side.is_string()) {
+        std::string s = side.get<std::string>();
+        if (s != "BUY" && s != "SELL") {
+            throw std::runtime_error("Invalid order side: " + s);
+        }
+        order.side = s == "BUY" ? 0 : 1;
+    } else {
+        order.side = side.get<uint8_t>();
+    }
+    order.signature_type = j.at("signatureType").get<uint8_t>();
+    return order;
+}
+
+json open_order_json(const OpenOrderResponse& order) {
+    return {
+        {"id", order.id},
+        {"status", order.status},
+        {"owner", order.owner},
+        {"maker_address", order.maker_address},
+        {"market", order.market},
+        {"asset_id", order.asset_id},
+        {"side", order.side},
+        {"original_size", order.original_size},
+        {"size_matched", order.size_matched},
+        {"price", order.price},
+        {"associate_trades", order.associate_trades},
+        {"outcome", order.outcome},
+        {"created_at", order.created_at},
+        {"expiration", order.expiration},
+        {"order_type", order.order_type}
+    };
+}
+
+json post_order_result(bool success, const std::string& error_msg, const std::string& order_id,
+                       const std::string& status) {
+    return {
+        {"success", success},
+        {"errorMsg", error_msg},
+        {"orderID", order_id},
+        {"status", status},
+        {"making_amount", ""},
+        {"taking_amount", ""},
+        {"transaction_hashes", json::array()},
+        {"trade_ids", json::array()}
+    };
+}
+
+} // namespace
+
+// ========== Lifecycle ==========
+
+MockExchange::MockExchange() : MockExchange(Options{}) {}
+
+MockExchange::MockExchange(const Options& options) : options_(options) {
+    latency_us_ = options.latency.count();
+    jitter_us_ = options.jitter.count();
+    error_rate_ = options.error_rate;
+
+    auth_domain_ = eip712::hash_domain({
+        {"name", "ClobAuthDomain"},
+        {"version", "1"},
+        {"chainId", options.chain_id}
+    });
+    auto exchange_domain = [&](bool neg_risk) {
+        return eip712::hash_domain({
+            {"name", ORDER_DOMAIN_NAME},
+            {"version", ORDER_VERSION},
+            {"chainId", options.chain_id},
+            {"verifyingContract", get_contract_config(options.chain_id, neg_risk).exchange}
+        });
+    };
+    exchange_domain_ = exchange_domain(false);
+    neg_risk_exchange_domain_ = exchange_domain(true);
+
+    // httplib closes keep-alive connections after 5 requests by default,
+    // which would make load tests measure reconnects
+    size_t threads = std::max<size_t>(options.threads, 1);
+    server_.new_task_queue = [threads] { return new httplib::ThreadPool(threads); };
+    server_.set_keep_alive_max_count(1000000);
+    server_.set_keep_alive_timeout(60);
+    server_.set_tcp_nodelay(true);
+    server_.set_pre_routing_handler([this](const httplib::Request& req, httplib::Response& res) {
+        return inject(req, res);
+    });
+    register_routes();
+}
+
+MockExchange::~MockExchange() {
+    stop();
+}
+
+int MockExchange::start(const std::string& host, int port) {
+    if (thread_.joinable()) {
+        throw std::runtime_error("MockExchange already started");
+    }
+    host_ = host;
+    if (port == 0) {
+        port_ = server_.bind_to_any_port(host);
+    } else {
+        port_ = server_.bind_to_port(host, port) ? port : -1;
+    }
+    if (port_ <= 0) {
+        throw std::runtime_error("MockExchange cannot bind " + host + ":" + std::to_string(port));
+    }
+
+    thread_ = std::thread([this]() { server_.listen_after_bind(); });
+    server_.wait_until_ready();
+    return port_;
+}
+
+void MockExchange::stop() {
+    server_.stop();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+std::string MockExchange::url() const {
+    return "http://" + host_ + ":" + std::to_string(port_);
+}
+
+// ========== Configuration ==========
+
+void MockExchange::add_book(
+    const std::string& token_id,
+    const std::vector<OrderSummary>& bids,
+    const std::vector<OrderSummary>& asks,
+    const std::string& tick_size,
+    bool neg_risk
+) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Book& book = book_for(token_id);
+    book.tick_size = tick_size;
+    book.neg_risk = neg_risk;
+    book.bids.clear();
+    book.asks.clear();
+    for (const auto& level : bids) {
+        book.bids[format_price(std::stod(level.price), tick_size)] += to_micros(level.size);
+    }
+    for (const auto& level : asks) {
+        book.asks[format_price(std::stod(level.price), tick_size)] += to_micros(level.size);
+    }
+}
+
+ApiCreds MockExchange::credentials_for(const std::string& address, uint32_t nonce) {
+    std::string seed = lowercase(address) + ":" + std::to_string(nonce);
+    std::string id = hex::encode(keccak::hash256(seed + ":key"), false);
+    auto secret = keccak::hash256(seed + ":secret");
+
+    ApiCreds creds;
+    creds.api_key = id.substr(0, 8) + "-" + id.substr(8, 4) + "-" + id.substr(12, 4) + "-" +
+                    id.substr(16, 4) + "-" + id.substr(20, 12);
+    creds.api_secret = base64(std::string(secret.begin(), secret.end()));
+    std::replace(creds.api_secret.begin(), creds.api_secret.end(), '+', '-');
+    std::replace(creds.api_secret.begin(), creds.api_secret.end(), '/', '_');
+    creds.api_passphrase = hex::encode(keccak::hash256(seed + ":passphrase"), false).substr(0, 32);
+    return creds;
+}
+
+void MockExchange::set_latency(std::chrono::microseconds latency, std::chrono::microseconds jitter) {
+    latency_us_ = latency.count();
+    jitter_us_ = jitter.count();
+}
+
+void MockExchange::set_error_rate(double rate) {
+    error_rate_ = rate;
+}
+
+MockExchange::Stats MockExchange::stats() const {
+    Stats stats;
+    stats.requests = requests_;
+    stats.auth_failures = auth_failures_;
+    stats.signature_failures = signature_failures_;
+    stats.injected_errors = injected_errors_;
+    stats.orders_accepted = orders_accepted_;
+    stats.orders_canceled = orders_canceled_;
+    return stats;
+}
+
+size_t MockExchange::open_orders() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return orders_.size();
+}
+
+// ========== Routing and Authentication ==========
+
+void MockExchange::register_routes() {
+    server_.Get("/", [](const httplib::Request&, httplib::Response& res) {
+        send_json(res, "OK");
+    });
+    server_.Get(endpoints::TIME, route(&MockExchange::handle_time));
+    server_.Get(endpoints::GET_ORDER_BOOK, route(&MockExchange::handle_book));
+    server_.Post(endpoints::GET_ORDER_BOOKS, route(&MockExchange::handle_books));
+    server_.Get(endpoints::GET_TICK_SIZE, route(&MockExchange::handle_tick_size));
+    server_.Get(endpoints::GET_NEG_RISK, route(&MockExchange::handle_neg_risk));
+    server_.Get(endpoints::GET_FEE_RATE, route(&MockExchange::handle_fee_rate));
+
+    server_.Post(endpoints::CREATE_API_KEY, l1(&MockExchange::handle_create_api_key));
+    server_.Get(endpoints::DERIVE_API_KEY, l1(&MockExchange::handle_create_api_key));
+    server_.Get(endpoints::GET_API_KEYS, l2(&MockExchange::handle_get_api_keys));
+    server_.Delete(endpoints::DELETE_API_KEY, l2(&MockExchange::handle_delete_api_key));
+
+    server_.Post(endpoints::POST_ORDER, l2(&MockExchange::handle_post_order));
+    server_.Post(endpoints::POST_ORDERS, l2(&MockExchange::handle_post_orders));
+    server_.Delete(endpoints::CANCEL, l2(&MockExchange::handle_cancel));
+    server_.Delete(endpoints::CANCEL_ORDERS, l2(&MockExchange::handle_cancel_orders));
+    server_.Delete(endpoints::CANCEL_MARKET_ORDERS, l2(&MockExchange::handle_cancel_market_orders));
+    server_.Delete(endpoints::CANCEL_ALL, l2(&MockExchange::handle_cancel_all));
+    server_.Get(endpoints::ORDERS, l2(&MockExchange::handle_get_orders));
+}
+
+httplib::Server::HandlerResponse MockExchange::inject(const httplib::Request&, httplib::Response& res) {
+    requests_++;
+
+    thread_local std::mt19937_64 rng(options_.seed ^ std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+    int64_t delay = latency_us_;
+    int64_t jitter = jitter_us_;
+    if (jitter > 0) {
+        delay += std::uniform_int_distribution<int64_t>(0, jitter)(rng);
+    }
+    if (delay > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(delay));
+    }
+
+    double rate = error_rate_;
+    if (rate > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(rng) < rate) {
+        injected_errors_++;
+        send_error(res, options_.error_status, "injected failure");
+        return httplib::Server::HandlerResponse::Handled;
+    }
+    return httplib::Server::HandlerResponse::Unhandled;
+}
+
+httplib::Server::Handler MockExchange::route(Handler handler) {
+    return [this, handler](const httplib::Request& req, httplib::Response& res) {
+        try {
+            (this->*handler)(req, res);
+        } catch (const std::exception& e) {
+            send_error(res, 400, e.what());
+        }
+    };
+}
+
+httplib::Server::Handler MockExchange::l1(Handler handler) {
+    return [this, handler](const httplib::Request& req, httplib::Response& res) {
+        std::string error;
+        if (!check_l1(req, error)) {
+            auth_failures_++;
+            send_error(res, 401, error);
+            return;
+        }
+        try {
+            (this->*handler)(req, res);
+        } catch (const std::exception& e) {
+            send_error(res, 400, e.what());
+        }
+    };
+}
+
+httplib::Server::Handler MockExchange::l2(AuthedHandler handler) {
+    return [this, handler](const httplib::Request& req, httplib::Response& res) {
+        std::string error;
+        auto account = check_l2(req, error);
+        if (!account) {
+            auth_failures_++;
+            send_error(res, 401, error);
+            return;
+        }
+        try {
+            (this->*handler)(req, res, *account);
+        } catch (const std::exception& e) {
+            send_error(res, 400, e.what());
+        }
+    };
+}
+
+bool MockExchange::check_l1(const httplib::Request& req, std::string& error) const {
+    std::string address = req.get_header_value("POLY_ADDRESS");
+    std::string signature = req.get_header_value("POLY_SIGNATURE");
+    std::string timestamp = req.get_header_value("POLY_TIMESTAMP");
+    std::string nonce = req.get_header_value("POLY_NONCE");
+    if (address.empty() || signature.empty() || timestamp.empty()) {
+        error = "Missing L1 authentication headers";
+        return false;
+    }
+    if (!options_.verify_auth) {
+        return true;
+    }
+
+    try {
+        ClobAuth auth;
+        auth.address = address;
+        auth.timestamp = timestamp;
+        auth.nonce = nonce.empty() ? 0 : std::stoull(nonce);
+        auth.message = AUTH_MESSAGE;
+        auto recovered = Signer::recover_address(eip712::signing_hash(auth_domain_, auth), signature);
+        if (hex::encode(recovered) == lowercase(address)) {
+            return true;
+        }
+    } catch (const std::exception&) {
+        // Malformed signature or nonce: fall through to rejection
+    }
+    error = "Invalid L1 Request headers";
+    return false;
+}
+
+std::optional<MockExchange::Account> MockExchange::check_l2(const httplib::Request& req, std::string& error) const {
+    std::string api_key = req.get_header_value("POLY_API_KEY");
+    std::optional<Account> account;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = accounts_.find(api_key);
+        if (it != accounts_.end()) {
+            account = it->second;
+        }
+    }
+
+    if (!options_.verify_auth) {
+        // Any key is accepted and owns whatever it posts
+        if (!account) {
+            account = Account{lowercase(req.get_header_value("POLY_ADDRESS")), ApiCreds{api_key, "", ""}};
+        }
+        return account;
+    }
+
+    if (!account) {
+        error = "Unauthorized/Invalid api key";
+        return std::nullopt;
+    }
+    if (req.get_header_value("POLY_PASSPHRASE") != account->creds.api_passphrase ||
+        lowercase(req.get_header_value("POLY_ADDRESS")) != account->address) {
+        error = "Unauthorized/Invalid api key";
+        return std::nullopt;
+    }
+
+    try {
+        int64_t timestamp = std::stoll(req.get_header_value("POLY_TIMESTAMP"));
+        std::string signature = req.get_header_value("POLY_SIGNATURE");
+        std::string expected = utils::build_hmac_signature(
+            account->creds.api_secret, timestamp, req.method, req.path, req.body
+        );
+        // HttpClient sends "{}" for body-less POST/DELETE but signs an empty body
+        if (expected != signature && req.body == "{}") {
+            expected = utils::build_hmac_signature(account->creds.api_secret, timestamp, req.method, req.path, "");
+        }
+        if (expected == signature) {
+            return account;
+        }
+    } catch (const std::exception&) {
+        // Missing or malformed timestamp
+    }
+    error = "Invalid L2 Request headers";
+    return std::nullopt;
+}
+
+// ========== Public Routes ==========
+
+void MockExchange::handle_time(const httplib::Request&, httplib::Response& res) {
+    res.set_content(std::to_string(now_seconds()), "application/json");
+}
+
+void MockExchange::handle_book(const httplib::Request& req, httplib::Response& res) {
+    std::string token_id = req.get_param_value("token_id");
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = books_.find(token_id);
+    if (it == books_.end()) {
+        send_error(res, 404, "No orderbook exists for the requested token id");
+        return;
+    }
+    send_json(res, book_json(token_id, it->second));
+}
+
+void MockExchange::handle_books(const httplib::Request& req, httplib::Response& res) {
+    json request = json::parse(req.body);
+    json result = json::array();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : request) {
+        std::string token_id = entry.at("token_id").get<std::string>();
+        auto it = books_.find(token_id);
+        if (it != books_.end()) {
+            result.push_back(book_json(token_id, it->second));
+        }
+    }
+    send_json(res, result);
+}
+
+// Market metadata falls back to defaults for tokens without a book
+void MockExchange::handle_tick_size(const httplib::Request& req, httplib::Response& res) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = books_.find(req.get_param_value("token_id"));
+    std::string tick_size = it != books_.end() ? it->second.tick_size : "0.01";
+    send_json(res, {{"minimum_tick_size", std::stod(tick_size)}});
+}
+
+void MockExchange::handle_neg_risk(const httplib::Request& req, httplib::Response& res) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = books_.find(req.get_param_value("token_id"));
+    send_json(res, {{"neg_risk", it != books_.end() && it->second.neg_risk}});
+}
+
+void MockExchange::handle_fee_rate(const httplib::Request&, httplib::Response& res) {
+    send_json(res, {{"base_fee", 0}});
+}
+
+// ========== Auth Routes ==========
+
+// Create and derive both return the wallet's deterministic credentials
+void MockExchange::handle_create_api_key(const httplib::Request& req, httplib::Response& res) {
+    std::string address = lowercase(req.get_header_value("POLY_ADDRESS"));
+    std::string nonce = req.get_header_value("POLY_NONCE");
+    ApiCreds creds = credentials_for(address, nonce.empty() ? 0 : static_cast<uint32_t>(std::stoul(nonce)));
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        accounts_[creds.api_key] = Account{address, creds};
+    }
+    send_json(res, creds);
+}
+
+void MockExchange::handle_get_api_keys(const httplib::Request&, httplib::Response& res, const Account& account) {
+    send_json(res, {{"apiKeys", json::array({account.creds.api_key})}});
+}
+
+void MockExchange::handle_delete_api_key(const httplib::Request&, httplib::Response& res, const Account& account) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        accounts_.erase(account.creds.api_key);
+    }
+    send_json(res, "OK");
+}
+
+// ========== Order Routes ==========
+
+void MockExchange::handle_post_order(const httplib::Request& req, httplib::Response& res, const Account& account) {
+    json result = place_order(json::parse(req.body), account);
+    send_json(res, result, result["success"].get<bool>() ? 200 : 400);
+}
+
+void MockExchange::handle_post_orders(const httplib::Request& req, httplib::Response& res, const Account& account) {
+    json request = json::parse(req.body);
+    if (!request.is_array()) {
+        send_error(res, 400, "Expected an array of orders");
+        return;
+    }
+    if (request.size() > MAX_BATCH_ORDERS) {
+        send_error(res, 400, "Too many orders in payload, max allowed: " + std::to_string(MAX_BATCH_ORDERS));
+        return;
+    }
+
+    // Per-order failures are reported in place, as the venue does
+    json results = json::array();
+    for (const auto& entry : request) {
+        try {
+            results.push_back(place_order(entry, account));
+        } catch (const std::exception& e) {
+            results.push_back(post_order_result(false, e.what(), "", ""));
+        }
+    }
+    send_json(res, results);
+}
+
+json MockExchange::place_order(const json& body, const Account& account) {
+    const json& wire = body.at("order");
+    Order order = order_from_json(wire);
+    std::string signature = wire.at("signature").get<std::string>();
+    std::string owner = body.value("owner", "");
+    OrderType order_type = body.contains("orderType") ? body.at("orderType").get<OrderType>() : OrderType::GTC;
+
+    if (owner != account.creds.api_key) {
+        return post_order_result(false, "the order owner has to be the owner of the API KEY", "", "");
+    }
+    if (options_.verify_auth && lowercase(order.signer) != account.address) {
+        return post_order_result(false, "the order signer address has to be the address of the API KEY", "", "");
+    }
+    if (order_type == OrderType::UNKNOWN) {
+        return post_order_result(false, "invalid order type", "", "");
+    }
+
+    uint64_t maker_amount = std::stoull(order.maker_amount);
+    uint64_t taker_amount = std::stoull(order.taker_amount);
+    if (maker_amount == 0 || taker_amount == 0) {
+        return post_order_result(false, "invalid order amounts", "", "");
+    }
+
+    std::string tick_size;
+    bool neg_risk = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Book& book = book_for(order.token_id);
+        tick_size = book.tick_size;
+        neg_risk = book.neg_risk;
+    }
+
+    // The order id is the EIP-712 hash, so verification costs one recovery
+    auto hash = eip712::signing_hash(neg_risk ? neg_risk_exchange_domain_ : exchange_domain_, order);
+    std::string order_id = hex::encode(hash);
+    if (options_.verify_order_signatures) {
+        bool valid = false;
+        try {
+            valid = hex::encode(Signer::recover_address(hash, signature)) == lowercase(order.signer);
+        } catch (const std::exception&) {
+            valid = false;
+        }
+        if (!valid) {
+            signature_failures_++;
+            return post_order_result(false, "invalid signature", "", "");
+        }
+    }
+
+    // BUY pays maker_amount USDC for taker_amount shares; SELL the reverse
+    bool buy = order.side == 0;
+    uint64_t shares = buy ? taker_amount : maker_amount;
+    uint64_t collateral = buy ? maker_amount : taker_amount;
+    std::string price = format_price(static_cast<double>(collateral) / static_cast<double>(shares), tick_size);
+
+    if (order_type == OrderType::FOK || order_type == OrderType::FAK) {
+        orders_accepted_++;
+        json result = post_order_result(true, "", order_id, "MATCHED");
+        result["making_amount"] = from_micros(maker_amount);
+        result["taking_amount"] = from_micros(taker_amount);
+        result["transaction_hashes"] = json::array({hex::encode(keccak::hash256(order_id + ":tx"))});
+        result["trade_ids"] = json::array({hex::encode(keccak::hash256(order_id + ":trade"), false).substr(0, 32)});
+        return result;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (orders_.count(order_id)) {
+        return post_order_result(false, "order " + order_id + " is already placed", "", "");
+    }
+
+    Book& book = book_for(order.token_id);
+    (buy ? book.bids : book.asks)[price] += shares;
+
+    RestingOrder& resting = orders_[order_id];
+    resting.size_micros = shares;
+    resting.order.id = order_id;
+    resting.order.status = OrderStatusType::LIVE;
+    resting.order.owner = owner;
+    resting.order.maker_address = order.maker;
+    resting.order.market = book.market;
+    resting.order.asset_id = order.token_id;
+    resting.order.side = buy ? Side::BUY : Side::SELL;
+    resting.order.original_size = from_micros(shares);
+    resting.order.size_matched = "0";
+    resting.order.price = price;
+    resting.order.outcome = "";
+    resting.order.created_at = now_seconds();
+    resting.order.expiration = std::stoll(order.expiration);
+    resting.order.order_type = order_type;
+
+    orders_accepted_++;
+    return post_order_result(true, "", order_id, "LIVE");
+}
+
+void MockExchange::handle_cancel(const httplib::Request& req, httplib::Response& res, const Account& account) {
+    std::string order_id = json::parse(req.body).at("orderID").get<std::string>();
+    send_json(res, cancel_owned({order_id}, account));
+}
+
+void MockExchange::handle_cancel_orders(const httplib::Request& req, httplib::Response& res, const Account& account) {
+    auto ids = json::parse(req.body).get<std::vector<std::string>>();
+    send_json(res, cancel_owned(ids, account));
+}
+
+void MockExchange::handle_cancel_market_orders(const httplib::Request& req, httplib::Response& res,
+                                               const Account& account) {
+    // Empty filters match everything, as on GET /orders
+    json body = json::parse(req.body);
+    std::string market = body.value("market", "");
+    std::string asset_id = body.value("asset_id", "");
+
+    std::vector<std::string> ids;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [id, resting] : orders_) {
+            const auto& order = resting.order;
+            if (order.owner == account.creds.api_key &&
+                (market.empty() || order.market == market) &&
+                (asset_id.empty() || order.asset_id == asset_id)) {
+                ids.push_back(id);
+            }
+        }
+    }
+    send_json(res, cancel_owned(ids, account));
+}
+
+json MockExchange::cancel_owned(const std::vector<std::string>& ids, const Account& account) {
+    json canceled = json::array();
+    json not_canceled = json::object();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& order_id : ids) {
+        auto it = orders_.find(order_id);
+        if (it != orders_.end() && it->second.order.owner == account.creds.api_key) {
+            cancel_locked(order_id);
+            canceled.push_back(order_id);
+        } else {
+            not_canceled[order_id] = "order can't be found - already canceled or matched";
+        }
+    }
+    return {{"canceled", canceled}, {"not_canceled", not_canceled}};
+}
+
+void MockExchange::handle_cancel_all(const httplib::Request&, httplib::Response& res, const Account& account) {
+    json canceled = json::array();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::string> ids;
+        for (const auto& [id, resting] : orders_) {
+            if (resting.order.owner == account.creds.api_key) {
+                ids.push_back(id);
+            }
+        }
+        for (const auto& id : ids) {
+            cancel_locked(id);
+            canceled.push_back(id);
+        }
+    }
+    send_json(res, {{"canceled", canceled}, {"not_canceled", json::object()}});
+}
+
+void MockExchange::handle_get_orders(const httplib::Request& req, httplib::Response& res, const Account& account) {
+    std::string asset_id = req.get_param_value("asset_id");
+    std::string market = req.get_param_value("market");
+    std::string cursor = req.get_param_value("next_cursor");
+    if (cursor == END_CURSOR) {
+        send_json(res, {{"data", json::array()}, {"next_cursor", END_CURSOR}, {"limit", ORDERS_PAGE_SIZE}, {"count", 0}});
+        return;
+    }
+    size_t offset = decode_cursor(cursor);
+
+    json data = json::array();
+    size_t matched = 0;
+    bool more = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [id, resting] : orders_) {
+            const auto& order = resting.order;
+            if (order.owner != account.creds.api_key ||
+                (!asset_id.empty() && order.asset_id != asset_id) ||
+                (!market.empty() && order.market != market)) {
+                continue;
+            }
+            if (matched++ < offset) {
+                continue;
+            }
+            if (data.size() == ORDERS_PAGE_SIZE) {
+                more = true;
+                break;
+            }
+            data.push_back(open_order_json(order));
+        }
+    }
+
+    size_t count = data.size();
+    send_json(res, {
+        {"data", std::move(data)},
+        {"next_cursor", more ? encode_cursor(offset + ORDERS_PAGE_SIZE) : std::string(END_CURSOR)},
+        {"limit", ORDERS_PAGE_SIZE},
+        {"count", count}
+    });
+}
+
+// ========== Book State ==========
+
+MockExchange::Book& MockExchange::book_for(const std::string& token_id) {
+    auto it = books_.find(token_id);
+    if (it == books_.end()) {
+        it = books_.emplace(token_id, Book{}).first;
+        // Stand-in condition id; the venue maps each token to its market
+        it->second.market = hex::encode(keccak::hash256("market:" + token_id));
+    }
+    return it->second;
+}
+
+bool MockExchange::cancel_locked(const std::string& order_id) {
+    auto it = orders_.find(order_id);
+    if (it == orders_.end()) {
+        return false;
+    }
+    const auto& order = it->second.order;
+    auto book_it = books_.find(order.asset_id);
+    if (book_it != books_.end()) {
+        auto& levels = order.side == Side::BUY ? book_it->second.bids : book_it->second.asks;
+        auto level = levels.find(order.price);
+        if (level != levels.end()) {
+            level->second -= std::min(level->second, it->second.size_micros);
+            if (level->second == 0) {
+                levels.erase(level);
+            }
+        }
+    }
+    orders_.erase(it);
+    orders_canceled_++;
+    return true;
+}
+
+// Bids ascending and asks descending, so the best price is last on both sides
+json MockExchange::book_json(const std::string& token_id, const Book& book) const {
+    OrderBookSummaryResponse summary;
+    summary.market = book.market;
+    summary.asset_id = token_id;
+    summary.timestamp = std::to_string(now_millis());
+    for (const auto& [price, size] : book.bids) {
+        summary.bids.push_back({price, from_micros(size)});
+    }
+    for (auto it = book.asks.rbegin(); it != book.asks.rend(); ++it) {
+        summary.asks.push_back({it->first, from_micros(it->second)});
+    }
+
+    return {
+        {"market", summary.market},
+        {"asset_id", summary.asset_id},
+        {"timestamp", summary.timestamp},
+        {"hash", utils::generate_orderbook_summary_hash(summary)},
+        {"bids", summary.bids},
+        {"asks", summary.asks},
+        {"min_order_size", "5"},
+        {"tick_size", book.tick_size},
+        {"neg_risk", book.neg_risk}
+    };
+}
+
+} // namespace mock
+} // namespace clob
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <httplib.h>
+#include <clob/types.hpp>
+
+namespace clob {
+namespace mock {
+
+// Local stand-in for the CLOB REST API, served over real sockets so the
+// client's HttpClient path (connection pool, keep-alive, header signing) is
+// exercised end to end. Backs integration tests and throughput benchmarks.
+//
+// Implements /time, /book, /books, /tick-size, /neg-risk, /fee-rate, /order
+// and /orders (POST and DELETE), /cancel-all, /cancel-market-orders,
+// /data/orders and the /auth key endpoints. L1 headers are checked by recovering the ClobAuth signer, L2
+// headers by recomputing the HMAC, and posted orders by recovering the
+// EIP-712 order signer.
+//
+// There is no matching engine: GTC/GTD orders rest on the book until
+// canceled, and FOK/FAK orders are reported MATCHED without touching it.
+class MockExchange {
+public:
+    struct Options {
+        uint64_t chain_id = POLYGON;
+        bool verify_auth = true;               // L1 signatures and L2 HMACs
+        bool verify_order_signatures = true;   // EIP-712 recovery per posted order
+        std::chrono::microseconds latency{0};  // added to every response
+        std::chrono::microseconds jitter{0};   // plus uniform [0, jitter]
+        double error_rate = 0.0;               // fraction of requests failed with error_status
+        int error_status = 500;
+        size_t threads = 8;                    // server worker threads
+        uint64_t seed = 1;                     // jitter and error injection
+    };
+
+    struct Stats {
+        uint64_t requests = 0;
+        uint64_t auth_failures = 0;
+        uint64_t signature_failures = 0;
+        uint64_t injected_errors = 0;
+        uint64_t orders_accepted = 0;
+        uint64_t orders_canceled = 0;
+    };
+
+    MockExchange();
+    explicit MockExchange(const Options& options);
+    ~MockExchange();
+
+    MockExchange(const MockExchange&) = delete;
+    MockExchange& operator=(const MockExchange&) = delete;
+
+    // Serve on a background thread; port 0 picks a free port. Returns the
+    // bound port; throws if binding fails.
+    int start(const std::string& host = "127.0.0.1", int port = 0);
+    void stop();
+
+    int port() const { return port_; }
+    std::string url() const;
+
+    // Seed resting depth for a token. Tokens without a book return 404 from
+    // /book until an order is posted for them.
+    void add_book(
+        const std::string& token_id,
+        const std::vector<OrderSummary>& bids,
+        const std::vector<OrderSummary>& asks,
+        const std::string& tick_size = "0.01",
+        bool neg_risk = false
+    );
+
+    // Credentials /auth/api-key and /auth/derive-api-key issue for a wallet
+    // (deterministic in address and nonce)
+    static ApiCreds credentials_for(const std::string& address, uint32_t nonce = 0);
+
+    // Adjustable while serving
+    void set_latency(std::chrono::microseconds latency, std::chrono::microseconds jitter = {});
+    void set_error_rate(double rate);
+
+    Stats stats() const;
+    size_t open_orders() const;
+
+private:
+    struct Book {
+        std::string tick_size = "0.01";
+        bool neg_risk = false;
+        std::string market;
+        std::map<std::string, uint64_t> bids;  // price -> size in 1e-6 shares
+        std::map<std::string, uint64_t> asks;
+    };
+
+    struct RestingOrder {
+        OpenOrderResponse order;
+        uint64_t size_micros = 0;
+    };
+
+    struct Account {
+        std::string address;
+        ApiCreds creds;
+    };
+
+    using Handler = void (MockExchange::*)(const httplib::Request&, httplib::Response&);
+    using AuthedHandler = void (MockExchange::*)(const httplib::Request&, httplib::Response&, const Account&);
+
+    void register_routes();
+
+    // Route wrappers: malformed input becomes a 400, failed auth a 401
+    httplib::Server::Handler route(Handler handler);
+    httplib::Server::Handler l1(Handler handler);
+    httplib::Server::Handler l2(AuthedHandler handler);
+
+    bool check_l1(const httplib::Request& req, std::string& error) const;
+    std::optional<Account> check_l2(const httplib::Request& req, std::string& error) const;
+
+    // Latency and error injection, ahead of routing
+    httplib::Server::HandlerResponse inject(const httplib::Request& req, httplib::Response& res);
+
+    // Routes
+    void handle_time(const httplib::Request& req, httplib::Response& res);
+    void handle_book(const httplib::Request& req, httplib::Response& res);
+    void handle_books(const httplib::Request& req, httplib::Response& res);
+    void handle_tick_size(const httplib::Request& req, httplib::Response& res);
+    void handle_neg_risk(const httplib::Request& req, httplib::Response& res);
+    void handle_fee_rate(const httplib::Request& req, httplib::Response& res);
+    void handle_create_api_key(const httplib::Request& req, httplib::Response& res);
+    void handle_get_api_keys(const httplib::Request& req, httplib::Response& res, const Account& account);
+    void handle_delete_api_key(const httplib::Request& req, httplib::Response& res, const Account& account);
+    void handle_post_order(const httplib::Request& req, httplib::Response& res, const Account& account);
+    void handle_post_orders(const httplib::Request& req, httplib::Response& res, const Account& account);
+    void handle_cancel(const httplib::Request& req, httplib::Response& res, const Account& account);
+    void handle_cancel_orders(const httplib::Request& req, httplib::Response& res, const Account& account);
+    void handle_cancel_market_orders(const httplib::Request& req, httplib::Response& res, const Account& account);
+    void handle_cancel_all(const httplib::Request& req, httplib::Response& res, const Account& account);
+    void handle_get_orders(const httplib::Request& req, httplib::Response& res, const Account& account);
+
+    // Validate, verify and book one order from a POST body; returns the
+    // PostOrderResponse json
+    json place_order(const json& body, const Account& account);
+    json book_json(const std::string& token_id, const Book& book) const;
+    Book& book_for(const std::string& token_id);  // caller holds mutex_
+    bool cancel_locked(const std::string& order_id);
+    // Cancel the account's orders among ids; returns the canceled /
+    // not_canceled response json
+    json cancel_owned(const std::vector<std::string>& ids, const Account& account);
+
+    Options options_;
+    std::array<uint8_t, 32> auth_domain_;
+    std::array<uint8_t, 32> exchange_domain_;
+    std::array<uint8_t, 32> neg_risk_exchange_domain_;
+
+    httplib::Server server_;
+    std::thread thread_;
+    int port_ = 0;
+    std::string host_;
+
+    std::atomic<int64_t> latency_us_{0};
+    std::atomic<int64_t> jitter_us_{0};
+    std::atomic<double> error_rate_{0.0};
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Account> accounts_;       // by api key
+    std::map<std::string, Book> books_;             // by token id
+    std::map<std::string, RestingOrder> orders_;    // by order id
+
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> auth_failures_{0};
+    std::atomic<uint64_t> signature_failures_{0};
+    std::atomic<uint64_t> injected_errors_{0};
+    std::atomic<uint64_t> orders_accepted_{0};
+    std::atomic<uint64_t> orders_canceled_{0};
+};
+
+} // namespace mock
+} // namespace clob
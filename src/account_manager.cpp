@@ -0,0 +1,271 @@
+#include "clob/account_manager.hpp"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+namespace clob {
+
+// ========== TokenBucket ==========
+
+TokenBucket::TokenBucket(double rate, double burst)
+    : rate_(rate), burst_(burst), tokens_(burst), last_(Clock::now()) {
+    if (rate <= 0.0 || burst < 1.0) {
+        throw std::runtime_error("TokenBucket needs rate > 0 and burst >= 1");
+    }
+}
+
+double TokenBucket::level(Clock::time_point now) const {
+    double elapsed = std::chrono::duration<double>(now - last_).count();
+    return std::min(burst_, tokens_ + elapsed * rate_);
+}
+
+bool TokenBucket::try_acquire(double tokens) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = Clock::now();
+    tokens_ = level(now);
+    last_ = now;
+    if (tokens_ < tokens) {
+        return false;
+    }
+    tokens_ -= tokens;
+    return true;
+}
+
+void TokenBucket::acquire(double tokens) {
+    if (tokens > burst_) {
+        throw std::runtime_error("TokenBucket request exceeds burst");
+    }
+
+    while (true) {
+        std::chrono::duration<double> wait;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto now = Clock::now();
+            tokens_ = level(now);
+            last_ = now;
+            if (tokens_ >= tokens) {
+                tokens_ -= tokens;
+                return;
+            }
+            wait = std::chrono::duration<double>((tokens - tokens_) / rate_);
+        }
+        std::this_thread::sleep_for(wait);
+    }
+}
+
+double TokenBucket::available() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return level(Clock::now());
+}
+
+// ========== AccountManager ==========
+
+AccountManager::AccountManager(const std::string& host)
+    : AccountManager(host, Options{}) {}
+
+AccountManager::AccountManager(const std::string& host, const Options& options)
+    : options_(options),
+      http_(std::make_shared<HttpClient>(host.back() == '/' ? host.substr(0, host.length() - 1) : host,
+                                         options.pool_size)),
+      metadata_(std::make_shared<MarketMetadataCache>()) {}
+
+AccountManager::~AccountManager() {
+    stop_heartbeat();
+}
+
+ClobClient& AccountManager::add_account(
+    const std::string& name,
+    std::shared_ptr<Signer> signer,
+    const std::optional<ApiCreds>& creds
+) {
+    return add_account(name, std::move(signer), creds, options_.requests_per_second, options_.burst);
+}
+
+ClobClient& AccountManager::add_account(
+    const std::string& name,
+    std::shared_ptr<Signer> signer,
+    const std::optional<ApiCreds>& creds,
+    double requests_per_second,
+    double burst
+) {
+    Account account;
+    account.client = std::make_unique<ClobClient>(http_, metadata_, std::move(signer), creds);
+    account.limiter = std::make_shared<TokenBucket>(requests_per_second, burst);
+    account.client->set_rate_limiter(account.limiter);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = accounts_.emplace(name, std::move(account));
+    if (!inserted) {
+        throw std::runtime_error("Account already registered: " + name);
+    }
+    return *it->second.client;
+}
+
+bool AccountManager::remove_account(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return accounts_.erase(name) > 0;
+}
+
+bool AccountManager::has_account(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return accounts_.count(name) > 0;
+}
+
+size_t AccountManager::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return accounts_.size();
+}
+
+std::vector<std::string> AccountManager::account_names() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> names;
+    names.reserve(accounts_.size());
+    for (const auto& [name, account] : accounts_) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+AccountManager::Account& AccountManager::find(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = accounts_.find(name);
+    if (it == accounts_.end()) {
+        throw std::runtime_error("Unknown account: " + name);
+    }
+    return it->second;
+}
+
+ClobClient& AccountManager::account(const std::string& name) {
+    return *find(name).client;
+}
+
+TokenBucket& AccountManager::rate_limiter(const std::string& name) {
+    return *find(name).limiter;
+}
+
+std::vector<AccountManager::AccountResult> AccountManager::for_each_parallel(
+    const std::function<void(const std::string&, ClobClient&)>& fn
+) {
+    std::vector<std::pair<std::string, ClobClient*>> targets;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [name, account] : accounts_) {
+            targets.emplace_back(name, account.client.get());
+        }
+    }
+
+    // Requests beyond pool_size queue on the shared connections
+    std::vector<std::future<AccountResult>> tasks;
+    tasks.reserve(targets.size());
+    for (const auto& target : targets) {
+        tasks.push_back(std::async(std::launch::async, [&fn, &target]() {
+            AccountResult result;
+            result.name = target.first;
+            try {
+                fn(target.first, *target.second);
+                result.success = true;
+            } catch (const std::exception& e) {
+                result.error = e.what();
+            } catch (...) {
+                result.error = "unknown error";
+            }
+            return result;
+        }));
+    }
+
+    std::vector<AccountResult> results;
+    results.reserve(tasks.size());
+    for (auto& task : tasks) {
+        results.push_back(task.get());
+    }
+    return results;
+}
+
+AccountManager::DerivedCredentials AccountManager::derive_api_keys(
+    const std::vector<std::shared_ptr<Signer>>& signers,
+    std::optional<uint32_t> nonce
+) {
+    DerivedCredentials result;
+    if (signers.empty()) {
+        return result;
+    }
+
+    // Signing is CPU-bound and the requests queue on pool_size connections,
+    // so more workers than either would only add contention
+    // (hardware_concurrency() may report 0 when unknown)
+    size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+    size_t workers = std::min<size_t>(std::max<size_t>(1, options_.pool_size), cores);
+    workers = std::min(workers, signers.size());
+
+    struct Outcome {
+        std::optional<ApiCreds> creds;
+        std::string error;
+    };
+    std::vector<Outcome> outcomes(signers.size());
+    std::atomic<size_t> next{0};
+
+    auto work = [&]() {
+        for (size_t i = next++; i < signers.size(); i = next++) {
+            try {
+                ClobClient client(http_, metadata_, signers[i]);
+                outcomes[i].creds = client.derive_api_key(nonce);
+            } catch (const std::exception& e) {
+                outcomes[i].error = e.what();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < workers; ++t) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < signers.size(); ++i) {
+        const std::string& address = signers[i]->address();
+        if (outcomes[i].creds) {
+            result.creds[address] = *outcomes[i].creds;
+        } else {
+            result.errors[address] = outcomes[i].error;
+        }
+    }
+    return result;
+}
+
+AccountManager::DerivedCredentials AccountManager::derive_api_keys(
+    const std::vector<std::shared_ptr<Signer>>& signers,
+    const CredentialStore& store,
+    std::optional<uint32_t> nonce
+) {
+    auto stored = store.load();
+
+    DerivedCredentials result;
+    std::vector<std::shared_ptr<Signer>> missing;
+    for (const auto& signer : signers) {
+        auto it = stored.find(signer->address());
+        if (it != stored.end()) {
+            result.creds[it->first] = it->second;
+            result.from_store++;
+        } else {
+            missing.push_back(signer);
+        }
+    }
+    if (missing.empty()) {
+        return result;
+    }
+
+    auto derived = derive_api_keys(missing, nonce);
+    if (!derived.creds.empty()) {
+        store.merge(derived.creds);
+    }
+    result.creds.insert(derived.creds.begin(), derived.creds.end());
+    result.errors = std::move(derived.errors);
+    return result;
+}
+
+} // namespace clob
@@ -1,12 +1,10 @@
 #include "clob/client.hpp"
+#include "clob/account_manager.hpp"
 #include "clob/constants.hpp"
 #include "clob/utilities.hpp"
-#include "clob/eip712.hpp"
-#include <openssl/hmac.h>
-#include <openssl/sha.h>
-#include <openssl/evp.h>
-#include <openssl/bio.h>
-#include <openssl/buffer.h>
+#include "clob/eip712_struct.hpp"
+#include "clob/metrics.hpp"
+#include "clob/trace.hpp"
 #include <chrono>
 #include <sstream>
 #include <iomanip>
@@ -18,26 +16,44 @@ namespace clob {
 
 ClobClient::ClobClient(const std::string& host)
     : host_(host.back() == '/' ? host.substr(0, host.length() - 1) : host),
-      http_(std::make_unique<HttpClient>(host_)),
-      mode_(AuthLevel::L0) {}
+      http_(std::make_shared<HttpClient>(host_)),
+      mode_(AuthLevel::L0),
+      metadata_(std::make_shared<MarketMetadataCache>()) {}
 
 ClobClient::ClobClient(const std::string& host, std::shared_ptr<Signer> signer)
     : host_(host.back() == '/' ? host.substr(0, host.length() - 1) : host),
-      http_(std::make_unique<HttpClient>(host_)),
+      http_(std::make_shared<HttpClient>(host_)),
       signer_(signer),
       builder_(std::make_unique<OrderBuilder>(signer)),
-      mode_(AuthLevel::L1) {}
+      mode_(AuthLevel::L1),
+      metadata_(std::make_shared<MarketMetadataCache>()) {}
 
 ClobClient::ClobClient(
     const std::string& host,
     std::shared_ptr<Signer> signer,
     const ApiCreds& creds
 ) : host_(host.back() == '/' ? host.substr(0, host.length() - 1) : host),
-    http_(std::make_unique<HttpClient>(host_)),
+    http_(std::make_shared<HttpClient>(host_)),
     signer_(signer),
     creds_(creds),
     builder_(std::make_unique<OrderBuilder>(signer)),
-    mode_(AuthLevel::L2) {}
+    mode_(AuthLevel::L2),
+    metadata_(std::make_shared<MarketMetadataCache>()) {}
+
+ClobClient::ClobClient(
+    std::shared_ptr<HttpClient> http,
+    std::shared_ptr<MarketMetadataCache> metadata,
+    std::shared_ptr<Signer> signer,
+    const std::optional<ApiCreds>& creds
+) : host_(http->get_host()),
+    http_(std::move(http)),
+    signer_(signer),
+    creds_(signer ? creds : std::nullopt),
+    builder_(signer ? std::make_unique<OrderBuilder>(signer) : nullptr),
+    mode_(AuthLevel::L0),
+    metadata_(metadata ? std::move(metadata) : std::make_shared<MarketMetadataCache>()) {
+    mode_ = get_client_mode();
+}
 
 // ========== Helper Methods ==========
 
@@ -87,7 +103,46 @@ std::string ClobClient::get_exchange_address(bool neg_risk) const {
 
 // ========== L1 Header Creation ==========
 
+const std::string& ClobClient::l1_signature(uint32_t nonce, int64_t timestamp) {
+    CLOB_TRACE_SCOPE("auth.l1_sign");
+    static constexpr size_t TIMESTAMP_OFFSET = eip712::field_offset<ClobAuth>("timestamp");
+    static constexpr size_t NONCE_OFFSET = eip712::field_offset<ClobAuth>("nonce");
+    static_assert(sizeof(L1AuthCache::encoded) == sizeof(decltype(eip712::encode_struct(ClobAuth{}))),
+                  "L1AuthCache::encoded must hold encode_struct(ClobAuth)");
+    
+    // create_or_derive_api_creds signs twice within the same second
+    if (!l1_auth_.signature.empty() && l1_auth_.nonce == nonce && l1_auth_.timestamp == timestamp) {
+        return l1_auth_.signature;
+    }
+    
+    if (!l1_auth_.primed) {
+        ClobAuth clob_auth;
+        clob_auth.address = signer_->address();
+        clob_auth.message = "This message attests that I control the given wallet";
+        l1_auth_.encoded = eip712::encode_struct(clob_auth);
+        
+        json domain = {
+            {"name", "ClobAuthDomain"},
+            {"version", "1"},
+            {"chainId", signer_->get_chain_id()}
+        };
+        l1_auth_.domain_separator = eip712::hash_domain(domain);
+        l1_auth_.primed = true;
+    }
+    
+    // Only the timestamp and nonce words change between calls
+    eip712::sol::string::encode(std::to_string(timestamp), l1_auth_.encoded.data() + TIMESTAMP_OFFSET);
+    eip712::sol::uint256::encode(static_cast<uint64_t>(nonce), l1_auth_.encoded.data() + NONCE_OFFSET);
+    auto struct_hash = keccak::hash256(l1_auth_.encoded.data(), l1_auth_.encoded.size());
+    
+    l1_auth_.signature = signer_->sign(eip712::signing_digest(l1_auth_.domain_separator, struct_hash));
+    l1_auth_.nonce = nonce;
+    l1_auth_.timestamp = timestamp;
+    return l1_auth_.signature;
+}
+
 Headers ClobClient::create_l1_headers(std::optional<uint32_t> nonce) {
+    CLOB_TRACE_SCOPE("auth.l1_headers");
     assert_level_1_auth();
     
     // Get timestamp
@@ -96,33 +151,7 @@ Headers ClobClient::create_l1_headers(std::optional<uint32_t> nonce) {
         now.time_since_epoch()
     ).count();
     
-    // Build ClobAuth message
-    json clob_auth = {
-        {"address", signer_->address()},
-        {"timestamp", std::to_string(timestamp)},
-        {"nonce", nonce.value_or(0)},
-        {"message", "This message attests that I control the given wallet"}
-    };
-    
-    // EIP712 domain
-    json domain = {
-        {"name", "ClobAuthDomain"},
-        {"version", "1"},
-        {"chainId", signer_->get_chain_id()}
-    };
-    
-    // EIP712 types
-    json types = {
-        {"ClobAuth", json::array({
-            {{"name", "address"}, {"type", "address"}},
-            {{"name", "timestamp"}, {"type", "string"}},
-            {{"name", "nonce"}, {"type", "uint256"}},
-            {{"name", "message"}, {"type", "string"}}
-        })}
-    };
-    
-    // Sign
-    std::string signature = signer_->sign_typed_data(domain, "ClobAuth", clob_auth, types);
+    std::string signature = l1_signature(nonce.value_or(0), timestamp);
     
     Headers headers;
     headers["POLY_ADDRESS"] = signer_->address();
@@ -140,79 +169,30 @@ Headers ClobClient::create_l2_headers(
     const std::string& request_path,
     const std::string& body
 ) {
+    CLOB_TRACE_SCOPE("auth.l2_headers");
     assert_level_2_auth();
     
+    // Per-account rate limit; taken before the timestamp so a wait cannot
+    // leave a stale one in the signature
+    if (rate_limiter_) {
+        CLOB_TRACE_SCOPE("auth.rate_limit");
+        rate_limiter_->acquire();
+    }
+    
     // Get timestamp
     auto now = std::chrono::system_clock::now();
     auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
         now.time_since_epoch()
     ).count();
     
-    // Build message: timestamp + method + path + body
-    std::string message = std::to_string(timestamp) + method + request_path + body;
-    
-    // HMAC-SHA256
-    unsigned char hmac_result[32];
-    
-    // Decode URL-safe base64 secret (API secret uses URL-safe base64: - and _ instead of + and /)
-    std::string secret_copy = creds_->api_secret;
-    // Convert URL-safe base64 to standard base64
-    for (char& c : secret_copy) {
-        if (c == '-') c = '+';
-        if (c == '_') c = '/';
-    }
-    // Add padding if needed
-    while (secret_copy.length() % 4 != 0) {
-        secret_copy += '=';
-    }
-    
-    BIO* bio_decode = BIO_new_mem_buf(secret_copy.data(), secret_copy.length());
-    BIO* b64_decode = BIO_new(BIO_f_base64());
-    BIO_set_flags(b64_decode, BIO_FLAGS_BASE64_NO_NL);
-    bio_decode = BIO_push(b64_decode, bio_decode);
-    
-    std::vector<uint8_t> decoded_secret(256);  // Max size
-    int decoded_len = BIO_read(bio_decode, decoded_secret.data(), 256);
-    BIO_free_all(bio_decode);
-    
-    if (decoded_len <= 0) {
-        throw std::runtime_error("Failed to decode API secret");
-    }
-    decoded_secret.resize(decoded_len);
-    
-    // Compute HMAC
-    unsigned int hmac_len = 32;
-    HMAC(EVP_sha256(),
-         decoded_secret.data(), decoded_secret.size(),
-         reinterpret_cast<const unsigned char*>(message.data()), message.length(),
-         hmac_result, &hmac_len);
-    
-    // Base64 encode the HMAC result (URL-safe base64)
-    BIO* bio = BIO_new(BIO_s_mem());
-    BIO* b64 = BIO_new(BIO_f_base64());
-    BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
-    bio = BIO_push(b64, bio);
-    BIO_write(bio, hmac_result, hmac_len);
-    BIO_flush(bio);
-    
-    BUF_MEM* buffer_ptr;
-    BIO_get_mem_ptr(bio, &buffer_ptr);
-    std::string signature(buffer_ptr->data, buffer_ptr->length);
-    BIO_free_all(bio);
-    
-    // Convert to URL-safe base64 (+ → -, / → _)
-    // NOTE: Must keep base64 "=" padding suffix (required by API)
-    for (char& c : signature) {
-        if (c == '+') c = '-';
-        if (c == '/') c = '_';
-    }
-    
-    // Convert address to lowercase (API requires lowercase)
-    std::string address = signer_->address();
-    std::transform(address.begin(), address.end(), address.begin(), ::tolower);
+    CLOB_TRACE_SPAN(hmac, "auth.hmac");
+    std::string signature = utils::build_hmac_signature(
+        creds_->api_secret, timestamp, method, request_path, body
+    );
+    CLOB_TRACE_END(hmac);
     
     Headers headers;
-    headers["POLY_ADDRESS"] = address;
+    headers["POLY_ADDRESS"] = signer_->address();  // Already lowercase (API requires lowercase)
     headers["POLY_API_KEY"] = creds_->api_key;
     headers["POLY_PASSPHRASE"] = creds_->api_passphrase;
     headers["POLY_SIGNATURE"] = signature;
@@ -224,94 +204,107 @@ Headers ClobClient::create_l2_headers(
 // ========== Public Endpoints (L0) ==========
 
 std::string ClobClient::get_ok() {
+    CLOB_TRACE_SCOPE("client.get_ok");
     auto response = http_->get("/");
     return response.get<std::string>();
 }
 
 Timestamp ClobClient::get_server_time() {
+    CLOB_TRACE_SCOPE("client.get_server_time");
     // Server time returns plain number, not JSON object
     auto elem = http_->get_simd(endpoints::TIME);
     return elem.get_int64().value();
 }
 
 Page<MarketResponse> ClobClient::get_markets(const std::string& next_cursor) {
+    CLOB_TRACE_SCOPE("client.get_markets");
     json params = {{"next_cursor", next_cursor}};
-    // Use SIMD JSON for 20x faster parsing
+    // Use SIMD JSON for faster parsing
     auto elem = http_->get_simd(endpoints::GET_MARKETS, std::nullopt, params);
     return utils::parse_page_simd<MarketResponse>(elem, utils::parse_market_simd);
 }
 
 MarketResponse ClobClient::get_market(const std::string& condition_id) {
-    // Use SIMD JSON for 20x faster parsing
+    CLOB_TRACE_SCOPE("client.get_market");
+    // Use SIMD JSON for faster parsing
     auto elem = http_->get_simd(std::string(endpoints::GET_MARKET) + condition_id);
     return utils::parse_market_simd(elem);
 }
 
 OrderBookSummaryResponse ClobClient::get_order_book(const std::string& token_id) {
+    CLOB_TRACE_SCOPE("client.get_order_book");
     json params = {{"token_id", token_id}};
-    // Use SIMD JSON for 20x faster parsing
+    // Use SIMD JSON for faster parsing
     auto elem = http_->get_simd(endpoints::GET_ORDER_BOOK, std::nullopt, params);
     return utils::parse_orderbook_simd(elem);
 }
 
 TickSizeResponse ClobClient::get_tick_size(const std::string& token_id) {
+    CLOB_TRACE_SCOPE("client.get_tick_size");
     // Check cache
-    auto it = tick_sizes_.find(token_id);
-    if (it != tick_sizes_.end()) {
-        return it->second;
+    if (auto cached = metadata_->find<TickSizeResponse>(token_id)) {
+        metrics::record_cache(metrics::Cache::TICK_SIZE, true);
+        return *cached;
     }
+    metrics::record_cache(metrics::Cache::TICK_SIZE, false);
     
     // Fetch from API
     json params = {{"token_id", token_id}};
     auto elem = http_->get_simd(endpoints::GET_TICK_SIZE, std::nullopt, params);
     auto response = utils::parse_tick_size_simd(elem);
     
-    tick_sizes_[token_id] = response;
+    metadata_->put(token_id, response);
     
     return response;
 }
 
 NegRiskResponse ClobClient::get_neg_risk(const std::string& token_id) {
+    CLOB_TRACE_SCOPE("client.get_neg_risk");
     // Check cache
-    auto it = neg_risk_.find(token_id);
-    if (it != neg_risk_.end()) {
-        return it->second;
+    if (auto cached = metadata_->find<NegRiskResponse>(token_id)) {
+        metrics::record_cache(metrics::Cache::NEG_RISK, true);
+        return *cached;
     }
+    metrics::record_cache(metrics::Cache::NEG_RISK, false);
     
     // Fetch from API
     json params = {{"token_id", token_id}};
     auto elem = http_->get_simd(endpoints::GET_NEG_RISK, std::nullopt, params);
     auto response = utils::parse_neg_risk_simd(elem);
     
-    neg_risk_[token_id] = response;
+    metadata_->put(token_id, response);
     
     return response;
 }
 
 FeeRateResponse ClobClient::get_fee_rate_bps(const std::string& token_id) {
+    CLOB_TRACE_SCOPE("client.get_fee_rate_bps");
     // Check cache
-    auto it = fee_rates_.find(token_id);
-    if (it != fee_rates_.end()) {
-        return it->second;
+    if (auto cached = metadata_->find<FeeRateResponse>(token_id)) {
+        metrics::record_cache(metrics::Cache::FEE_RATE, true);
+        return *cached;
     }
+    metrics::record_cache(metrics::Cache::FEE_RATE, false);
     
     // Fetch from API
     json params = {{"token_id", token_id}};
     auto elem = http_->get_simd(endpoints::GET_FEE_RATE, std::nullopt, params);
     auto response = utils::parse_fee_rate_simd(elem);
     
-    fee_rates_[token_id] = response;
+    metadata_->put(token_id, response);
     
     return response;
 }
 
 MidpointResponse ClobClient::get_midpoint(const std::string& token_id) {
+    CLOB_TRACE_SCOPE("client.get_midpoint");
     json params = {{"token_id", token_id}};
     auto elem = http_->get_simd(endpoints::MID_POINT, std::nullopt, params);
     return utils::parse_midpoint_simd(elem);
 }
 
 PriceResponse ClobClient::get_price(const std::string& token_id, Side side) {
+    CLOB_TRACE_SCOPE("client.get_price");
     json side_str;
     to_json(side_str, side);
     json params = {{"token_id", token_id}, {"side", side_str}};
@@ -320,12 +313,14 @@ PriceResponse ClobClient::get_price(const std::string& token_id, Side side) {
 }
 
 SpreadResponse ClobClient::get_spread(const std::string& token_id) {
+    CLOB_TRACE_SCOPE("client.get_spread");
     json params = {{"token_id", token_id}};
     auto elem = http_->get_simd(endpoints::GET_SPREAD, std::nullopt, params);
     return utils::parse_spread_simd(elem);
 }
 
 LastTradePriceResponse ClobClient::get_last_trade_price(const std::string& token_id) {
+    CLOB_TRACE_SCOPE("client.get_last_trade_price");
     json params = {{"token_id", token_id}};
     auto elem = http_->get_simd(endpoints::GET_LAST_TRADE_PRICE, std::nullopt, params);
     return utils::parse_last_trade_price_simd(elem);
@@ -338,19 +333,19 @@ void ClobClient::deauthenticate() {
     signer_.reset();
     creds_.reset();
     builder_.reset();
+    l1_auth_ = L1AuthCache{};
     
     // Reset to public-only mode
     mode_ = AuthLevel::L0;
     
-    // Clear caches (they might contain authenticated data)
-    tick_sizes_.clear();
-    neg_risk_.clear();
-    fee_rates_.clear();
+    // Detach from the metadata cache (it may be shared with other accounts)
+    metadata_ = std::make_shared<MarketMetadataCache>();
 }
 
 // ========== L1 Authenticated Endpoints ==========
 
 ApiCreds ClobClient::create_api_key(std::optional<uint32_t> nonce) {
+    CLOB_TRACE_SCOPE("client.create_api_key");
     assert_level_1_auth();
     
     auto headers = create_l1_headers(nonce);
@@ -362,6 +357,7 @@ ApiCreds ClobClient::create_api_key(std::optional<uint32_t> nonce) {
 }
 
 ApiCreds ClobClient::derive_api_key(std::optional<uint32_t> nonce) {
+    CLOB_TRACE_SCOPE("client.derive_api_key");
     assert_level_1_auth();
     
     auto headers = create_l1_headers(nonce);
@@ -373,6 +369,7 @@ ApiCreds ClobClient::derive_api_key(std::optional<uint32_t> nonce) {
 }
 
 ApiCreds ClobClient::create_or_derive_api_creds(std::optional<uint32_t> nonce) {
+    CLOB_TRACE_SCOPE("client.create_or_derive_api_creds");
     try {
         return create_api_key(nonce);
     } catch (...) {
@@ -388,6 +385,7 @@ void ClobClient::set_api_creds(const ApiCreds& creds) {
 }
 
 ApiKeysResponse ClobClient::get_api_keys() {
+    CLOB_TRACE_SCOPE("client.get_api_keys");
     assert_level_2_auth();
     
     auto headers = create_l2_headers("GET", endpoints::GET_API_KEYS);
@@ -399,6 +397,7 @@ SignedOrder ClobClient::create_order(
     const OrderArgs& args,
     const CreateOrderOptions& options
 ) {
+    CLOB_TRACE_SCOPE("client.create_order");
     assert_level_1_auth();
     
     // Validate price
@@ -413,29 +412,82 @@ SignedOrder ClobClient::create_market_order(
     const MarketOrderArgs& args,
     const CreateOrderOptions& options
 ) {
+    CLOB_TRACE_SCOPE("client.create_market_order");
     assert_level_1_auth();
     return builder_->create_market_order(args, options);
 }
 
+// Posted / filled / rejected counters for a post_order(s) response
+static void record_order_outcomes(const PostOrderResponse* responses, size_t count) {
+    uint64_t filled = 0;
+    uint64_t rejected = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!responses[i].success) {
+            rejected++;
+        } else if (responses[i].status == OrderStatusType::MATCHED) {
+            filled++;
+        }
+    }
+    metrics::record_orders(count, filled, rejected);
+}
+
+// Wait for a parallel signature check started by OrderBuilder. The order has
+// already been sent, so a failure is attached to its response rather than thrown
+static void await_verification(const SignedOrder& order, PostOrderResponse& response) {
+    if (!order.verification.valid()) {
+        return;
+    }
+    CLOB_TRACE_SCOPE("order.await_verification");
+    if (!order.verification.get()) {
+        response.signature_verified = false;
+        std::string msg = "Order signature failed local verification (does not recover to order signer)";
+        response.error_msg = response.error_msg && !response.error_msg->empty()
+            ? *response.error_msg + "; " + msg
+            : msg;
+    }
+}
+
+void ClobClient::set_signature_verification(SignatureVerification mode) {
+    assert_level_1_auth();
+    builder_->set_signature_verification(mode);
+}
+
+OrderBuilder::VerificationStats ClobClient::get_verification_stats() const {
+    return builder_ ? builder_->get_verification_stats() : OrderBuilder::VerificationStats{};
+}
+
 PostOrderResponse ClobClient::post_order(const SignedOrder& order, OrderType order_type) {
+    CLOB_TRACE_SCOPE("client.post_order");
     assert_level_2_auth();
     
     // Single order uses /order endpoint (not wrapped in array)
+    CLOB_TRACE_SPAN(serialize, "order.serialize");
     json order_json = utils::order_to_json(order, creds_->api_key, order_type);
     
     std::string body = order_json.dump();
+    CLOB_TRACE_END(serialize);
     
     auto headers = create_l2_headers("POST", endpoints::POST_ORDER, body);
     
     // Use SIMD JSON for faster parsing
-    auto elem = http_->post_simd(endpoints::POST_ORDER, order_json, headers);
-    return utils::parse_post_order_simd(elem);
+    PostOrderResponse response;
+    try {
+        auto elem = http_->post_simd(endpoints::POST_ORDER, order_json, headers);
+        response = utils::parse_post_order_simd(elem);
+    } catch (...) {
+        metrics::record_orders(1, 0, 1);
+        throw;
+    }
+    await_verification(order, response);
+    record_order_outcomes(&response, 1);
+    return response;
 }
 
 Page<OpenOrderResponse> ClobClient::get_orders(
     const std::optional<OpenOrderParams>& params,
     const std::string& next_cursor
 ) {
+    CLOB_TRACE_SCOPE("client.get_orders");
     assert_level_2_auth();
     
     auto headers = create_l2_headers("GET", endpoints::ORDERS);
@@ -456,6 +508,7 @@ Page<OpenOrderResponse> ClobClient::get_orders(
 }
 
 CancelOrdersResponse ClobClient::cancel(const std::string& order_id) {
+    CLOB_TRACE_SCOPE("client.cancel");
     assert_level_2_auth();
     
     json data = {{"orderID", order_id}};
@@ -467,6 +520,7 @@ CancelOrdersResponse ClobClient::cancel(const std::string& order_id) {
 }
 
 CancelOrdersResponse ClobClient::cancel_all() {
+    CLOB_TRACE_SCOPE("client.cancel_all");
     assert_level_2_auth();
     
     auto headers = create_l2_headers("DELETE", endpoints::CANCEL_ALL);
@@ -480,6 +534,7 @@ double ClobClient::calculate_market_price(
     double amount,
     OrderType order_type
 ) {
+    CLOB_TRACE_SCOPE("client.calculate_market_price");
     auto book = get_order_book(token_id);
     
     if (side == Side::BUY) {
@@ -496,6 +551,7 @@ double ClobClient::calculate_market_price(
 }
 
 OpenOrderResponse ClobClient::get_order(const std::string& order_id) {
+    CLOB_TRACE_SCOPE("client.get_order");
     assert_level_2_auth();
     
     std::string path = std::string(endpoints::GET_ORDER) + order_id;
@@ -505,6 +561,7 @@ OpenOrderResponse ClobClient::get_order(const std::string& order_id) {
 }
 
 CancelOrdersResponse ClobClient::cancel_orders(const std::vector<std::string>& order_ids) {
+    CLOB_TRACE_SCOPE("client.cancel_orders");
     assert_level_2_auth();
     
     json data = order_ids;
@@ -516,6 +573,7 @@ CancelOrdersResponse ClobClient::cancel_orders(const std::vector<std::string>& o
 }
 
 CancelOrdersResponse ClobClient::cancel_market_orders(const std::string& market, const std::string& asset_id) {
+    CLOB_TRACE_SCOPE("client.cancel_market_orders");
     assert_level_2_auth();
     
     json data = {{"market", market}, {"asset_id", asset_id}};
@@ -530,6 +588,7 @@ Page<TradeResponse> ClobClient::get_trades(
     const std::optional<TradeParams>& params,
     const std::string& next_cursor
 ) {
+    CLOB_TRACE_SCOPE("client.get_trades");
     assert_level_2_auth();
     
     auto headers = create_l2_headers("GET", endpoints::TRADES);
@@ -556,6 +615,7 @@ Page<TradeResponse> ClobClient::get_trades(
 }
 
 BalanceAllowanceResponse ClobClient::get_balance_allowance(const std::optional<BalanceAllowanceParams>& params) {
+    CLOB_TRACE_SCOPE("client.get_balance_allowance");
     assert_level_2_auth();
     
     auto headers = create_l2_headers("GET", endpoints::GET_BALANCE_ALLOWANCE);
@@ -576,6 +636,7 @@ BalanceAllowanceResponse ClobClient::get_balance_allowance(const std::optional<B
 }
 
 void ClobClient::update_balance_allowance(const std::optional<BalanceAllowanceParams>& params) {
+    CLOB_TRACE_SCOPE("client.update_balance_allowance");
     assert_level_2_auth();
     
     auto headers = create_l2_headers("GET", endpoints::UPDATE_BALANCE_ALLOWANCE);
@@ -595,6 +656,7 @@ void ClobClient::update_balance_allowance(const std::optional<BalanceAllowancePa
 }
 
 std::vector<NotificationResponse> ClobClient::get_notifications() {
+    CLOB_TRACE_SCOPE("client.get_notifications");
     assert_level_2_auth();
     
     auto headers = create_l2_headers("GET", endpoints::GET_NOTIFICATIONS);
@@ -608,6 +670,7 @@ std::vector<NotificationResponse> ClobClient::get_notifications() {
 }
 
 void ClobClient::drop_notifications() {
+    CLOB_TRACE_SCOPE("client.drop_notifications");
     assert_level_2_auth();
     
     auto headers = create_l2_headers("DELETE", endpoints::DROP_NOTIFICATIONS);
@@ -615,6 +678,7 @@ void ClobClient::drop_notifications() {
 }
 
 OrderScoringResponse ClobClient::is_order_scoring(const std::string& order_id) {
+    CLOB_TRACE_SCOPE("client.is_order_scoring");
     assert_level_2_auth();
     
     auto headers = create_l2_headers("GET", endpoints::IS_ORDER_SCORING);
@@ -625,6 +689,7 @@ OrderScoringResponse ClobClient::is_order_scoring(const std::string& order_id) {
 }
 
 OrdersScoringResponse ClobClient::are_orders_scoring(const std::vector<std::string>& order_ids) {
+    CLOB_TRACE_SCOPE("client.are_orders_scoring");
     assert_level_2_auth();
     
     json data = order_ids;
@@ -635,24 +700,28 @@ OrdersScoringResponse ClobClient::are_orders_scoring(const std::vector<std::stri
 }
 
 Page<SimplifiedMarketResponse> ClobClient::get_simplified_markets(const std::string& next_cursor) {
+    CLOB_TRACE_SCOPE("client.get_simplified_markets");
     json params = {{"next_cursor", next_cursor}};
     auto elem = http_->get_simd(endpoints::GET_SIMPLIFIED_MARKETS, std::nullopt, params);
     return utils::parse_page_simd<SimplifiedMarketResponse>(elem, utils::parse_simplified_market_simd);
 }
 
 Page<MarketResponse> ClobClient::get_sampling_markets(const std::string& next_cursor) {
+    CLOB_TRACE_SCOPE("client.get_sampling_markets");
     json params = {{"next_cursor", next_cursor}};
     auto elem = http_->get_simd(endpoints::GET_SAMPLING_MARKETS, std::nullopt, params);
     return utils::parse_page_simd<MarketResponse>(elem, utils::parse_market_simd);
 }
 
 Page<SimplifiedMarketResponse> ClobClient::get_sampling_simplified_markets(const std::string& next_cursor) {
+    CLOB_TRACE_SCOPE("client.get_sampling_simplified_markets");
     json params = {{"next_cursor", next_cursor}};
     auto elem = http_->get_simd(endpoints::GET_SAMPLING_SIMPLIFIED_MARKETS, std::nullopt, params);
     return utils::parse_page_simd<SimplifiedMarketResponse>(elem, utils::parse_simplified_market_simd);
 }
 
 std::vector<OrderBookSummaryResponse> ClobClient::get_order_books(const std::vector<std::string>& token_ids) {
+    CLOB_TRACE_SCOPE("client.get_order_books");
     json body = json::array();
     for (const auto& token_id : token_ids) {
         body.push_back({{"token_id", token_id}});
@@ -664,6 +733,7 @@ std::vector<OrderBookSummaryResponse> ClobClient::get_order_books(const std::vec
 }
 
 MidpointsResponse ClobClient::get_midpoints(const std::vector<std::string>& token_ids) {
+    CLOB_TRACE_SCOPE("client.get_midpoints");
     json body = json::array();
     for (const auto& token_id : token_ids) {
         body.push_back({{"token_id", token_id}});
@@ -672,12 +742,14 @@ MidpointsResponse ClobClient::get_midpoints(const std::vector<std::string>& toke
 }
 
 PricesResponse ClobClient::get_prices(const std::vector<PriceRequest>& requests) {
+    CLOB_TRACE_SCOPE("client.get_prices");
     json body;
     to_json(body, requests);
     return http_->post_typed<PricesResponse>(endpoints::GET_PRICES, body);
 }
 
 SpreadsResponse ClobClient::get_spreads(const std::vector<std::string>& token_ids) {
+    CLOB_TRACE_SCOPE("client.get_spreads");
     json body = json::array();
     for (const auto& token_id : token_ids) {
         body.push_back({{"token_id", token_id}});
@@ -686,6 +758,7 @@ SpreadsResponse ClobClient::get_spreads(const std::vector<std::string>& token_id
 }
 
 std::vector<LastTradesPricesResponse> ClobClient::get_last_trades_prices(const std::vector<std::string>& token_ids) {
+    CLOB_TRACE_SCOPE("client.get_last_trades_prices");
     json body = json::array();
     for (const auto& token_id : token_ids) {
         body.push_back({{"token_id", token_id}});
@@ -696,6 +769,7 @@ std::vector<LastTradesPricesResponse> ClobClient::get_last_trades_prices(const s
 }
 
 BanStatusResponse ClobClient::get_closed_only_mode() {
+    CLOB_TRACE_SCOPE("client.get_closed_only_mode");
     assert_level_2_auth();
     
     auto headers = create_l2_headers("GET", endpoints::CLOSED_ONLY);
@@ -704,6 +778,7 @@ BanStatusResponse ClobClient::get_closed_only_mode() {
 }
 
 json ClobClient::delete_api_key() {
+    CLOB_TRACE_SCOPE("client.delete_api_key");
     assert_level_2_auth();
     
     auto headers = create_l2_headers("DELETE", endpoints::DELETE_API_KEY);
@@ -711,25 +786,41 @@ json ClobClient::delete_api_key() {
 }
 
 std::vector<PostOrderResponse> ClobClient::post_orders(const std::vector<std::pair<SignedOrder, OrderType>>& orders) {
+    CLOB_TRACE_SCOPE("client.post_orders");
     assert_level_2_auth();
     
+    CLOB_TRACE_SPAN(serialize, "order.serialize");
     json orders_array = json::array();
     for (const auto& [order, order_type] : orders) {
         orders_array.push_back(utils::order_to_json(order, creds_->api_key, order_type));
     }
     
     std::string body = orders_array.dump();
+    CLOB_TRACE_END(serialize);
     auto headers = create_l2_headers("POST", endpoints::POST_ORDERS, body);
     
-    auto elem = http_->post_simd(endpoints::POST_ORDERS, orders_array, headers);
-    auto arr = elem.get_array().value();
-    return utils::parse_vector_simd<PostOrderResponse>(arr, utils::parse_post_order_simd);
+    std::vector<PostOrderResponse> responses;
+    try {
+        auto elem = http_->post_simd(endpoints::POST_ORDERS, orders_array, headers);
+        auto arr = elem.get_array().value();
+        responses = utils::parse_vector_simd<PostOrderResponse>(arr, utils::parse_post_order_simd);
+    } catch (...) {
+        metrics::record_orders(orders.size(), 0, orders.size());
+        throw;
+    }
+    // Responses are returned in request order
+    for (size_t i = 0; i < orders.size() && i < responses.size(); ++i) {
+        await_verification(orders[i].first, responses[i]);
+    }
+    record_order_outcomes(responses.data(), responses.size());
+    return responses;
 }
 
 PostOrderResponse ClobClient::create_and_post_order(
     const OrderArgs& args,
     const CreateOrderOptions& options
 ) {
+    CLOB_TRACE_SCOPE("client.create_and_post_order");
     auto order = create_order(args, options);
     return post_order(order);
 }
@@ -782,6 +873,7 @@ Page<UserEarningResponse> ClobClient::get_earnings_for_user_for_day(
     const std::string& date,
     const std::string& next_cursor
 ) {
+    CLOB_TRACE_SCOPE("client.get_earnings_for_user_for_day");
     assert_level_2_auth();
     
     std::string path = "/rewards/user";
@@ -798,6 +890,7 @@ Page<UserEarningResponse> ClobClient::get_earnings_for_user_for_day(
 std::vector<TotalUserEarningResponse> ClobClient::get_total_earnings_for_user_for_day(
     const std::string& date
 ) {
+    CLOB_TRACE_SCOPE("client.get_total_earnings_for_user_for_day");
     assert_level_2_auth();
     
     std::string path = "/rewards/user/total?date=" + date;
@@ -810,6 +903,7 @@ std::vector<TotalUserEarningResponse> ClobClient::get_total_earnings_for_user_fo
 std::vector<UserRewardsEarningResponse> ClobClient::get_user_earnings_and_markets_config(
     const UserRewardsEarningRequest& request
 ) {
+    CLOB_TRACE_SCOPE("client.get_user_earnings_and_markets_config");
     assert_level_2_auth();
     
     std::string path = "/rewards/user/total";
@@ -821,6 +915,7 @@ std::vector<UserRewardsEarningResponse> ClobClient::get_user_earnings_and_market
 }
 
 RewardsPercentagesResponse ClobClient::get_reward_percentages() {
+    CLOB_TRACE_SCOPE("client.get_reward_percentages");
     assert_level_2_auth();
     
     std::string path = "/rewards/user/percentages";
@@ -832,6 +927,7 @@ RewardsPercentagesResponse ClobClient::get_reward_percentages() {
 Page<CurrentRewardResponse> ClobClient::get_current_rewards(
     const std::string& next_cursor
 ) {
+    CLOB_TRACE_SCOPE("client.get_current_rewards");
     assert_level_2_auth();
     
     std::string path = "/rewards/markets/current";
@@ -846,6 +942,7 @@ Page<MarketRewardResponse> ClobClient::get_raw_rewards_for_market(
     const std::string& condition_id,
     const std::string& next_cursor
 ) {
+    CLOB_TRACE_SCOPE("client.get_raw_rewards_for_market");
     assert_level_2_auth();
     
     std::string path = "/rewards/markets/" + condition_id;
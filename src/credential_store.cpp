@@ -0,0 +1,208 @@
+#include "clob/credential_store.hpp"
+#include "clob/hex.hpp"
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace clob {
+
+namespace {
+
+constexpr int FORMAT_VERSION = 1;
+constexpr size_t IV_SIZE = 12;   // GCM standard nonce
+constexpr size_t TAG_SIZE = 16;
+
+// Bound into the tag so a file cannot be replayed as another format version
+const std::string AAD = "clob-credential-store-v1";
+
+using CipherCtx = std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)>;
+
+CipherCtx new_ctx() {
+    CipherCtx ctx(EVP_CIPHER_CTX_new(), &EVP_CIPHER_CTX_free);
+    if (!ctx) {
+        throw std::runtime_error("Failed to allocate cipher context");
+    }
+    return ctx;
+}
+
+std::string lowercase(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+// Create path owner-read/write only, write data, then rename over target
+void write_private_file(const std::string& target, const std::string& data) {
+    std::string tmp = target + ".tmp";
+    // A leftover tmp file would keep its old mode, so start from a fresh one
+    std::remove(tmp.c_str());
+    // Mode is set at creation, so the file is never more permissive than 0600
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot write credential store: " + tmp);
+    }
+    const char* p = data.data();
+    size_t left = data.size();
+    while (left > 0) {
+        ssize_t n = ::write(fd, p, left);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            ::close(fd);
+            std::remove(tmp.c_str());
+            throw std::runtime_error("Cannot write credential store: " + tmp);
+        }
+        p += n;
+        left -= static_cast<size_t>(n);
+    }
+    if (::close(fd) != 0) {
+        std::remove(tmp.c_str());
+        throw std::runtime_error("Cannot write credential store: " + tmp);
+    }
+    if (std::rename(tmp.c_str(), target.c_str()) != 0) {
+        throw std::runtime_error("Cannot replace credential store: " + target);
+    }
+}
+
+} // namespace
+
+CredentialStore::CredentialStore(const std::string& path, const Key& key)
+    : path_(path), key_(key) {}
+
+CredentialStore::Key CredentialStore::load_or_create_key(const std::string& key_path) {
+    std::ifstream in(key_path);
+    if (in) {
+        std::string text;
+        in >> text;
+        return hex::decode_array<32>(text);
+    }
+
+    Key key;
+    if (RAND_bytes(key.data(), static_cast<int>(key.size())) != 1) {
+        throw std::runtime_error("Failed to generate credential store key");
+    }
+    write_private_file(key_path, hex::encode(key, false) + "\n");
+    return key;
+}
+
+std::map<std::string, ApiCreds> CredentialStore::load() const {
+    std::map<std::string, ApiCreds> result;
+
+    std::ifstream in(path_);
+    if (!in) {
+        return result;  // First run
+    }
+
+    // Unlike the gas cache, a bad file is an error: silently re-deriving
+    // would hide tampering or a lost key
+    json envelope;
+    std::vector<uint8_t> iv, tag, ciphertext;
+    try {
+        envelope = json::parse(in);
+        if (envelope.at("version").get<int>() != FORMAT_VERSION) {
+            throw std::runtime_error("unsupported version");
+        }
+        iv = hex::decode(envelope.at("iv").get<std::string>());
+        tag = hex::decode(envelope.at("tag").get<std::string>());
+        ciphertext = hex::decode(envelope.at("data").get<std::string>());
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Malformed credential store " + path_ + ": " + e.what());
+    }
+    if (iv.size() != IV_SIZE || tag.size() != TAG_SIZE) {
+        throw std::runtime_error("Malformed credential store " + path_);
+    }
+
+    auto ctx = new_ctx();
+    std::string plaintext(ciphertext.size(), '\0');
+    int len = 0;
+    int final_len = 0;
+    bool ok =
+        EVP_DecryptInit_ex(ctx.get(), EVP_aes_256_gcm(), nullptr, nullptr, nullptr) == 1 &&
+        EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_IVLEN, IV_SIZE, nullptr) == 1 &&
+        EVP_DecryptInit_ex(ctx.get(), nullptr, nullptr, key_.data(), iv.data()) == 1 &&
+        EVP_DecryptUpdate(ctx.get(), nullptr, &len,
+                          reinterpret_cast<const unsigned char*>(AAD.data()), static_cast<int>(AAD.size())) == 1 &&
+        EVP_DecryptUpdate(ctx.get(), reinterpret_cast<unsigned char*>(plaintext.data()), &len,
+                          ciphertext.data(), static_cast<int>(ciphertext.size())) == 1 &&
+        EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_TAG, TAG_SIZE, tag.data()) == 1 &&
+        EVP_DecryptFinal_ex(ctx.get(), reinterpret_cast<unsigned char*>(plaintext.data()) + len, &final_len) == 1;
+    if (!ok) {
+        throw std::runtime_error("Credential store " + path_ + " failed authentication (wrong key or modified)");
+    }
+    plaintext.resize(static_cast<size_t>(len + final_len));
+
+    json entries = json::parse(plaintext);
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        result[it.key()] = it.value().get<ApiCreds>();
+    }
+    return result;
+}
+
+void CredentialStore::save(const std::map<std::string, ApiCreds>& creds) const {
+    json entries = json::object();
+    for (const auto& [address, c] : creds) {
+        entries[lowercase(address)] = c;
+    }
+    std::string plaintext = entries.dump();
+
+    std::array<uint8_t, IV_SIZE> iv;
+    if (RAND_bytes(iv.data(), static_cast<int>(iv.size())) != 1) {
+        throw std::runtime_error("Failed to generate credential store IV");
+    }
+
+    auto ctx = new_ctx();
+    std::vector<uint8_t> ciphertext(plaintext.size());
+    std::array<uint8_t, TAG_SIZE> tag;
+    int len = 0;
+    int final_len = 0;
+    bool ok =
+        EVP_EncryptInit_ex(ctx.get(), EVP_aes_256_gcm(), nullptr, nullptr, nullptr) == 1 &&
+        EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_IVLEN, IV_SIZE, nullptr) == 1 &&
+        EVP_EncryptInit_ex(ctx.get(), nullptr, nullptr, key_.data(), iv.data()) == 1 &&
+        EVP_EncryptUpdate(ctx.get(), nullptr, &len,
+                          reinterpret_cast<const unsigned char*>(AAD.data()), static_cast<int>(AAD.size())) == 1 &&
+        EVP_EncryptUpdate(ctx.get(), ciphertext.data(), &len,
+                          reinterpret_cast<const unsigned char*>(plaintext.data()), static_cast<int>(plaintext.size())) == 1 &&
+        EVP_EncryptFinal_ex(ctx.get(), ciphertext.data() + len, &final_len) == 1 &&
+        EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_GET_TAG, TAG_SIZE, tag.data()) == 1;
+    if (!ok) {
+        throw std::runtime_error("Failed to encrypt credential store");
+    }
+    ciphertext.resize(static_cast<size_t>(len + final_len));
+
+    json envelope = {
+        {"version", FORMAT_VERSION},
+        {"iv", hex::encode(iv, false)},
+        {"tag", hex::encode(tag, false)},
+        {"data", hex::encode(ciphertext, false)}
+    };
+    write_private_file(path_, envelope.dump());
+}
+
+void CredentialStore::merge(const std::map<std::string, ApiCreds>& creds) const {
+    auto all = load();
+    for (const auto& [address, c] : creds) {
+        all[lowercase(address)] = c;
+    }
+    save(all);
+}
+
+std::optional<ApiCreds> CredentialStore::get(const std::string& address) const {
+    auto all = load();
+    auto it = all.find(lowercase(address));
+    if (it == all.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+} // namespace clob
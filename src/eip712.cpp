@@ -1,10 +1,10 @@
 #include "clob/eip712.hpp"
 #include "clob/keccak.hpp"
-#include <iomanip>
-#include <sstream>
+#include "clob/hex.hpp"
 #include <stdexcept>
 #include <algorithm>
 #include <cstring>
+#include <unordered_map>
 
 namespace clob {
 namespace eip712 {
@@ -15,31 +15,11 @@ std::array<uint8_t, 32> keccak256(const std::vector<uint8_t>& data) {
 }
 
 std::vector<uint8_t> hex_to_bytes(const std::string& hex) {
-    std::string clean_hex = hex;
-    if (clean_hex.substr(0, 2) == "0x" || clean_hex.substr(0, 2) == "0X") {
-        clean_hex = clean_hex.substr(2);
-    }
-    
-    std::vector<uint8_t> bytes;
-    for (size_t i = 0; i < clean_hex.length(); i += 2) {
-        std::string byte_str = clean_hex.substr(i, 2);
-        uint8_t byte = static_cast<uint8_t>(std::stoi(byte_str, nullptr, 16));
-        bytes.push_back(byte);
-    }
-    
-    return bytes;
+    return hex::decode(hex);
 }
 
 std::string bytes_to_hex(const std::vector<uint8_t>& bytes, bool with_prefix) {
-    std::ostringstream oss;
-    if (with_prefix) {
-        oss << "0x";
-    }
-    oss << std::hex << std::setfill('0');
-    for (uint8_t byte : bytes) {
-        oss << std::setw(2) << static_cast<int>(byte);
-    }
-    return oss.str();
+    return hex::encode(bytes, with_prefix);
 }
 
 std::array<uint8_t, 32> encode_uint256(uint64_t value) {
@@ -50,68 +30,96 @@ std::array<uint8_t, 32> encode_uint256(uint64_t value) {
     return result;
 }
 
-std::array<uint8_t, 32> encode_uint256(const std::string& value) {
-    // Handle large 256-bit numbers that don't fit in uint64_t
-    // Parse as big integer using hex if needed
+bool parse_uint256(std::string_view decimal, std::array<uint8_t, 32>& out) {
+    if (decimal.empty() || decimal.size() > 78) {
+        return false;  // 2^256 - 1 has 78 digits
+    }
     
-    std::array<uint8_t, 32> result{};
+    static constexpr uint64_t POW10[20] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+        100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL,
+        1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+        1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+        1000000000000000000ULL, 10000000000000000000ULL
+    };
     
-    // Try to parse as uint64_t first (for small numbers)
-    try {
-        uint64_t num = std::stoull(value);
-        return encode_uint256(num);
-    } catch (...) {
-        // Number too large for uint64_t, parse as big integer
-        // Convert decimal string to bytes manually
-        
-        // Simple approach: convert to hex first, then to bytes
-        // For very large numbers, we'll use a basic big integer conversion
-        
-        std::string decimal_str = value;
-        std::vector<uint8_t> bytes;
-        
-        // Convert decimal string to bytes (big-endian)
-        while (decimal_str != "0" && !decimal_str.empty()) {
-            // Divide by 256 and get remainder
-            uint64_t remainder = 0;
-            std::string quotient;
-            
-            for (char c : decimal_str) {
-                uint64_t digit = c - '0';
-                uint64_t current = remainder * 10 + digit;
-                if (!quotient.empty() || current >= 256) {
-                    quotient += char('0' + (current / 256));
-                }
-                remainder = current % 256;
+    // Four little-endian 64-bit limbs; up to 19 digits fit in one uint64_t,
+    // so each chunk is one multiply-accumulate pass: limbs = limbs * 10^k + chunk
+    uint64_t limbs[4] = {0, 0, 0, 0};
+    size_t pos = 0;
+    size_t first = decimal.size() % 19;
+    if (first == 0) first = 19;
+    
+    while (pos < decimal.size()) {
+        size_t len = pos == 0 ? first : 19;
+        uint64_t chunk = 0;
+        for (size_t i = pos; i < pos + len; ++i) {
+            unsigned digit = static_cast<unsigned char>(decimal[i]) - '0';
+            if (digit > 9) {
+                return false;
             }
-            
-            bytes.insert(bytes.begin(), static_cast<uint8_t>(remainder));
-            decimal_str = quotient.empty() ? "0" : quotient;
+            chunk = chunk * 10 + digit;
         }
+        pos += len;
         
-        // Pad to 32 bytes
-        if (bytes.size() > 32) {
-            throw std::runtime_error("Number too large for uint256");
+        unsigned __int128 carry = chunk;
+        for (auto& limb : limbs) {
+            unsigned __int128 acc = static_cast<unsigned __int128>(limb) * POW10[len] + carry;
+            limb = static_cast<uint64_t>(acc);
+            carry = acc >> 64;
+        }
+        if (carry != 0) {
+            return false;  // overflow past 256 bits
         }
-        
-        // Copy to result (right-aligned, big-endian)
-        size_t offset = 32 - bytes.size();
-        std::copy(bytes.begin(), bytes.end(), result.begin() + offset);
-        
-        return result;
     }
+    
+    for (int limb = 0; limb < 4; ++limb) {
+        for (int i = 0; i < 8; ++i) {
+            out[31 - limb * 8 - i] = static_cast<uint8_t>(limbs[limb] >> (i * 8));
+        }
+    }
+    return true;
+}
+
+std::array<uint8_t, 32> encode_uint256(const std::string& value) {
+    std::array<uint8_t, 32> result{};
+    if (!parse_uint256(value, result)) {
+        throw std::runtime_error("Invalid uint256: " + value);
+    }
+    return result;
+}
+
+std::array<uint8_t, 32> encode_token_id(const std::string& token_id) {
+    // Per-thread, so the order hash path takes no lock; the bound keeps a
+    // long-running process scanning many markets from growing without limit
+    static constexpr size_t MAX_CACHED_TOKENS = 4096;
+    thread_local std::unordered_map<std::string, std::array<uint8_t, 32>> cache;
+    
+    auto it = cache.find(token_id);
+    if (it != cache.end()) {
+        return it->second;
+    }
+    
+    auto encoded = encode_uint256(token_id);
+    if (cache.size() >= MAX_CACHED_TOKENS) {
+        cache.clear();
+    }
+    cache.emplace(token_id, encoded);
+    return encoded;
 }
 
 std::array<uint8_t, 32> encode_address(const std::string& address) {
     std::array<uint8_t, 32> result{};
-    auto bytes = hex_to_bytes(address);
+    auto digits = hex::strip_prefix(address);
     
-    if (bytes.size() != 20) {
+    if (digits.size() != 40) {
         throw std::runtime_error("Invalid address length");
     }
     
-    // Addresses are left-padded to 32 bytes
-    std::copy(bytes.begin(), bytes.end(), result.begin() + 12);
+    // Addresses are left-padded to 32 bytes; decode straight into place
+    if (!hex::decode_to(digits, result.data() + 12)) {
+        throw std::runtime_error("Invalid address: " + address);
+    }
     return result;
 }
 
@@ -156,7 +164,9 @@ std::vector<uint8_t> encode_value(const std::string& type, const json& value, co
         if (value.is_number()) {
             encoded = encode_uint256(value.get<uint64_t>());
         } else {
-            encoded = encode_uint256(value.get<std::string>());
+            // Values beyond 19 digits are token ids; reuse their encoding
+            const auto& str = value.get_ref<const std::string&>();
+            encoded = str.size() > 19 ? encode_token_id(str) : encode_uint256(str);
         }
         result.insert(result.end(), encoded.begin(), encoded.end());
     }
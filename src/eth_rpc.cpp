@@ -1,50 +1,23 @@
 #include "clob/eth_rpc.hpp"
 #include "clob/signer.hpp"
 #include "clob/eip712.hpp"
-#include <httplib.h>
+#include "clob/keccak.hpp"
+#include "clob/hex.hpp"
 #include <thread>
+#include <cstring>
 #include <chrono>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <cctype>
+#include <iterator>
 #include <stdexcept>
+#include <fstream>
+#include <cstdio>
+#include <cmath>
 
 namespace clob {
 
-// Helper to convert hex string to bytes
-// Handles "0x0" and "0x00" as empty (for RLP zero encoding)
-static std::vector<uint8_t> hex_to_bytes(const std::string& hex, bool strip_leading_zeros = false) {
-    std::string h = hex;
-    if (h.substr(0, 2) == "0x") h = h.substr(2);
-    
-    // Handle odd-length hex strings
-    if (h.length() % 2 == 1) h = "0" + h;
-    
-    // For RLP, "0" or "00" should become empty bytes
-    if (strip_leading_zeros) {
-        while (h.length() >= 2 && h.substr(0, 2) == "00") {
-            h = h.substr(2);
-        }
-        if (h.empty() || h == "0") return {};
-    }
-    
-    std::vector<uint8_t> bytes;
-    for (size_t i = 0; i < h.length(); i += 2) {
-        bytes.push_back(static_cast<uint8_t>(std::stoul(h.substr(i, 2), nullptr, 16)));
-    }
-    return bytes;
-}
-
-// Helper to convert bytes to hex string
-static std::string bytes_to_hex(const std::vector<uint8_t>& bytes, bool prefix = true) {
-    std::ostringstream oss;
-    if (prefix) oss << "0x";
-    for (uint8_t b : bytes) {
-        oss << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(b);
-    }
-    return oss.str();
-}
-
 // Helper to pad address to 32 bytes
 static std::string pad_address(const std::string& addr) {
     std::string a = addr;
@@ -60,6 +33,50 @@ static std::string pad_uint256(const std::string& hex_value) {
     return std::string(64 - v.length(), '0') + v;
 }
 
+// Helper to encode a small integer as a 32-byte ABI word (64 hex chars)
+static std::string encode_word(uint64_t value) {
+    std::array<uint8_t, 32> word{};
+    for (int i = 0; i < 8; ++i) {
+        word[31 - i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+    return hex::encode(word, false);
+}
+
+// Helper to read a 32-byte ABI word at a byte offset as uint64
+// (hex has no 0x prefix; offsets and lengths always fit in 64 bits)
+static uint64_t read_word(const std::string& hex, size_t byte_offset) {
+    size_t pos = byte_offset * 2;
+    if (pos + 64 > hex.length()) {
+        throw std::runtime_error("ABI decode out of bounds");
+    }
+    if (hex.find_first_not_of('0', pos) < pos + 48) {
+        throw std::runtime_error("ABI word does not fit in 64 bits");
+    }
+    return std::stoull(hex.substr(pos + 48, 16), nullptr, 16);
+}
+
+// Helper to parse a JSON-RPC quantity ("0x1a2b"); false if the value is not a
+// non-empty hex string that fits in 64 bits
+static bool parse_quantity(const json& value, uint64_t& out) {
+    if (!value.is_string()) {
+        return false;
+    }
+    std::string_view digits = hex::strip_prefix(value.get_ref<const std::string&>());
+    if (digits.empty()) {
+        return false;
+    }
+    uint64_t result = 0;
+    for (char c : digits) {
+        int v = hex::digit_value(c);
+        if (v < 0 || (result >> 60) != 0) {
+            return false;
+        }
+        result = (result << 4) | static_cast<uint64_t>(v);
+    }
+    out = result;
+    return true;
+}
+
 // ==================== RLP Encoding ====================
 
 namespace rlp {
@@ -127,6 +144,133 @@ std::vector<uint8_t> encode_integer(uint64_t value) {
     return encode_string(bytes);
 }
 
+// ---------- Streaming encoder ----------
+
+static size_t byte_length(uint64_t value) {
+    size_t n = 0;
+    while (value > 0) {
+        n++;
+        value >>= 8;
+    }
+    return n;
+}
+
+static size_t prefix_size(size_t len) {
+    return len < 56 ? 1 : 1 + byte_length(len);
+}
+
+static int hex_nibble(char c) {
+    int v = hex::digit_value(c);
+    if (v < 0) {
+        throw std::runtime_error(std::string("Invalid hex character: ") + c);
+    }
+    return v;
+}
+
+// Hex digits of a field without the 0x prefix (and, for numeric fields,
+// without leading zeros)
+static std::string_view hex_digits(std::string_view hex, bool numeric) {
+    hex = hex::strip_prefix(hex);
+    if (numeric) {
+        size_t first = hex.find_first_not_of('0');
+        hex.remove_prefix(first == std::string_view::npos ? hex.size() : first);
+    }
+    return hex;
+}
+
+size_t string_size(const uint8_t* data, size_t len) {
+    if (len == 1 && data[0] < 0x80) return 1;
+    return prefix_size(len) + len;
+}
+
+size_t integer_size(uint64_t value) {
+    if (value < 0x80) return 1;  // zero encodes as 0x80, small values as themselves
+    return 1 + byte_length(value);
+}
+
+size_t list_header_size(size_t payload_len) {
+    return prefix_size(payload_len);
+}
+
+size_t hex_size(std::string_view hex, bool numeric) {
+    auto digits = hex_digits(hex, numeric);
+    size_t len = (digits.size() + 1) / 2;
+    if (len == 1) {
+        // Odd-length input means the first byte is a single nibble
+        int first = digits.size() == 1 ? hex_nibble(digits[0])
+                                       : (hex_nibble(digits[0]) << 4) | hex_nibble(digits[1]);
+        if (first < 0x80) return 1;
+    }
+    return prefix_size(len) + len;
+}
+
+void Writer::length_prefix(uint8_t short_base, uint8_t long_base, size_t len) {
+    if (len < 56) {
+        out_[pos_++] = static_cast<uint8_t>(short_base + len);
+        return;
+    }
+    size_t n = byte_length(len);
+    out_[pos_++] = static_cast<uint8_t>(long_base + n);
+    for (size_t i = n; i > 0; --i) {
+        out_[pos_++] = static_cast<uint8_t>(len >> (8 * (i - 1)));
+    }
+}
+
+void Writer::list_header(size_t payload_len) {
+    length_prefix(0xc0, 0xf7, payload_len);
+}
+
+void Writer::string(const uint8_t* data, size_t len) {
+    if (len == 1 && data[0] < 0x80) {
+        out_[pos_++] = data[0];
+        return;
+    }
+    length_prefix(0x80, 0xb7, len);
+    if (len > 0) {
+        std::memcpy(out_ + pos_, data, len);
+        pos_ += len;
+    }
+}
+
+void Writer::integer(uint64_t value) {
+    uint8_t bytes[8];
+    size_t n = byte_length(value);
+    for (size_t i = 0; i < n; ++i) {
+        bytes[i] = static_cast<uint8_t>(value >> (8 * (n - 1 - i)));
+    }
+    string(bytes, n);
+}
+
+void Writer::hex(std::string_view hex, bool numeric) {
+    auto digits = hex_digits(hex, numeric);
+    size_t len = (digits.size() + 1) / 2;
+    size_t i = 0;
+    
+    // Leading nibble of an odd-length field becomes its own byte
+    uint8_t first = 0;
+    if (len > 0) {
+        if (digits.size() % 2 == 1) {
+            first = static_cast<uint8_t>(hex_nibble(digits[0]));
+            i = 1;
+        } else {
+            first = static_cast<uint8_t>((hex_nibble(digits[0]) << 4) | hex_nibble(digits[1]));
+            i = 2;
+        }
+    }
+    
+    if (len == 1 && first < 0x80) {
+        out_[pos_++] = first;
+        return;
+    }
+    
+    length_prefix(0x80, 0xb7, len);
+    if (len == 0) return;
+    out_[pos_++] = first;
+    for (; i < digits.size(); i += 2) {
+        out_[pos_++] = static_cast<uint8_t>((hex_nibble(digits[i]) << 4) | hex_nibble(digits[i + 1]));
+    }
+}
+
 } // namespace rlp
 
 // ==================== ABI Encoding ====================
@@ -153,11 +297,117 @@ std::string encode_is_approved_for_all(const std::string& account, const std::st
     return "0xe985e9c5" + pad_address(account) + pad_address(operator_addr);
 }
 
+std::string encode_aggregate3(const std::vector<Call>& calls) {
+    // aggregate3((address,bool,bytes)[]) = 0x82ad56cb
+    // Each Call3 tuple is dynamic (contains bytes), so the array body is
+    // N offsets followed by the N tuple encodings.
+    std::vector<std::string> tuples;
+    tuples.reserve(calls.size());
+    
+    for (const auto& call : calls) {
+        std::string data = call.call_data;
+        if (data.substr(0, 2) == "0x") data = data.substr(2);
+        size_t data_len = data.length() / 2;
+        data.append((64 - data.length() % 64) % 64, '0');  // right-pad to 32 bytes
+        
+        tuples.push_back(
+            pad_address(call.target) +
+            encode_word(call.allow_failure ? 1 : 0) +
+            encode_word(0x60) +                             // offset of bytes within tuple
+            encode_word(data_len) +
+            data
+        );
+    }
+    
+    std::string result = "0x82ad56cb";
+    result += encode_word(0x20);           // offset of the array
+    result += encode_word(calls.size());   // array length
+    
+    size_t offset = 32 * calls.size();
+    for (const auto& tuple : tuples) {
+        result += encode_word(offset);
+        offset += tuple.length() / 2;
+    }
+    for (const auto& tuple : tuples) {
+        result += tuple;
+    }
+    
+    return result;
+}
+
+std::vector<CallResult> decode_aggregate3(const std::string& result_hex) {
+    std::string hex = result_hex;
+    if (hex.substr(0, 2) == "0x") hex = hex.substr(2);
+    
+    // Layout: offset(array) | length | N tuple offsets | tuples
+    // Tuple: success | offset(bytes) | bytes length | bytes data
+    size_t array_start = read_word(hex, 0);
+    size_t count = read_word(hex, array_start);
+    size_t body_start = array_start + 32;
+    
+    std::vector<CallResult> results;
+    results.reserve(count);
+    
+    for (size_t i = 0; i < count; ++i) {
+        size_t tuple_start = body_start + read_word(hex, body_start + 32 * i);
+        
+        CallResult result;
+        result.success = read_word(hex, tuple_start) != 0;
+        
+        size_t bytes_start = tuple_start + read_word(hex, tuple_start + 32);
+        size_t bytes_len = read_word(hex, bytes_start);
+        size_t data_pos = (bytes_start + 32) * 2;
+        if (data_pos + bytes_len * 2 > hex.length()) {
+            throw std::runtime_error("ABI decode out of bounds");
+        }
+        result.return_data = "0x" + hex.substr(data_pos, bytes_len * 2);
+        
+        results.push_back(std::move(result));
+    }
+    
+    return results;
+}
+
+bool is_nonzero_word(const std::string& return_data) {
+    std::string hex = return_data;
+    if (hex.substr(0, 2) == "0x") hex = hex.substr(2);
+    return hex.find_first_not_of('0') != std::string::npos;
+}
+
+std::string encode_balance_of(const std::string& account) {
+    // balanceOf(address) = 0x70a08231
+    return "0x70a08231" + pad_address(account);
+}
+
+std::string encode_erc1155_balance_of(const std::string& account, const std::string& token_id) {
+    // balanceOf(address,uint256) = 0x00fdd58e
+    auto id = eip712::encode_uint256(token_id);
+    return "0x00fdd58e" + pad_address(account) + hex::encode(id, false);
+}
+
+uint64_t decode_uint64(const std::string& return_data) {
+    std::string hex = return_data;
+    if (hex.substr(0, 2) == "0x") hex = hex.substr(2);
+    return read_word(hex, 0);
+}
+
 } // namespace abi
 
 // ==================== EthRpcClient ====================
 
-EthRpcClient::EthRpcClient(const std::string& rpc_url) : rpc_url_(rpc_url) {}
+EthRpcClient::EthRpcClient(const std::string& rpc_url) : rpc_url_(rpc_url) {
+    // Split the path off the URL; HttpClient only needs scheme://host:port
+    size_t scheme_pos = rpc_url_.find("://");
+    size_t host_start = (scheme_pos != std::string::npos) ? scheme_pos + 3 : 0;
+    size_t path_pos = rpc_url_.find('/', host_start);
+    rpc_path_ = (path_pos != std::string::npos) ? rpc_url_.substr(path_pos) : "/";
+    
+    http_ = std::make_unique<HttpClient>(rpc_url_);
+    // Provider URLs often embed an API key in the path (/v2/<key>)
+    http_->set_request_metrics(RequestMetrics::Redacted);
+}
+
+EthRpcClient::~EthRpcClient() = default;
 
 json EthRpcClient::rpc_call(const std::string& method, const json& params) {
     json request = {
@@ -167,42 +417,115 @@ json EthRpcClient::rpc_call(const std::string& method, const json& params) {
         {"id", request_id_++}
     };
     
-    // Parse URL
-    std::string host, path;
-    int port = 443;
+    json response;
+    try {
+        response = http_->post(rpc_path_, request);
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string("RPC request failed: ") + e.what());
+    }
     
-    if (rpc_url_.find("https://") == 0) {
-        std::string rest = rpc_url_.substr(8);
-        size_t slash = rest.find('/');
-        if (slash != std::string::npos) {
-            host = rest.substr(0, slash);
-            path = rest.substr(slash);
-        } else {
-            host = rest;
-            path = "/";
-        }
+    if (response.contains("error")) {
+        throw std::runtime_error("RPC error: " + response["error"].dump());
+    }
+    
+    return response["result"];
+}
+
+std::vector<RpcResponse> EthRpcClient::batch_call(const std::vector<RpcRequest>& requests) {
+    if (requests.empty()) {
+        return {};
     }
     
-    httplib::SSLClient cli(host, port);
-    cli.set_connection_timeout(30);
-    cli.set_read_timeout(30);
+    // Reserve a contiguous block of ids so responses can be matched back
+    int base_id = request_id_.fetch_add(static_cast<int>(requests.size()));
     
-    auto res = cli.Post(path.c_str(), request.dump(), "application/json");
+    json batch = json::array();
+    for (size_t i = 0; i < requests.size(); ++i) {
+        batch.push_back({
+            {"jsonrpc", "2.0"},
+            {"method", requests[i].method},
+            {"params", requests[i].params},
+            {"id", base_id + static_cast<int>(i)}
+        });
+    }
     
-    if (!res) {
-        throw std::runtime_error("RPC request failed");
+    json response;
+    try {
+        response = http_->post(rpc_path_, batch);
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string("RPC request failed: ") + e.what());
     }
     
-    if (res->status != 200) {
-        throw std::runtime_error("RPC error: " + res->body);
+    // A batch-level failure comes back as a single error object
+    if (!response.is_array()) {
+        if (response.contains("error")) {
+            throw std::runtime_error("RPC error: " + response["error"].dump());
+        }
+        throw std::runtime_error("RPC error: unexpected batch response");
     }
     
-    json response = json::parse(res->body);
-    if (response.contains("error")) {
-        throw std::runtime_error("RPC error: " + response["error"].dump());
+    // Responses may arrive in any order
+    std::vector<RpcResponse> results(requests.size());
+    std::vector<bool> seen(requests.size(), false);
+    for (const auto& item : response) {
+        if (!item.contains("id") || !item["id"].is_number_integer()) continue;
+        int64_t index = item["id"].get<int64_t>() - base_id;
+        if (index < 0 || index >= static_cast<int64_t>(requests.size())) continue;
+        
+        auto& slot = results[index];
+        if (item.contains("error")) {
+            slot.error = item["error"].dump();
+        } else {
+            slot.result = item.contains("result") ? item["result"] : json();
+        }
+        seen[index] = true;
     }
     
-    return response["result"];
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (!seen[i]) {
+            results[i].error = "missing response";
+        }
+    }
+    
+    return results;
+}
+
+std::vector<abi::CallResult> EthRpcClient::multicall(
+    const std::vector<abi::Call>& calls,
+    const std::string& block
+) {
+    if (calls.empty()) {
+        return {};
+    }
+    
+    json params = {
+        {{"to", polygon_contracts::MULTICALL3}, {"data", abi::encode_aggregate3(calls)}},
+        block
+    };
+    std::string result = rpc_call("eth_call", params).get<std::string>();
+    
+    auto results = abi::decode_aggregate3(result);
+    if (results.size() != calls.size()) {
+        throw std::runtime_error("Multicall returned " + std::to_string(results.size()) +
+                                 " results for " + std::to_string(calls.size()) + " calls");
+    }
+    return results;
+}
+
+bool EthRpcClient::warm_connection() {
+    try {
+        rpc_call("eth_chainId", json::array());
+        connection_warm_.store(true);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+ConnectionStats EthRpcClient::get_stats() const {
+    ConnectionStats stats = http_->get_stats();
+    stats.connection_warm = connection_warm_.load();
+    return stats;
 }
 
 uint64_t EthRpcClient::get_nonce(const std::string& address) {
@@ -214,6 +537,27 @@ std::string EthRpcClient::get_gas_price() {
     return rpc_call("eth_gasPrice", json::array()).get<std::string>();
 }
 
+uint64_t EthRpcClient::estimate_gas(
+    const std::string& from,
+    const std::string& to,
+    const std::string& data,
+    const std::string& value
+) {
+    json tx = {{"from", from}, {"to", to}, {"data", data}, {"value", value}};
+    auto result = rpc_call("eth_estimateGas", {tx});
+    return std::stoull(result.get<std::string>(), nullptr, 16);
+}
+
+json EthRpcClient::get_fee_history(
+    uint64_t block_count,
+    const std::vector<double>& reward_percentiles,
+    const std::string& newest_block
+) {
+    std::stringstream ss;
+    ss << "0x" << std::hex << block_count;
+    return rpc_call("eth_feeHistory", {ss.str(), newest_block, reward_percentiles});
+}
+
 uint64_t EthRpcClient::get_chain_id() {
     auto result = rpc_call("eth_chainId", json::array());
     return std::stoull(result.get<std::string>(), nullptr, 16);
@@ -224,7 +568,11 @@ std::string EthRpcClient::send_raw_transaction(const std::string& signed_tx_hex)
 }
 
 json EthRpcClient::wait_for_receipt(const std::string& tx_hash, int timeout_seconds) {
-    auto start = std::chrono::steady_clock::now();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout_seconds);
+    
+    // Start polling quickly and back off towards the block time
+    auto interval = std::chrono::milliseconds(200);
+    const auto max_interval = std::chrono::milliseconds(2000);
     
     while (true) {
         try {
@@ -236,15 +584,14 @@ json EthRpcClient::wait_for_receipt(const std::string& tx_hash, int timeout_seco
             // Receipt not available yet
         }
         
-        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::steady_clock::now() - start
-        ).count();
-        
-        if (elapsed >= timeout_seconds) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
             throw std::runtime_error("Timeout waiting for transaction receipt");
         }
         
-        std::this_thread::sleep_for(std::chrono::seconds(2));
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+        std::this_thread::sleep_for(std::min(interval, remaining));
+        interval = std::min(interval * 3 / 2, max_interval);
     }
 }
 
@@ -268,65 +615,914 @@ bool EthRpcClient::is_approved_for_all(const std::string& token, const std::stri
 
 // ==================== Transaction ====================
 
+// Both transaction kinds are encoded into one buffer laid out as
+// [header slack | fields | tail]. The leading fields are encoded once; only
+// the tail (unsigned suffix or signature) and the list header differ between
+// the signing payload and the signed transaction.
+namespace {
+
+constexpr size_t HEADER_SLACK = 1 + 9;  // Type byte + longest list header
+constexpr size_t MAX_SIGNATURE_TAIL = 9 + 33 + 33;  // v, r, s
+
+size_t transaction_fields_size(const Transaction& tx) {
+    return rlp::integer_size(tx.nonce) +
+           rlp::hex_size(tx.gas_price, true) +
+           rlp::integer_size(tx.gas_limit) +
+           rlp::hex_size(tx.to, false) +
+           rlp::hex_size(tx.value, true) +
+           rlp::hex_size(tx.data, false);
+}
+
+void write_transaction_fields(const Transaction& tx, rlp::Writer& w) {
+    w.integer(tx.nonce);
+    w.hex(tx.gas_price, true);
+    w.integer(tx.gas_limit);
+    w.hex(tx.to, false);
+    w.hex(tx.value, true);  // strip leading zeros for RLP
+    w.hex(tx.data, false);
+}
+
+constexpr uint8_t EIP1559_TX_TYPE = 0x02;
+constexpr uint8_t EMPTY_LIST = 0xc0;
+
+size_t transaction_fields_size(const Eip1559Transaction& tx) {
+    return rlp::integer_size(tx.chain_id) +
+           rlp::integer_size(tx.nonce) +
+           rlp::integer_size(tx.max_priority_fee_per_gas) +
+           rlp::integer_size(tx.max_fee_per_gas) +
+           rlp::integer_size(tx.gas_limit) +
+           rlp::hex_size(tx.to, false) +
+           rlp::hex_size(tx.value, true) +
+           rlp::hex_size(tx.data, false) +
+           1;  // empty access list
+}
+
+void write_transaction_fields(const Eip1559Transaction& tx, uint8_t* out) {
+    rlp::Writer w(out);
+    w.integer(tx.chain_id);
+    w.integer(tx.nonce);
+    w.integer(tx.max_priority_fee_per_gas);
+    w.integer(tx.max_fee_per_gas);
+    w.integer(tx.gas_limit);
+    w.hex(tx.to, false);
+    w.hex(tx.value, true);
+    w.hex(tx.data, false);
+    out[w.size()] = EMPTY_LIST;
+}
+
+void write_transaction_fields(const Transaction& tx, uint8_t* out) {
+    rlp::Writer w(out);
+    write_transaction_fields(tx, w);
+}
+
+// RLP integers are minimal: drop leading zero bytes of r and s
+std::pair<const uint8_t*, size_t> strip_zeros(const std::vector<uint8_t>& bytes) {
+    size_t i = 0;
+    while (i < bytes.size() && bytes[i] == 0) i++;
+    return {bytes.data() + i, bytes.size() - i};
+}
+
+// Write [v, r, s] at out and return its encoded size
+size_t write_signature(uint8_t* out, uint64_t v, const Signer::SignatureComponents& sig) {
+    auto [r, r_len] = strip_zeros(sig.r);
+    auto [s, s_len] = strip_zeros(sig.s);
+    rlp::Writer w(out);
+    w.integer(v);
+    w.string(r, r_len);
+    w.string(s, s_len);
+    return w.size();
+}
+
+// Write the list header right-aligned in front of the fields, plus the
+// type byte for typed transactions, and return the start offset
+size_t write_envelope(uint8_t* buf, size_t payload_len, std::optional<uint8_t> type) {
+    size_t start = HEADER_SLACK - rlp::list_header_size(payload_len);
+    rlp::Writer header(buf + start);
+    header.list_header(payload_len);
+    if (type) {
+        buf[--start] = *type;
+    }
+    return start;
+}
+
+// Encode [fields..., chainId, 0, 0] into buf and hash it
+std::array<uint8_t, 32> hash_unsigned(const Transaction& tx, uint8_t* buf, size_t fields_size) {
+    rlp::Writer tail(buf + HEADER_SLACK + fields_size);
+    tail.integer(tx.chain_id);
+    tail.string(nullptr, 0);  // empty for EIP-155
+    tail.string(nullptr, 0);  // empty for EIP-155
+    
+    size_t payload_len = fields_size + tail.size();
+    size_t start = write_envelope(buf, payload_len, std::nullopt);
+    return keccak::hash256(buf + start, HEADER_SLACK - start + payload_len);
+}
+
+// Hash 0x02 || rlp([fields...]); the unsigned payload has no tail
+std::array<uint8_t, 32> hash_unsigned(const Eip1559Transaction&, uint8_t* buf, size_t fields_size) {
+    size_t start = write_envelope(buf, fields_size, EIP1559_TX_TYPE);
+    return keccak::hash256(buf + start, HEADER_SLACK - start + fields_size);
+}
+
+} // namespace
+
+std::array<uint8_t, 32> Transaction::signing_hash() const {
+    size_t fields_size = transaction_fields_size(*this);
+    std::vector<uint8_t> buf(HEADER_SLACK + fields_size + MAX_SIGNATURE_TAIL);
+    
+    write_transaction_fields(*this, buf.data() + HEADER_SLACK);
+    return hash_unsigned(*this, buf.data(), fields_size);
+}
+
 std::string Transaction::sign(const std::string& private_key) const {
-    using namespace rlp;
-    
-    // EIP-155 transaction structure for signing:
-    // [nonce, gasPrice, gasLimit, to, value, data, chainId, 0, 0]
-    
-    auto gas_price_bytes = hex_to_bytes(gas_price);
-    auto to_bytes = hex_to_bytes(to);
-    auto value_bytes = hex_to_bytes(value, true);  // strip leading zeros for RLP
-    auto data_bytes = hex_to_bytes(data);
-    
-    std::vector<std::vector<uint8_t>> tx_items = {
-        encode_integer(nonce),
-        encode_string(gas_price_bytes),
-        encode_integer(gas_limit),
-        encode_string(to_bytes),
-        encode_string(value_bytes),
-        encode_string(data_bytes),
-        encode_integer(chain_id),
-        encode_string({}),  // empty for EIP-155
-        encode_string({})   // empty for EIP-155
-    };
+    Signer signer(private_key, chain_id);
+    return sign(signer);
+}
+
+std::string Transaction::sign(const Signer& signer) const {
+    // One buffer sized up front
+    size_t fields_size = transaction_fields_size(*this);
+    std::vector<uint8_t> buf(HEADER_SLACK + fields_size + MAX_SIGNATURE_TAIL);
+    
+    write_transaction_fields(*this, buf.data() + HEADER_SLACK);
     
-    auto unsigned_tx = encode_list(tx_items);
+    // Keccak-256 hash of unsigned transaction, signed with secp256k1
+    auto hash = hash_unsigned(*this, buf.data(), fields_size);
+    auto sig = signer.sign_hash(hash);
     
-    // Keccak-256 hash of unsigned transaction
-    auto hash_arr = eip712::keccak256(unsigned_tx);
-    std::vector<uint8_t> hash_vec(hash_arr.begin(), hash_arr.end());
+    // Adjust v for EIP-155, then overwrite the tail: [fields..., v, r, s]
+    uint64_t v_adjusted = sig.v + chain_id * 2 + 35;
+    size_t payload_len = fields_size + write_signature(buf.data() + HEADER_SLACK + fields_size, v_adjusted, sig);
+    
+    size_t start = write_envelope(buf.data(), payload_len, std::nullopt);
+    return hex::encode(buf.data() + start, HEADER_SLACK - start + payload_len);
+}
+
+std::array<uint8_t, 32> Eip1559Transaction::signing_hash() const {
+    size_t fields_size = transaction_fields_size(*this);
+    std::vector<uint8_t> buf(HEADER_SLACK + fields_size);
     
-    // Sign with secp256k1
+    write_transaction_fields(*this, buf.data() + HEADER_SLACK);
+    return hash_unsigned(*this, buf.data(), fields_size);
+}
+
+std::string Eip1559Transaction::sign(const std::string& private_key) const {
     Signer signer(private_key, chain_id);
-    auto sig = signer.sign_hash(hash_vec);
+    return sign(signer);
+}
+
+std::string Eip1559Transaction::sign(const Signer& signer) const {
+    size_t fields_size = transaction_fields_size(*this);
+    std::vector<uint8_t> buf(HEADER_SLACK + fields_size + MAX_SIGNATURE_TAIL);
     
-    // Adjust v for EIP-155
-    uint64_t v_adjusted = sig.v + chain_id * 2 + 35;
+    write_transaction_fields(*this, buf.data() + HEADER_SLACK);
+    
+    auto hash = hash_unsigned(*this, buf.data(), fields_size);
+    auto sig = signer.sign_hash(hash);
+    
+    // Typed transactions carry the bare recovery id (yParity) as v
+    size_t payload_len = fields_size + write_signature(buf.data() + HEADER_SLACK + fields_size, sig.v, sig);
+    
+    size_t start = write_envelope(buf.data(), payload_len, EIP1559_TX_TYPE);
+    return hex::encode(buf.data() + start, HEADER_SLACK - start + payload_len);
+}
+
+// ==================== FeeOracle ====================
+
+FeeOracle::FeeOracle(EthRpcClient& rpc) : FeeOracle(rpc, Options{}) {}
+
+FeeOracle::FeeOracle(EthRpcClient& rpc, Options options)
+    : rpc_(rpc), options_(options) {}
+
+FeeOracle::Fees FeeOracle::get() {
+    // Held across the fetch so concurrent callers share one round trip
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+    if (!cached_ || now - fetched_at_ >= options_.ttl) {
+        cached_ = fetch();
+        fetched_at_ = now;
+    }
+    return *cached_;
+}
+
+FeeOracle::Fees FeeOracle::refresh() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cached_ = fetch();
+    fetched_at_ = std::chrono::steady_clock::now();
+    return *cached_;
+}
+
+void FeeOracle::invalidate() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cached_.reset();
+}
+
+FeeOracle::Fees FeeOracle::fetch() {
+    auto history = rpc_.get_fee_history(options_.block_count, {options_.reward_percentile});
+    
+    // baseFeePerGas has block_count + 1 entries; the last is the pending block
+    const auto& base_fees = history.at("baseFeePerGas");
+    if (!base_fees.is_array() || base_fees.empty()) {
+        throw std::runtime_error("eth_feeHistory returned no base fees");
+    }
+    
+    Fees fees;
+    if (!parse_quantity(base_fees.back(), fees.base_fee)) {
+        throw std::runtime_error("eth_feeHistory returned a malformed base fee");
+    }
+    
+    // Median of the per-block rewards at the requested percentile; malformed
+    // entries are skipped
+    std::vector<uint64_t> rewards;
+    if (history.contains("reward")) {
+        for (const auto& block : history["reward"]) {
+            uint64_t reward = 0;
+            if (block.is_array() && !block.empty() && parse_quantity(block[0], reward)) {
+                rewards.push_back(reward);
+            }
+        }
+    }
+    uint64_t priority = 0;
+    if (!rewards.empty()) {
+        auto mid = rewards.begin() + rewards.size() / 2;
+        std::nth_element(rewards.begin(), mid, rewards.end());
+        priority = *mid;
+    }
+    
+    fees.max_priority_fee_per_gas = std::max(priority, options_.min_priority_fee);
+    fees.max_fee_per_gas = fees.base_fee * options_.base_fee_multiplier + fees.max_priority_fee_per_gas;
+    return fees;
+}
+
+// ==================== GasCache ====================
+
+GasCache::GasCache(EthRpcClient& rpc) : GasCache(rpc, Options{}) {}
+
+GasCache::GasCache(EthRpcClient& rpc, Options options)
+    : rpc_(rpc), options_(std::move(options)) {
+    load();
+}
+
+std::string GasCache::key(const std::string& to, const std::string& data) {
+    std::string hex = data;
+    if (hex.size() >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+        hex = hex.substr(2);
+    }
+    
+    std::string k = to + ":" + hex.substr(0, 8) + ":" + std::to_string(hex.size() / 2);
+    std::transform(k.begin(), k.end(), k.begin(), ::tolower);
+    return k;
+}
+
+uint64_t GasCache::gas_limit(const std::string& from, const std::string& to, const std::string& data) {
+    if (auto cached = lookup(to, data)) {
+        return *cached;
+    }
+    
+    // Estimated outside the lock; a concurrent duplicate estimate is harmless
+    uint64_t estimate = rpc_.estimate_gas(from, to, data);
+    // Return what was stored rather than looking it up again: a concurrent
+    // invalidate() could have dropped it already
+    return record(to, data, estimate);
+}
+
+std::optional<uint64_t> GasCache::lookup(const std::string& to, const std::string& data) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = limits_.find(key(to, data));
+    if (it == limits_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+uint64_t GasCache::record(const std::string& to, const std::string& data, uint64_t estimate) {
+    auto limit = static_cast<uint64_t>(std::ceil(static_cast<double>(estimate) * options_.headroom));
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    limits_[key(to, data)] = limit;
+    save_locked();
+    return limit;
+}
+
+void GasCache::invalidate(const std::string& to, const std::string& data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (limits_.erase(key(to, data)) > 0) {
+        save_locked();
+    }
+}
+
+size_t GasCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return limits_.size();
+}
+
+void GasCache::load() {
+    if (options_.path.empty()) {
+        return;
+    }
+    
+    std::ifstream in(options_.path);
+    if (!in) {
+        return;  // First run
+    }
+    
+    // A corrupt cache only costs re-estimation, so start empty rather than throw
+    try {
+        json j = json::parse(in);
+        for (auto it = j.begin(); it != j.end(); ++it) {
+            limits_[it.key()] = it.value().get<uint64_t>();
+        }
+    } catch (const std::exception&) {
+        limits_.clear();
+    }
+}
+
+void GasCache::save_locked() const {
+    if (options_.path.empty()) {
+        return;
+    }
+    
+    json j = json::object();
+    for (const auto& [k, limit] : limits_) {
+        j[k] = limit;
+    }
+    
+    // Write then rename so a crash never leaves a truncated file. Like load(),
+    // this is best-effort: an unwritable path only costs re-estimation in the
+    // next process, so it must never fail the estimate or send that called it.
+    std::string tmp = options_.path + ".tmp";
+    bool written = false;
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (out) {
+            out << j.dump(2);
+            out.flush();
+            written = static_cast<bool>(out);
+        }
+    }
+    if (!written || std::rename(tmp.c_str(), options_.path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+    }
+}
+
+// ==================== NonceManager ====================
+
+NonceManager::NonceManager(EthRpcClient& rpc, const std::string& address)
+    : rpc_(rpc), address_(address) {}
+
+uint64_t NonceManager::next() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (!synced_) {
+        uint64_t pending = rpc_.get_nonce(address_);
+        // Never go backwards past transactions we already broadcast
+        if (!in_flight_.empty()) {
+            pending = std::max(pending, in_flight_.rbegin()->first + 1);
+        }
+        next_nonce_ = pending;
+        synced_ = true;
+    }
+    
+    return next_nonce_++;
+}
+
+void NonceManager::resync() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    synced_ = false;
+}
+
+void NonceManager::reset(uint64_t next_nonce) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    next_nonce_ = next_nonce;
+    synced_ = true;
+}
+
+std::string NonceManager::send(
+    const std::function<std::string(uint64_t nonce)>& sign_fn,
+    int max_attempts
+) {
+    for (int attempt = 1; ; ++attempt) {
+        uint64_t nonce = next();
+        std::string signed_tx = sign_fn(nonce);
+        
+        try {
+            std::string tx_hash = rpc_.send_raw_transaction(signed_tx);
+            mark_sent(nonce, tx_hash);
+            return tx_hash;
+        } catch (const std::exception& e) {
+            // The reserved nonce was not consumed; our local view is stale
+            resync();
+            if (!is_nonce_too_low(e.what()) || attempt >= max_attempts) {
+                throw;
+            }
+        }
+    }
+}
+
+void NonceManager::mark_sent(uint64_t nonce, const std::string& tx_hash) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_flight_[nonce] = tx_hash;
+}
+
+void NonceManager::mark_confirmed(const std::string& tx_hash) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = in_flight_.begin(); it != in_flight_.end(); ++it) {
+        if (it->second == tx_hash) {
+            in_flight_.erase(it);
+            return;
+        }
+    }
+}
+
+size_t NonceManager::in_flight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_.size();
+}
+
+std::map<uint64_t, std::string> NonceManager::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+}
+
+bool NonceManager::is_nonce_too_low(const std::string& error_message) {
+    std::string msg = error_message;
+    std::transform(msg.begin(), msg.end(), msg.begin(), ::tolower);
+    return msg.find("nonce too low") != std::string::npos ||
+           msg.find("nonce_expired") != std::string::npos;
+}
+
+// ==================== ReceiptTracker ====================
+
+ReceiptTracker::ReceiptTracker(EthRpcClient& rpc) : ReceiptTracker(rpc, Options{}) {}
+
+ReceiptTracker::ReceiptTracker(EthRpcClient& rpc, Options options)
+    : rpc_(rpc), options_(options),
+      block_time_ms_(static_cast<double>(options.initial_block_time.count())) {}
+
+ReceiptTracker::~ReceiptTracker() {
+    stop();
+}
+
+std::future<json> ReceiptTracker::track(const std::string& tx_hash, std::chrono::seconds timeout) {
+    Waiter waiter;
+    waiter.deadline = std::chrono::steady_clock::now() + timeout;
+    waiter.promise = std::make_shared<std::promise<json>>();
+    auto future = waiter.promise->get_future();
+    add_waiter(tx_hash, std::move(waiter));
+    return future;
+}
+
+void ReceiptTracker::track(const std::string& tx_hash, Callback callback, std::chrono::seconds timeout) {
+    Waiter waiter;
+    waiter.deadline = std::chrono::steady_clock::now() + timeout;
+    waiter.callback = std::move(callback);
+    add_waiter(tx_hash, std::move(waiter));
+}
+
+void ReceiptTracker::add_waiter(const std::string& tx_hash, Waiter waiter) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+        throw std::runtime_error("ReceiptTracker is stopped");
+    }
+    
+    waiters_[tx_hash].push_back(std::move(waiter));
+    
+    // Start the background thread lazily on first use
+    if (!running_) {
+        running_ = true;
+        thread_ = std::thread(&ReceiptTracker::run, this);
+    }
+    cv_.notify_one();
+}
+
+size_t ReceiptTracker::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return waiters_.size();
+}
+
+std::chrono::milliseconds ReceiptTracker::estimated_block_time() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::chrono::milliseconds(static_cast<int64_t>(block_time_ms_));
+}
+
+void ReceiptTracker::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    
+    // Fail anything still waiting
+    std::unordered_map<std::string, std::vector<Waiter>> remaining;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        remaining.swap(waiters_);
+    }
+    auto error = std::make_exception_ptr(std::runtime_error("ReceiptTracker stopped"));
+    for (auto& [tx_hash, list] : remaining) {
+        for (auto& waiter : list) {
+            resolve(tx_hash, waiter, json(), error);
+        }
+    }
+}
+
+void ReceiptTracker::resolve(const std::string& tx_hash, Waiter& waiter, const json& receipt, std::exception_ptr error) {
+    if (waiter.promise) {
+        if (error) {
+            waiter.promise->set_exception(error);
+        } else {
+            waiter.promise->set_value(receipt);
+        }
+    }
+    if (waiter.callback) {
+        try {
+            waiter.callback(tx_hash, receipt, error);
+        } catch (...) {
+            // Never let a user callback kill the tracker thread
+        }
+    }
+}
+
+void ReceiptTracker::run() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stopping_ || !waiters_.empty(); });
+            if (stopping_) {
+                return;
+            }
+        }
+        
+        std::chrono::milliseconds sleep = options_.max_poll_interval;
+        try {
+            sleep = poll_once();
+        } catch (...) {
+            // Treated as a failed poll; an exception here would terminate the process
+        }
+        
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait_for(lock, sleep, [this]() { return stopping_; });
+        if (stopping_) {
+            return;
+        }
+    }
+}
+
+std::chrono::milliseconds ReceiptTracker::poll_once() {
+    std::vector<std::string> hashes;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        hashes.reserve(waiters_.size());
+        for (const auto& entry : waiters_) {
+            hashes.push_back(entry.first);
+        }
+    }
+    
+    // Every pending hash is queried on every poll, max_batch_size receipts per
+    // round trip, so transactions that never resolve cannot starve the rest.
+    // eth_blockNumber rides along with the first batch.
+    size_t batch_size = std::max<size_t>(1, options_.max_batch_size);
+    std::optional<uint64_t> block;
+    std::vector<std::pair<std::string, json>> mined;
+    
+    for (size_t begin = 0;; begin += batch_size) {
+        size_t end = std::min(hashes.size(), begin + batch_size);
+        size_t offset = begin == 0 ? 1 : 0;
+        
+        std::vector<RpcRequest> requests;
+        requests.reserve(end - begin + offset);
+        if (offset) {
+            requests.push_back({"eth_blockNumber", json::array()});
+        }
+        for (size_t i = begin; i < end; ++i) {
+            requests.push_back({"eth_getTransactionReceipt", json::array({hashes[i]})});
+        }
+        
+        std::vector<RpcResponse> responses;
+        try {
+            responses = rpc_.batch_call(requests);
+        } catch (...) {
+            // Transient failure; this batch is retried on the next poll
+        }
+        
+        if (!responses.empty()) {
+            // A malformed block number only skips the block-time update
+            uint64_t number = 0;
+            if (offset && responses[0].ok() && parse_quantity(responses[0].result, number)) {
+                block = number;
+            }
+            for (size_t i = begin; i < end; ++i) {
+                const auto& response = responses[i - begin + offset];
+                if (response.ok() && !response.result.is_null()) {
+                    mined.emplace_back(hashes[i], response.result);
+                }
+            }
+        }
+        
+        if (end >= hashes.size()) {
+            break;
+        }
+    }
     
-    // RLP encode signed transaction
-    std::vector<std::vector<uint8_t>> signed_items = {
-        encode_integer(nonce),
-        encode_string(gas_price_bytes),
-        encode_integer(gas_limit),
-        encode_string(to_bytes),
-        encode_string(value_bytes),
-        encode_string(data_bytes),
-        encode_integer(v_adjusted),
-        encode_string(sig.r),
-        encode_string(sig.s)
+    auto now = std::chrono::steady_clock::now();
+    bool new_block = false;
+    std::chrono::milliseconds sleep;
+    
+    struct Resolution {
+        std::string tx_hash;
+        std::vector<Waiter> waiters;
+        json receipt;
+        bool timed_out;
     };
+    std::vector<Resolution> done;
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        if (block && *block > last_block_) {
+            if (last_block_ != 0) {
+                // Exponential moving average of observed block intervals
+                double elapsed_ms = std::chrono::duration<double, std::milli>(now - last_block_seen_).count();
+                double sample = elapsed_ms / static_cast<double>(*block - last_block_);
+                block_time_ms_ = 0.8 * block_time_ms_ + 0.2 * sample;
+            }
+            last_block_ = *block;
+            last_block_seen_ = now;
+            new_block = true;
+        }
+        
+        for (auto& [tx_hash, receipt] : mined) {
+            auto it = waiters_.find(tx_hash);
+            if (it == waiters_.end()) continue;
+            done.push_back({it->first, std::move(it->second), std::move(receipt), false});
+            waiters_.erase(it);
+        }
+        
+        // Expire waiters past their deadline
+        for (auto it = waiters_.begin(); it != waiters_.end();) {
+            auto& list = it->second;
+            auto first_expired = std::stable_partition(list.begin(), list.end(),
+                [now](const Waiter& w) { return w.deadline > now; });
+            if (first_expired != list.end()) {
+                Resolution expired{it->first, {}, json(), true};
+                std::move(first_expired, list.end(), std::back_inserter(expired.waiters));
+                list.erase(first_expired, list.end());
+                done.push_back(std::move(expired));
+            }
+            it = list.empty() ? waiters_.erase(it) : std::next(it);
+        }
+        
+        // After a new block, sleep for most of a block; otherwise poll a few times per block
+        double next_ms = new_block ? block_time_ms_ * 0.9 : block_time_ms_ / 8.0;
+        sleep = std::chrono::milliseconds(static_cast<int64_t>(next_ms));
+        sleep = std::max(options_.min_poll_interval, std::min(sleep, options_.max_poll_interval));
+    }
+    
+    // Resolve outside the lock so callbacks can call back into the tracker
+    auto timeout = std::make_exception_ptr(std::runtime_error("Timeout waiting for transaction receipt"));
+    for (auto& resolution : done) {
+        for (auto& waiter : resolution.waiters) {
+            resolve(resolution.tx_hash, waiter, resolution.receipt,
+                    resolution.timed_out ? timeout : nullptr);
+        }
+    }
+    
+    return sleep;
+}
+
+// ==================== BalancePoller ====================
+
+BalancePoller::BalancePoller(EthRpcClient& rpc) : BalancePoller(rpc, Options{}) {}
+
+BalancePoller::BalancePoller(EthRpcClient& rpc, Options options)
+    : rpc_(rpc), options_(options) {}
+
+BalancePoller::~BalancePoller() {
+    stop();
+}
+
+std::string BalancePoller::make_key(const std::string& wallet, const std::string& token_id) {
+    std::string key = wallet + ":" + token_id;
+    std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+    return key;
+}
+
+void BalancePoller::add_entry(const std::string& wallet, const std::string& token_id) {
+    std::string lower = wallet;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    std::string key = make_key(lower, token_id);
     
-    auto signed_tx = encode_list(signed_items);
-    return bytes_to_hex(signed_tx);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : entries_) {
+        if (entry.key == key) return;
+    }
+    entries_.push_back({lower, token_id, key});
+}
+
+void BalancePoller::add_wallet(const std::string& wallet) {
+    add_entry(wallet, "");
+}
+
+void BalancePoller::add_position(const std::string& wallet, const std::string& token_id) {
+    add_entry(wallet, token_id);
+}
+
+void BalancePoller::on_change(Callback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    callbacks_.push_back(std::move(callback));
+}
+
+std::vector<BalancePoller::BalanceChange> BalancePoller::poll_once() {
+    std::vector<Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries = entries_;
+    }
+    
+    // Read everything first, in as few multicalls as possible
+    std::vector<std::optional<uint64_t>> values(entries.size());
+    size_t chunk = std::max<size_t>(1, options_.max_calls_per_multicall);
+    for (size_t begin = 0; begin < entries.size(); begin += chunk) {
+        size_t end = std::min(entries.size(), begin + chunk);
+        
+        std::vector<abi::Call> calls;
+        calls.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            const auto& e = entries[i];
+            if (e.token_id.empty()) {
+                calls.push_back({polygon_contracts::USDC, abi::encode_balance_of(e.wallet)});
+            } else {
+                calls.push_back({polygon_contracts::CTF, abi::encode_erc1155_balance_of(e.wallet, e.token_id)});
+            }
+        }
+        
+        auto results = rpc_.multicall(calls);
+        for (size_t i = begin; i < end && i - begin < results.size(); ++i) {
+            const auto& r = results[i - begin];
+            if (!r.success) continue;
+            try {
+                values[i] = abi::decode_uint64(r.return_data);
+            } catch (const std::exception&) {
+                // Malformed or oversized result: keep the previous value
+            }
+        }
+    }
+    
+    // Update the table, then notify outside the lock
+    std::vector<BalanceChange> changes;
+    std::vector<Callback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (!values[i]) continue;
+            
+            auto it = balances_.find(entries[i].key);
+            uint64_t previous = it == balances_.end() ? 0 : it->second;
+            bool first = it == balances_.end();
+            balances_[entries[i].key] = *values[i];
+            
+            if (*values[i] != previous || (first && *values[i] != 0)) {
+                changes.push_back({entries[i].wallet, entries[i].token_id, previous, *values[i]});
+            }
+        }
+        callbacks = callbacks_;
+    }
+    
+    for (const auto& change : changes) {
+        for (const auto& callback : callbacks) {
+            callback(change);
+        }
+    }
+    return changes;
+}
+
+void BalancePoller::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) return;
+    running_ = true;
+    thread_ = std::thread([this]() { run(); });
+}
+
+void BalancePoller::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void BalancePoller::run() {
+    while (true) {
+        try {
+            poll_once();
+        } catch (const std::exception&) {
+            // Transient RPC failure; retry on the next interval
+            errors_++;
+        }
+        
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait_for(lock, options_.interval, [this]() { return !running_; });
+        if (!running_) return;
+    }
+}
+
+std::optional<uint64_t> BalancePoller::lookup(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = balances_.find(key);
+    if (it == balances_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::optional<uint64_t> BalancePoller::usdc_balance(const std::string& wallet) const {
+    return lookup(make_key(wallet, ""));
+}
+
+std::optional<uint64_t> BalancePoller::position_balance(const std::string& wallet, const std::string& token_id) const {
+    return lookup(make_key(wallet, token_id));
 }
 
 // ==================== ApprovalHelper ====================
 
-ApprovalHelper::ApprovalHelper(const std::string& private_key, const std::string& rpc_url)
-    : private_key_(private_key), rpc_(rpc_url) {
-    Signer signer(private_key, 137);
-    address_ = signer.address();
+static const std::string MAX_UINT256 =
+    "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff";
+
+// The four approval checks for one owner, in ApprovalStatus field order
+static std::vector<abi::Call> approval_status_calls(const std::string& owner) {
+    return {
+        {polygon_contracts::USDC, abi::encode_allowance(owner, polygon_contracts::EXCHANGE)},
+        {polygon_contracts::USDC, abi::encode_allowance(owner, polygon_contracts::NEG_RISK_EXCHANGE)},
+        {polygon_contracts::CTF, abi::encode_is_approved_for_all(owner, polygon_contracts::EXCHANGE)},
+        {polygon_contracts::CTF, abi::encode_is_approved_for_all(owner, polygon_contracts::NEG_RISK_EXCHANGE)}
+    };
+}
+
+static ApprovalHelper::ApprovalStatus decode_approval_status(
+    const std::vector<abi::CallResult>& results, size_t offset
+) {
+    auto granted = [&](size_t i) {
+        const auto& r = results.at(offset + i);
+        return r.success && abi::is_nonzero_word(r.return_data);
+    };
+    
+    ApprovalHelper::ApprovalStatus status;
+    status.usdc_exchange = granted(0);
+    status.usdc_neg_risk = granted(1);
+    status.ctf_exchange = granted(2);
+    status.ctf_neg_risk = granted(3);
+    return status;
+}
+
+// (to, calldata) of every approval the status is missing
+static std::vector<std::pair<std::string, std::string>> missing_approvals(
+    const ApprovalHelper::ApprovalStatus& status
+) {
+    std::vector<std::pair<std::string, std::string>> txs;
+    if (!status.usdc_exchange) {
+        txs.emplace_back(polygon_contracts::USDC, abi::encode_approve(polygon_contracts::EXCHANGE, MAX_UINT256));
+    }
+    if (!status.usdc_neg_risk) {
+        txs.emplace_back(polygon_contracts::USDC, abi::encode_approve(polygon_contracts::NEG_RISK_EXCHANGE, MAX_UINT256));
+    }
+    if (!status.ctf_exchange) {
+        txs.emplace_back(polygon_contracts::CTF, abi::encode_set_approval_for_all(polygon_contracts::EXCHANGE, true));
+    }
+    if (!status.ctf_neg_risk) {
+        txs.emplace_back(polygon_contracts::CTF, abi::encode_set_approval_for_all(polygon_contracts::NEG_RISK_EXCHANGE, true));
+    }
+    return txs;
+}
+
+static bool receipt_reverted(const json& receipt) {
+    return receipt.contains("status") && receipt["status"] == "0x0";
+}
+
+static GasCache::Options gas_cache_options(const std::string& path) {
+    GasCache::Options options;
+    options.path = path;
+    return options;
+}
+
+ApprovalHelper::ApprovalHelper(
+    const std::string& private_key,
+    const std::string& rpc_url,
+    const std::string& gas_cache_path
+)
+    : signer_(std::make_shared<Signer>(private_key, 137)), address_(signer_->address()),
+      rpc_(rpc_url), nonces_(rpc_, address_), receipts_(rpc_), fees_(rpc_),
+      gas_(rpc_, gas_cache_options(gas_cache_path)) {}
+
+ApprovalHelper::ApprovalStatus ApprovalHelper::check_approvals() {
+    // One round trip instead of four sequential eth_calls
+    auto results = rpc_.multicall(approval_status_calls(address_));
+    return decode_approval_status(results, 0);
 }
 
 bool ApprovalHelper::has_usdc_exchange_approval() {
@@ -347,97 +1543,317 @@ bool ApprovalHelper::has_ctf_neg_risk_approval() {
     return rpc_.is_approved_for_all(polygon_contracts::CTF, address_, polygon_contracts::NEG_RISK_EXCHANGE);
 }
 
+std::string ApprovalHelper::broadcast(const std::string& to, const std::string& data) {
+    // Both cached, so repeat operations go out without pre-flight RPCs
+    auto fees = fees_.get();
+    uint64_t gas_limit = gas_.gas_limit(address_, to, data);
+    
+    try {
+        return nonces_.send([&](uint64_t nonce) {
+            Eip1559Transaction tx;
+            tx.chain_id = 137;
+            tx.nonce = nonce;
+            tx.max_priority_fee_per_gas = fees.max_priority_fee_per_gas;
+            tx.max_fee_per_gas = fees.max_fee_per_gas;
+            tx.gas_limit = gas_limit;
+            tx.to = to;
+            tx.value = "0x0";
+            tx.data = data;
+            return tx.sign(*signer_);
+        });
+    } catch (...) {
+        gas_.invalidate(to, data);
+        throw;
+    }
+}
+
+void ApprovalHelper::check_receipt(const json& receipt, const std::string& to, const std::string& data) {
+    if (receipt_reverted(receipt)) {
+        gas_.invalidate(to, data);
+        throw std::runtime_error("Transaction reverted: " + receipt.value("transactionHash", std::string()));
+    }
+}
+
+void ApprovalHelper::confirm(const std::string& tx_hash, const std::string& to, const std::string& data) {
+    auto receipt = receipts_.track(tx_hash).get();
+    nonces_.mark_confirmed(tx_hash);
+    check_receipt(receipt, to, data);
+}
+
 std::string ApprovalHelper::approve_usdc_for_exchange() {
-    Transaction tx;
-    tx.nonce = rpc_.get_nonce(address_);
-    tx.gas_price = rpc_.get_gas_price();
-    tx.gas_limit = 100000;
-    tx.to = polygon_contracts::USDC;
-    tx.value = "0x0";
-    tx.data = abi::encode_approve(polygon_contracts::EXCHANGE, 
-        "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");  // max uint256
-    tx.chain_id = 137;
-    
-    std::string signed_tx = tx.sign(private_key_);
-    std::string tx_hash = rpc_.send_raw_transaction(signed_tx);
-    rpc_.wait_for_receipt(tx_hash);
+    auto data = abi::encode_approve(polygon_contracts::EXCHANGE, MAX_UINT256);
+    std::string tx_hash = broadcast(polygon_contracts::USDC, data);
+    confirm(tx_hash, polygon_contracts::USDC, data);
     return tx_hash;
 }
 
 std::string ApprovalHelper::approve_usdc_for_neg_risk_exchange() {
-    Transaction tx;
-    tx.nonce = rpc_.get_nonce(address_);
-    tx.gas_price = rpc_.get_gas_price();
-    tx.gas_limit = 100000;
-    tx.to = polygon_contracts::USDC;
-    tx.value = "0x0";
-    tx.data = abi::encode_approve(polygon_contracts::NEG_RISK_EXCHANGE,
-        "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
-    tx.chain_id = 137;
-    
-    std::string signed_tx = tx.sign(private_key_);
-    std::string tx_hash = rpc_.send_raw_transaction(signed_tx);
-    rpc_.wait_for_receipt(tx_hash);
+    auto data = abi::encode_approve(polygon_contracts::NEG_RISK_EXCHANGE, MAX_UINT256);
+    std::string tx_hash = broadcast(polygon_contracts::USDC, data);
+    confirm(tx_hash, polygon_contracts::USDC, data);
     return tx_hash;
 }
 
 std::string ApprovalHelper::approve_ctf_for_exchange() {
-    Transaction tx;
-    tx.nonce = rpc_.get_nonce(address_);
-    tx.gas_price = rpc_.get_gas_price();
-    tx.gas_limit = 100000;
-    tx.to = polygon_contracts::CTF;
-    tx.value = "0x0";
-    tx.data = abi::encode_set_approval_for_all(polygon_contracts::EXCHANGE, true);
-    tx.chain_id = 137;
-    
-    std::string signed_tx = tx.sign(private_key_);
-    std::string tx_hash = rpc_.send_raw_transaction(signed_tx);
-    rpc_.wait_for_receipt(tx_hash);
+    auto data = abi::encode_set_approval_for_all(polygon_contracts::EXCHANGE, true);
+    std::string tx_hash = broadcast(polygon_contracts::CTF, data);
+    confirm(tx_hash, polygon_contracts::CTF, data);
     return tx_hash;
 }
 
 std::string ApprovalHelper::approve_ctf_for_neg_risk_exchange() {
-    Transaction tx;
-    tx.nonce = rpc_.get_nonce(address_);
-    tx.gas_price = rpc_.get_gas_price();
-    tx.gas_limit = 100000;
-    tx.to = polygon_contracts::CTF;
-    tx.value = "0x0";
-    tx.data = abi::encode_set_approval_for_all(polygon_contracts::NEG_RISK_EXCHANGE, true);
-    tx.chain_id = 137;
-    
-    std::string signed_tx = tx.sign(private_key_);
-    std::string tx_hash = rpc_.send_raw_transaction(signed_tx);
-    rpc_.wait_for_receipt(tx_hash);
+    auto data = abi::encode_set_approval_for_all(polygon_contracts::NEG_RISK_EXCHANGE, true);
+    std::string tx_hash = broadcast(polygon_contracts::CTF, data);
+    confirm(tx_hash, polygon_contracts::CTF, data);
     return tx_hash;
 }
 
 bool ApprovalHelper::ensure_approvals() {
-    bool all_set = true;
+    auto status = check_approvals();
+    
+    // Broadcast every missing approval back-to-back with locally assigned
+    // nonces, then wait for all receipts
+    struct Sent {
+        std::string tx_hash;
+        std::string to;
+        std::string data;
+    };
+    std::vector<Sent> sent;
+    
+    for (auto& [to, data] : missing_approvals(status)) {
+        std::string tx_hash = broadcast(to, data);
+        sent.push_back({tx_hash, to, data});
+    }
     
-    if (!has_usdc_exchange_approval()) {
-        all_set = false;
-        approve_usdc_for_exchange();
+    // One tracker watches all of them; receipts resolve as they land
+    std::vector<std::future<json>> receipts;
+    for (const auto& tx : sent) {
+        receipts.push_back(receipts_.track(tx.tx_hash));
+    }
+    for (size_t i = 0; i < receipts.size(); ++i) {
+        auto receipt = receipts[i].get();
+        nonces_.mark_confirmed(sent[i].tx_hash);
+        check_receipt(receipt, sent[i].to, sent[i].data);
     }
     
-    if (!has_usdc_neg_risk_approval()) {
-        all_set = false;
-        approve_usdc_for_neg_risk_exchange();
+    return status.all();
+}
+
+// ==================== ApprovalProvisioner ====================
+
+ApprovalProvisioner::ApprovalProvisioner(const std::string& rpc_url, const std::string& gas_cache_path)
+    : rpc_(rpc_url), receipts_(rpc_), fees_(rpc_), gas_(rpc_, gas_cache_options(gas_cache_path)) {}
+
+std::vector<ApprovalHelper::ApprovalStatus> ApprovalProvisioner::check_approvals(
+    const std::vector<std::string>& addresses
+) {
+    std::vector<abi::Call> calls;
+    calls.reserve(addresses.size() * 4);
+    for (const auto& address : addresses) {
+        auto wallet_calls = approval_status_calls(address);
+        calls.insert(calls.end(), wallet_calls.begin(), wallet_calls.end());
     }
     
-    if (!has_ctf_exchange_approval()) {
-        all_set = false;
-        approve_ctf_for_exchange();
+    std::vector<ApprovalHelper::ApprovalStatus> statuses;
+    if (calls.empty()) {
+        return statuses;
     }
     
-    if (!has_ctf_neg_risk_approval()) {
-        all_set = false;
-        approve_ctf_for_neg_risk_exchange();
+    auto results = rpc_.multicall(calls);
+    if (results.size() != calls.size()) {
+        throw std::runtime_error("Multicall returned " + std::to_string(results.size()) +
+                                 " results for " + std::to_string(calls.size()) + " calls");
     }
     
-    return all_set;
+    statuses.reserve(addresses.size());
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        statuses.push_back(decode_approval_status(results, i * 4));
+    }
+    return statuses;
 }
 
-} // namespace clob
+std::vector<ApprovalProvisioner::WalletResult> ApprovalProvisioner::provision(
+    const std::vector<std::string>& private_keys,
+    std::chrono::seconds timeout
+) {
+    std::vector<std::unique_ptr<Signer>> signers;
+    std::vector<std::string> addresses;
+    std::vector<WalletResult> results(private_keys.size());
+    
+    signers.reserve(private_keys.size());
+    addresses.reserve(private_keys.size());
+    for (size_t i = 0; i < private_keys.size(); ++i) {
+        signers.push_back(std::make_unique<Signer>(private_keys[i], 137));
+        addresses.push_back(signers.back()->address());
+        results[i].address = addresses.back();
+    }
+    
+    // 1. Every wallet's status in one multicall
+    auto statuses = check_approvals(addresses);
+    std::vector<size_t> pending_wallets;
+    for (size_t i = 0; i < results.size(); ++i) {
+        results[i].before = statuses[i];
+        if (statuses[i].all()) {
+            results[i].success = true;
+        } else {
+            pending_wallets.push_back(i);
+        }
+    }
+    if (pending_wallets.empty()) {
+        return results;
+    }
+    
+    // 2. Pending nonces for every wallet that needs transactions, in one batch
+    std::vector<RpcRequest> nonce_requests;
+    for (size_t i : pending_wallets) {
+        nonce_requests.push_back({"eth_getTransactionCount", {addresses[i], "pending"}});
+    }
+    auto nonce_responses = rpc_.batch_call(nonce_requests);
+    
+    std::vector<std::unique_ptr<NonceManager>> nonces(results.size());
+    for (size_t k = 0; k < pending_wallets.size(); ++k) {
+        size_t i = pending_wallets[k];
+        if (!nonce_responses[k].ok()) {
+            results[i].error = "Nonce fetch failed: " + *nonce_responses[k].error;
+            continue;
+        }
+        uint64_t pending_nonce = 0;
+        if (!parse_quantity(nonce_responses[k].result, pending_nonce)) {
+            results[i].error = "Nonce fetch failed: malformed result " + nonce_responses[k].result.dump();
+            continue;
+        }
+        nonces[i] = std::make_unique<NonceManager>(rpc_, addresses[i]);
+        nonces[i]->reset(pending_nonce);
+    }
+    
+    // 3. Sign every missing approval locally
+    struct Signed {
+        size_t wallet;
+        uint64_t nonce;
+        std::string to;
+        std::string data;
+        std::string raw_tx;
+    };
+    std::vector<Signed> signed_txs;
+    auto fees = fees_.get();
+    
+    for (size_t i : pending_wallets) {
+        if (!nonces[i]) continue;
+        size_t wallet_start = signed_txs.size();
+        try {
+            for (auto& [to, data] : missing_approvals(statuses[i])) {
+                Eip1559Transaction tx;
+                tx.chain_id = 137;
+                tx.nonce = nonces[i]->next();
+                tx.max_priority_fee_per_gas = fees.max_priority_fee_per_gas;
+                tx.max_fee_per_gas = fees.max_fee_per_gas;
+                tx.gas_limit = gas_.gas_limit(addresses[i], to, data);
+                tx.to = to;
+                tx.value = "0x0";
+                tx.data = data;
+                signed_txs.push_back({i, tx.nonce, to, data, tx.sign(*signers[i])});
+            }
+        } catch (const std::exception& e) {
+            // Send none of the wallet's approvals rather than a failed wallet
+            // with transactions in flight
+            signed_txs.erase(signed_txs.begin() + static_cast<std::ptrdiff_t>(wallet_start), signed_txs.end());
+            results[i].error = e.what();
+        }
+    }
+    
+    // 4-5. Broadcast in rounds: round r sends every wallet's r-th transaction,
+    // all wallets in one batch. A wallet whose broadcast fails sends nothing
+    // after it, so no later nonce reaches the node's queue behind the gap
+    // (where it could never confirm, and a re-run signing the same nonce
+    // would collide with it). One tracker waits on every accepted transaction.
+    struct Tracked {
+        size_t tx;
+        std::string tx_hash;
+        std::future<json> receipt;
+    };
+    std::vector<Tracked> tracked;
+    
+    std::vector<std::vector<size_t>> wallet_txs(results.size());  // signed_txs indices, nonce order
+    for (size_t k = 0; k < signed_txs.size(); ++k) {
+        wallet_txs[signed_txs[k].wallet].push_back(k);
+    }
+    std::vector<bool> stopped(results.size(), false);
+    
+    for (size_t round = 0;; ++round) {
+        std::vector<size_t> batch;
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (!stopped[i] && round < wallet_txs[i].size()) {
+                batch.push_back(wallet_txs[i][round]);
+            }
+        }
+        if (batch.empty()) {
+            break;
+        }
+        
+        std::vector<RpcRequest> send_requests;
+        send_requests.reserve(batch.size());
+        for (size_t k : batch) {
+            send_requests.push_back({"eth_sendRawTransaction", {signed_txs[k].raw_tx}});
+        }
+        
+        std::vector<RpcResponse> send_responses;
+        try {
+            send_responses = rpc_.batch_call(send_requests);
+        } catch (const std::exception& e) {
+            // Whether any of the round landed is unknown; stop every wallet in it
+            for (size_t k : batch) {
+                auto& result = results[signed_txs[k].wallet];
+                stopped[signed_txs[k].wallet] = true;
+                if (result.error.empty()) {
+                    result.error = std::string("Broadcast failed: ") + e.what();
+                }
+            }
+            continue;
+        }
+        
+        for (size_t j = 0; j < batch.size(); ++j) {
+            size_t k = batch[j];
+            const auto& tx = signed_txs[k];
+            auto& result = results[tx.wallet];
+            if (!send_responses[j].ok()) {
+                stopped[tx.wallet] = true;
+                gas_.invalidate(tx.to, tx.data);
+                if (result.error.empty()) {
+                    result.error = "Broadcast failed: " + *send_responses[j].error;
+                }
+                continue;
+            }
+            
+            std::string tx_hash = send_responses[j].result.get<std::string>();
+            nonces[tx.wallet]->mark_sent(tx.nonce, tx_hash);
+            result.tx_hashes.push_back(tx_hash);
+            tracked.push_back({k, tx_hash, receipts_.track(tx_hash, timeout)});
+        }
+    }
+    
+    for (auto& t : tracked) {
+        const auto& tx = signed_txs[t.tx];
+        auto& result = results[tx.wallet];
+        try {
+            auto receipt = t.receipt.get();
+            nonces[tx.wallet]->mark_confirmed(t.tx_hash);
+            if (receipt_reverted(receipt)) {
+                gas_.invalidate(tx.to, tx.data);
+                if (result.error.empty()) {
+                    result.error = "Transaction reverted: " + t.tx_hash;
+                }
+            }
+        } catch (const std::exception& e) {
+            if (result.error.empty()) {
+                result.error = e.what();
+            }
+        }
+    }
+    
+    for (size_t i : pending_wallets) {
+        results[i].success = results[i].error.empty();
+    }
+    return results;
+}
 
+} // namespace clob
@@ -0,0 +1,64 @@
+#include "clob/hex.hpp"
+#include <stdexcept>
+
+namespace clob {
+namespace hex {
+
+bool decode_to(std::string_view hex, uint8_t* out) {
+    hex = strip_prefix(hex);
+    if (hex.size() % 2 != 0) {
+        return false;
+    }
+
+    const uint8_t* table = detail::DECODE_TABLE.data();
+    const auto* in = reinterpret_cast<const uint8_t*>(hex.data());
+    size_t len = hex.size() / 2;
+
+    // OR the nibbles together so validation costs one branch per byte
+    for (size_t i = 0; i < len; ++i) {
+        uint8_t hi = table[in[i * 2]];
+        uint8_t lo = table[in[i * 2 + 1]];
+        if ((hi | lo) & 0xf0) {
+            return false;
+        }
+        out[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
+
+bool is_valid(std::string_view hex) {
+    hex = strip_prefix(hex);
+    if (hex.size() % 2 != 0) {
+        return false;
+    }
+    for (char c : hex) {
+        if (detail::DECODE_TABLE[static_cast<uint8_t>(c)] == 0xff) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string encode(const uint8_t* data, size_t len, bool prefix) {
+    std::string out(encoded_size(len, prefix), '\0');
+    size_t pos = 0;
+    if (prefix) {
+        out[0] = '0';
+        out[1] = 'x';
+        pos = 2;
+    }
+    encode_to(data, len, &out[pos]);
+    return out;
+}
+
+std::vector<uint8_t> decode(std::string_view hex) {
+    std::string_view digits = strip_prefix(hex);
+    std::vector<uint8_t> out(digits.size() / 2);
+    if (!decode_to(digits, out.data())) {
+        throw std::runtime_error("Invalid hex string: " + std::string(hex));
+    }
+    return out;
+}
+
+} // namespace hex
+} // namespace clob
@@ -1,4 +1,6 @@
 #include "clob/http_client.hpp"
+#include "clob/metrics.hpp"
+#include "clob/trace.hpp"
 #include <httplib.h>
 #include <stdexcept>
 #include <sstream>
@@ -6,8 +8,24 @@
 
 namespace clob {
 
-HttpClient::HttpClient(const std::string& host) 
-    : host_(host)
+namespace {
+
+// Counts a pooled connection as busy for the lifetime of a request
+struct PoolInUse {
+    PoolInUse() { metrics::record_pool_in_use(1); }
+    ~PoolInUse() { metrics::record_pool_in_use(-1); }
+};
+
+uint64_t elapsed_ns(std::chrono::high_resolution_clock::time_point start,
+                    std::chrono::high_resolution_clock::time_point end) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+} // namespace
+
+HttpClient::HttpClient(const std::string& host, size_t pool_size) 
+    : next_connection_(0)
+    , host_(host)
     , heartbeat_running_(false)
     , total_requests_(0)
     , reused_connections_(0)
@@ -16,18 +34,23 @@ HttpClient::HttpClient(const std::string& host)
     , connection_warm_(false)
 {
     parse_host();
-    init_client();
+    
+    pool_.resize(pool_size > 0 ? pool_size : 1);
+    for (auto& conn : pool_) {
+        conn = std::make_unique<Connection>();
+        init_client(*conn);
+    }
+    metrics::record_pool_size(static_cast<int64_t>(pool_.size()));
 }
 
 HttpClient::~HttpClient() {
     stop_heartbeat();
+    metrics::record_pool_size(-static_cast<int64_t>(pool_.size()));
 }
 
 HttpClient::HttpClient(HttpClient&& other) noexcept
-    : ssl_client_(std::move(other.ssl_client_))
-    , client_(std::move(other.client_))
-    , parser_(std::move(other.parser_))
-    , parser_buffer_(std::move(other.parser_buffer_))
+    : pool_(std::move(other.pool_))
+    , next_connection_(other.next_connection_.load())
     , host_(std::move(other.host_))
     , scheme_(std::move(other.scheme_))
     , host_only_(std::move(other.host_only_))
@@ -38,6 +61,7 @@ HttpClient::HttpClient(HttpClient&& other) noexcept
     , total_latency_ms_(other.total_latency_ms_)
     , last_latency_ms_(other.last_latency_ms_)
     , connection_warm_(other.connection_warm_)
+    , request_metrics_(other.request_metrics_)
 {
     other.stop_heartbeat();
 }
@@ -47,10 +71,9 @@ HttpClient& HttpClient::operator=(HttpClient&& other) noexcept {
         stop_heartbeat();
         other.stop_heartbeat();
         
-        ssl_client_ = std::move(other.ssl_client_);
-        client_ = std::move(other.client_);
-        parser_ = std::move(other.parser_);
-        parser_buffer_ = std::move(other.parser_buffer_);
+        metrics::record_pool_size(-static_cast<int64_t>(pool_.size()));
+        pool_ = std::move(other.pool_);
+        next_connection_ = other.next_connection_.load();
         host_ = std::move(other.host_);
         scheme_ = std::move(other.scheme_);
         host_only_ = std::move(other.host_only_);
@@ -61,10 +84,24 @@ HttpClient& HttpClient::operator=(HttpClient&& other) noexcept {
         total_latency_ms_ = other.total_latency_ms_;
         last_latency_ms_ = other.last_latency_ms_;
         connection_warm_ = other.connection_warm_;
+        request_metrics_ = other.request_metrics_;
     }
     return *this;
 }
 
+void HttpClient::record_request(const char* method, const std::string& path, int status, uint64_t latency_ns) const {
+    switch (request_metrics_) {
+        case RequestMetrics::Full:
+            metrics::record_request(method, path, status, latency_ns);
+            break;
+        case RequestMetrics::Redacted:
+            metrics::record_request(method, "redacted", status, latency_ns);
+            break;
+        case RequestMetrics::Off:
+            break;
+    }
+}
+
 void HttpClient::parse_host() {
     // Parse scheme and host
     size_t scheme_pos = host_.find("://");
@@ -99,31 +136,31 @@ void HttpClient::parse_host() {
     }
 }
 
-void HttpClient::init_client() {
+void HttpClient::init_client(Connection& conn) {
     if (scheme_ == "https") {
-        ssl_client_ = std::make_unique<httplib::SSLClient>(host_only_, port_);
+        conn.ssl = std::make_unique<httplib::SSLClient>(host_only_, port_);
         
         // LOW-LATENCY OPTIMIZATIONS
         
         // 1. Enable HTTP keep-alive (reuse connection)
-        ssl_client_->set_keep_alive(true);
+        conn.ssl->set_keep_alive(true);
         
         // 2. Set connection timeout
-        ssl_client_->set_connection_timeout(5);  // 5 seconds
-        ssl_client_->set_read_timeout(10);       // 10 seconds
-        ssl_client_->set_write_timeout(10);      // 10 seconds
+        conn.ssl->set_connection_timeout(5);  // 5 seconds
+        conn.ssl->set_read_timeout(10);       // 10 seconds
+        conn.ssl->set_write_timeout(10);      // 10 seconds
         
         // 3. Enable SSL certificate verification for security
-        ssl_client_->enable_server_certificate_verification(true);
+        conn.ssl->enable_server_certificate_verification(true);
         
         // 4. Set follow redirects
-        ssl_client_->set_follow_location(true);
+        conn.ssl->set_follow_location(true);
         
         // 5. Set TCP_NODELAY (disable Nagle's algorithm)
         // Note: cpp-httplib enables this by default
         
         // 6. Set default headers with keep-alive
-        ssl_client_->set_default_headers({
+        conn.ssl->set_default_headers({
             {"Connection", "keep-alive"},
             {"Keep-Alive", "timeout=60, max=1000"},
             {"Accept", "application/json"},
@@ -132,16 +169,16 @@ void HttpClient::init_client() {
         });
         
     } else {
-        client_ = std::make_unique<httplib::Client>(host_only_, port_);
+        conn.plain = std::make_unique<httplib::Client>(host_only_, port_);
         
         // Same optimizations for HTTP
-        client_->set_keep_alive(true);
-        client_->set_connection_timeout(5);
-        client_->set_read_timeout(10);
-        client_->set_write_timeout(10);
-        client_->set_follow_location(true);
+        conn.plain->set_keep_alive(true);
+        conn.plain->set_connection_timeout(5);
+        conn.plain->set_read_timeout(10);
+        conn.plain->set_write_timeout(10);
+        conn.plain->set_follow_location(true);
         
-        client_->set_default_headers({
+        conn.plain->set_default_headers({
             {"Connection", "keep-alive"},
             {"Keep-Alive", "timeout=60, max=1000"},
             {"Accept", "application/json"},
@@ -176,6 +213,40 @@ std::string HttpClient::build_query_string(const json& params) const {
     return oss.str();
 }
 
+std::unique_lock<std::mutex> HttpClient::acquire(Connection*& conn) {
+    size_t start = next_connection_.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < pool_.size(); ++i) {
+        Connection* candidate = pool_[(start + i) % pool_.size()].get();
+        std::unique_lock<std::mutex> lock(candidate->mutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            conn = candidate;
+            return lock;
+        }
+    }
+    
+    // Every connection is busy: queue on this request's round-robin slot
+    conn = pool_[start % pool_.size()].get();
+    auto wait_start = std::chrono::high_resolution_clock::now();
+    std::unique_lock<std::mutex> lock(conn->mutex);
+    metrics::record_pool_wait(elapsed_ns(wait_start, std::chrono::high_resolution_clock::now()));
+    return lock;
+}
+
+simdjson::dom::element HttpClient::parse_simd(const std::string& body) {
+    CLOB_TRACE_SCOPE("http.parse_simd");
+    // One parser per thread: concurrent requests on a shared HttpClient never
+    // share parser state, and buffers are reused across calls on a thread
+    thread_local simdjson::dom::parser parser;
+    thread_local std::string buffer;
+    
+    buffer = body;
+    auto doc = parser.parse(buffer);
+    if (doc.error()) {
+        throw std::runtime_error("SIMD JSON parse error: " + std::string(simdjson::error_message(doc.error())));
+    }
+    return doc.value();
+}
+
 void HttpClient::update_stats(double latency_ms) {
     std::lock_guard<std::mutex> lock(stats_mutex_);
     total_requests_++;
@@ -193,7 +264,11 @@ std::string HttpClient::execute_get(
     const std::optional<Headers>& headers,
     const std::optional<json>& params
 ) {
-    std::lock_guard<std::mutex> lock(client_mutex_);
+    Connection* conn = nullptr;
+    CLOB_TRACE_SPAN(wait, "http.acquire");
+    auto lock = acquire(conn);
+    CLOB_TRACE_END(wait);
+    PoolInUse in_use;
     
     // Build full path with query params
     std::string full_path = path;
@@ -211,19 +286,22 @@ std::string HttpClient::execute_get(
     
     // Execute with timing
     auto start = std::chrono::high_resolution_clock::now();
+    CLOB_TRACE_SPAN(round_trip, "http.get");
     
     httplib::Result res;
-    if (ssl_client_) {
-        res = ssl_client_->Get(full_path, req_headers);
+    if (conn->ssl) {
+        res = conn->ssl->Get(full_path, req_headers);
     } else {
-        res = client_->Get(full_path, req_headers);
+        res = conn->plain->Get(full_path, req_headers);
     }
     
     auto end = std::chrono::high_resolution_clock::now();
+    CLOB_TRACE_END(round_trip);
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
     double latency_ms = duration.count() / 1000.0;
     
     update_stats(latency_ms);
+    record_request("GET", path, res ? res->status : 0, elapsed_ns(start, end));
     
     if (!res) {
         throw std::runtime_error("HTTP request failed: " + httplib::to_string(res.error()));
@@ -241,7 +319,11 @@ std::string HttpClient::execute_post(
     const std::optional<json>& data,
     const std::optional<Headers>& headers
 ) {
-    std::lock_guard<std::mutex> lock(client_mutex_);
+    Connection* conn = nullptr;
+    CLOB_TRACE_SPAN(wait, "http.acquire");
+    auto lock = acquire(conn);
+    CLOB_TRACE_END(wait);
+    PoolInUse in_use;
     
     // Prepare headers
     httplib::Headers req_headers;
@@ -252,23 +334,28 @@ std::string HttpClient::execute_post(
     }
     
     // Prepare body
+    CLOB_TRACE_SPAN(serialize, "http.serialize");
     std::string body = data.has_value() ? data->dump() : "{}";
+    CLOB_TRACE_END(serialize);
     
     // Execute with timing
     auto start = std::chrono::high_resolution_clock::now();
+    CLOB_TRACE_SPAN(round_trip, "http.post");
     
     httplib::Result res;
-    if (ssl_client_) {
-        res = ssl_client_->Post(path, req_headers, body, "application/json");
+    if (conn->ssl) {
+        res = conn->ssl->Post(path, req_headers, body, "application/json");
     } else {
-        res = client_->Post(path, req_headers, body, "application/json");
+        res = conn->plain->Post(path, req_headers, body, "application/json");
     }
     
     auto end = std::chrono::high_resolution_clock::now();
+    CLOB_TRACE_END(round_trip);
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
     double latency_ms = duration.count() / 1000.0;
     
     update_stats(latency_ms);
+    record_request("POST", path, res ? res->status : 0, elapsed_ns(start, end));
     
     if (!res) {
         throw std::runtime_error("HTTP request failed: " + httplib::to_string(res.error()));
@@ -286,7 +373,11 @@ std::string HttpClient::execute_del(
     const std::optional<json>& data,
     const std::optional<Headers>& headers
 ) {
-    std::lock_guard<std::mutex> lock(client_mutex_);
+    Connection* conn = nullptr;
+    CLOB_TRACE_SPAN(wait, "http.acquire");
+    auto lock = acquire(conn);
+    CLOB_TRACE_END(wait);
+    PoolInUse in_use;
     
     // Prepare headers
     httplib::Headers req_headers;
@@ -297,23 +388,28 @@ std::string HttpClient::execute_del(
     }
     
     // Prepare body
+    CLOB_TRACE_SPAN(serialize, "http.serialize");
     std::string body = data.has_value() ? data->dump() : "{}";
+    CLOB_TRACE_END(serialize);
     
     // Execute with timing
     auto start = std::chrono::high_resolution_clock::now();
+    CLOB_TRACE_SPAN(round_trip, "http.delete");
     
     httplib::Result res;
-    if (ssl_client_) {
-        res = ssl_client_->Delete(path, req_headers, body, "application/json");
+    if (conn->ssl) {
+        res = conn->ssl->Delete(path, req_headers, body, "application/json");
     } else {
-        res = client_->Delete(path, req_headers, body, "application/json");
+        res = conn->plain->Delete(path, req_headers, body, "application/json");
     }
     
     auto end = std::chrono::high_resolution_clock::now();
+    CLOB_TRACE_END(round_trip);
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
     double latency_ms = duration.count() / 1000.0;
     
     update_stats(latency_ms);
+    record_request("DELETE", path, res ? res->status : 0, elapsed_ns(start, end));
     
     if (!res) {
         throw std::runtime_error("HTTP request failed: " + httplib::to_string(res.error()));
@@ -333,16 +429,8 @@ simdjson::dom::element HttpClient::get_simd(
     const std::optional<Headers>& headers,
     const std::optional<json>& params
 ) {
-    std::string response_body = execute_get(path, headers, params);
-    
-    // Parse with SIMD JSON (20x faster than nlohmann)
-    parser_buffer_ = response_body;  // Copy to reusable buffer
-    auto doc = parser_.parse(parser_buffer_);
-    if (doc.error()) {
-        throw std::runtime_error("SIMD JSON parse error: " + std::string(simdjson::error_message(doc.error())));
-    }
-    
-    return doc.value();
+    // Parse with SIMD JSON (5-10x nlohmann throughput; see clob_parse_benchmarks)
+    return parse_simd(execute_get(path, headers, params));
 }
 
 simdjson::dom::element HttpClient::post_simd(
@@ -350,15 +438,7 @@ simdjson::dom::element HttpClient::post_simd(
     const std::optional<json>& data,
     const std::optional<Headers>& headers
 ) {
-    std::string response_body = execute_post(path, data, headers);
-    
-    parser_buffer_ = response_body;
-    auto doc = parser_.parse(parser_buffer_);
-    if (doc.error()) {
-        throw std::runtime_error("SIMD JSON parse error: " + std::string(simdjson::error_message(doc.error())));
-    }
-    
-    return doc.value();
+    return parse_simd(execute_post(path, data, headers));
 }
 
 simdjson::dom::element HttpClient::del_simd(
@@ -366,15 +446,7 @@ simdjson::dom::element HttpClient::del_simd(
     const std::optional<json>& data,
     const std::optional<Headers>& headers
 ) {
-    std::string response_body = execute_del(path, data, headers);
-    
-    parser_buffer_ = response_body;
-    auto doc = parser_.parse(parser_buffer_);
-    if (doc.error()) {
-        throw std::runtime_error("SIMD JSON parse error: " + std::string(simdjson::error_message(doc.error())));
-    }
-    
-    return doc.value();
+    return parse_simd(execute_del(path, data, headers));
 }
 
 // ========== Legacy JSON Methods (Backward Compatibility) ==========
@@ -385,6 +457,7 @@ json HttpClient::get(
     const std::optional<json>& params
 ) {
     std::string response_body = execute_get(path, headers, params);
+    CLOB_TRACE_SCOPE("http.parse_json");
     return json::parse(response_body);
 }
 
@@ -394,6 +467,7 @@ json HttpClient::post(
     const std::optional<Headers>& headers
 ) {
     std::string response_body = execute_post(path, data, headers);
+    CLOB_TRACE_SCOPE("http.parse_json");
     return json::parse(response_body);
 }
 
@@ -403,22 +477,26 @@ json HttpClient::del(
     const std::optional<Headers>& headers
 ) {
     std::string response_body = execute_del(path, data, headers);
+    CLOB_TRACE_SCOPE("http.parse_json");
     return json::parse(response_body);
 }
 
 // ========== Low-Latency Optimizations ==========
 
 bool HttpClient::warm_connection() {
-    try {
-        // Hit a cheap endpoint to establish TCP/TLS connection
-        execute_get("/ok", std::nullopt, std::nullopt);
-        
+    // Hit a cheap endpoint on every pooled connection to establish TCP/TLS
+    bool all_ok = true;
+    for (auto& conn : pool_) {
+        std::lock_guard<std::mutex> lock(conn->mutex);
+        auto res = conn->ssl ? conn->ssl->Get("/ok") : conn->plain->Get("/ok");
+        all_ok = all_ok && res && res->status >= 200 && res->status < 300;
+    }
+    
+    if (all_ok) {
         std::lock_guard<std::mutex> lock(stats_mutex_);
         connection_warm_ = true;
-        return true;
-    } catch (...) {
-        return false;
     }
+    return all_ok;
 }
 
 void HttpClient::start_heartbeat(int interval_seconds) {
@@ -438,11 +516,15 @@ void HttpClient::start_heartbeat(int interval_seconds) {
                 break;
             }
             
-            // Send lightweight GET to keep connection alive
-            try {
-                execute_get("/ok", std::nullopt, std::nullopt);
-            } catch (...) {
-                // Ignore errors in heartbeat
+            // Send lightweight GET on each idle connection; busy ones are
+            // being kept alive by traffic. Errors are only counted.
+            for (auto& conn : pool_) {
+                std::unique_lock<std::mutex> lock(conn->mutex, std::try_to_lock);
+                if (!lock.owns_lock()) {
+                    continue;
+                }
+                auto res = conn->ssl ? conn->ssl->Get("/ok") : conn->plain->Get("/ok");
+                metrics::record_heartbeat(res && res->status >= 200 && res->status < 300);
             }
         }
     });
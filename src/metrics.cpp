@@ -0,0 +1,436 @@
+#include "clob/metrics.hpp"
+#include <httplib.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace clob {
+namespace metrics {
+
+// ========== Histogram ==========
+
+void Histogram::observe_ns(uint64_t ns) {
+    double seconds = static_cast<double>(ns) / 1e9;
+    size_t bucket = static_cast<size_t>(
+        std::lower_bound(BOUNDS.begin(), BOUNDS.end(), seconds) - BOUNDS.begin()
+    );
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+    Snapshot snap;
+    for (size_t i = 0; i < buckets_.size(); ++i) {
+        snap.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+    snap.count = count_.load(std::memory_order_relaxed);
+    snap.sum_seconds = static_cast<double>(sum_ns_.load(std::memory_order_relaxed)) / 1e9;
+    return snap;
+}
+
+void Histogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_ns_.store(0, std::memory_order_relaxed);
+}
+
+namespace {
+
+constexpr size_t MAX_ENDPOINT = 64;
+constexpr size_t TABLE_SIZE = 512;  // request series slots (power of two)
+
+// Normalized endpoint into a fixed buffer, so the hot path does not allocate
+size_t normalize_into(const std::string& path, char (&out)[MAX_ENDPOINT]) {
+    size_t end = std::min(path.find('?'), path.size());
+    size_t len = 0;
+    size_t pos = 0;
+    while (pos < end && len < MAX_ENDPOINT - 1) {
+        if (path[pos] == '/') {
+            out[len++] = '/';
+            ++pos;
+            continue;
+        }
+        size_t next = std::min(path.find('/', pos), end);
+        bool hex_id = next - pos > 2 && path[pos] == '0' && (path[pos + 1] == 'x' || path[pos + 1] == 'X');
+        auto first = path.begin() + static_cast<std::ptrdiff_t>(pos);
+        auto last = path.begin() + static_cast<std::ptrdiff_t>(next);
+        bool numeric_id = next - pos >= 6 && std::all_of(first, last, [](char c) { return c >= '0' && c <= '9'; });
+        // Keys, tokens and UUIDs: long and mixing letters with digits
+        bool opaque_id = next - pos >= 16 &&
+            std::any_of(first, last, [](char c) { return c >= '0' && c <= '9'; }) &&
+            std::any_of(first, last, [](char c) { return (c | 0x20) >= 'a' && (c | 0x20) <= 'z'; });
+        bool id = hex_id || numeric_id || opaque_id;
+        const char* segment = id ? ":id" : path.data() + pos;
+        size_t segment_len = id ? 3 : next - pos;
+        segment_len = std::min(segment_len, MAX_ENDPOINT - 1 - len);
+        std::memcpy(out + len, segment, segment_len);
+        len += segment_len;
+        pos = next;
+    }
+    out[len] = '\0';
+    return len;
+}
+
+struct RequestSeries {
+    RequestSeries(const char* method, const char* endpoint, size_t endpoint_len, int status)
+        : method(method), endpoint(endpoint, endpoint_len), status(status) {}
+
+    // Immutable once published
+    const std::string method;
+    const std::string endpoint;
+    const int status;
+
+    std::atomic<uint64_t> count{0};
+    Histogram latency;
+};
+
+struct Registry {
+    std::array<std::atomic<RequestSeries*>, TABLE_SIZE> requests{};
+    RequestSeries overflow{"OTHER", "other", 5, 0};  // when the table is full
+
+    std::array<std::atomic<uint64_t>, 3> cache_hits{};
+    std::array<std::atomic<uint64_t>, 3> cache_misses{};
+    Histogram signing;
+    std::atomic<uint64_t> orders_posted{0};
+    std::atomic<uint64_t> orders_filled{0};
+    std::atomic<uint64_t> orders_rejected{0};
+    std::atomic<uint64_t> transport_errors{0};
+    std::atomic<uint64_t> heartbeats_ok{0};
+    std::atomic<uint64_t> heartbeats_failed{0};
+    std::atomic<int64_t> pool_connections{0};
+    std::atomic<int64_t> pool_in_use{0};
+    std::atomic<uint64_t> pool_waits{0};
+    Histogram pool_wait;
+
+    ~Registry() {
+        for (auto& slot : requests) {
+            delete slot.load();
+        }
+    }
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+uint64_t series_hash(const char* method, const char* endpoint, size_t len, int status) {
+    uint64_t h = 1469598103934665603ULL;  // FNV-1a
+    auto mix = [&h](const char* data, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            h ^= static_cast<uint8_t>(data[i]);
+            h *= 1099511628211ULL;
+        }
+    };
+    mix(method, std::strlen(method));
+    mix(endpoint, len);
+    mix(reinterpret_cast<const char*>(&status), sizeof(status));
+    return h;
+}
+
+bool matches(const RequestSeries& series, const char* method, const char* endpoint, size_t len, int status) {
+    return series.status == status && series.method == method &&
+           series.endpoint.size() == len && std::memcmp(series.endpoint.data(), endpoint, len) == 0;
+}
+
+// Find or publish the series; linear probing, insert by CAS on an empty slot
+RequestSeries& find_series(const char* method, const std::string& path, int status) {
+    char endpoint[MAX_ENDPOINT];
+    size_t len = normalize_into(path, endpoint);
+    Registry& reg = registry();
+
+    uint64_t h = series_hash(method, endpoint, len, status);
+    for (size_t probe = 0; probe < TABLE_SIZE; ++probe) {
+        auto& slot = reg.requests[(h + probe) & (TABLE_SIZE - 1)];
+        RequestSeries* series = slot.load(std::memory_order_acquire);
+        if (!series) {
+            auto created = std::make_unique<RequestSeries>(method, endpoint, len, status);
+            if (slot.compare_exchange_strong(series, created.get(), std::memory_order_acq_rel)) {
+                return *created.release();
+            }
+            // Lost the race: series now holds the winner
+        }
+        if (matches(*series, method, endpoint, len, status)) {
+            return *series;
+        }
+    }
+    return reg.overflow;
+}
+
+size_t cache_index(Cache cache) {
+    return static_cast<size_t>(cache);
+}
+
+CacheSnapshot cache_snapshot(const Registry& reg, Cache cache) {
+    CacheSnapshot snap;
+    snap.hits = reg.cache_hits[cache_index(cache)].load(std::memory_order_relaxed);
+    snap.misses = reg.cache_misses[cache_index(cache)].load(std::memory_order_relaxed);
+    return snap;
+}
+
+// ========== Prometheus rendering ==========
+
+std::string format_double(double value) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.9g", value);
+    return buf;
+}
+
+std::string escape_label(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            out += '\\';
+        } else if (c == '\n') {
+            out += "\\n";
+            continue;
+        }
+        out += c;
+    }
+    return out;
+}
+
+void write_header(std::ostringstream& out, const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << " " << help << "\n# TYPE " << name << " " << type << "\n";
+}
+
+void write_histogram(std::ostringstream& out, const std::string& name, const std::string& labels,
+                     const Histogram::Snapshot& snap) {
+    std::string prefix = labels.empty() ? "{" : "{" + labels + ",";
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < Histogram::BOUNDS.size(); ++i) {
+        cumulative += snap.buckets[i];
+        out << name << "_bucket" << prefix << "le=\"" << format_double(Histogram::BOUNDS[i]) << "\"} "
+            << cumulative << "\n";
+    }
+    // Derived from the buckets so +Inf and _count agree under concurrent writes
+    cumulative += snap.buckets.back();
+    out << name << "_bucket" << prefix << "le=\"+Inf\"} " << cumulative << "\n";
+    std::string suffix = labels.empty() ? "" : "{" + labels + "}";
+    out << name << "_sum" << suffix << " " << format_double(snap.sum_seconds) << "\n";
+    out << name << "_count" << suffix << " " << cumulative << "\n";
+}
+
+} // namespace
+
+// ========== Recording ==========
+
+void record_request(const char* method, const std::string& path, int status, uint64_t latency_ns) {
+    RequestSeries& series = find_series(method, path, status);
+    series.count.fetch_add(1, std::memory_order_relaxed);
+    series.latency.observe_ns(latency_ns);
+    if (status == 0) {
+        registry().transport_errors.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void record_cache(Cache cache, bool hit) {
+    auto& counters = hit ? registry().cache_hits : registry().cache_misses;
+    counters[cache_index(cache)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void record_signing(uint64_t ns) {
+    registry().signing.observe_ns(ns);
+}
+
+void record_orders(uint64_t posted, uint64_t filled, uint64_t rejected) {
+    Registry& reg = registry();
+    reg.orders_posted.fetch_add(posted, std::memory_order_relaxed);
+    reg.orders_filled.fetch_add(filled, std::memory_order_relaxed);
+    reg.orders_rejected.fetch_add(rejected, std::memory_order_relaxed);
+}
+
+void record_heartbeat(bool ok) {
+    (ok ? registry().heartbeats_ok : registry().heartbeats_failed).fetch_add(1, std::memory_order_relaxed);
+}
+
+void record_pool_size(int64_t delta) {
+    registry().pool_connections.fetch_add(delta, std::memory_order_relaxed);
+}
+
+void record_pool_in_use(int64_t delta) {
+    registry().pool_in_use.fetch_add(delta, std::memory_order_relaxed);
+}
+
+void record_pool_wait(uint64_t ns) {
+    Registry& reg = registry();
+    reg.pool_waits.fetch_add(1, std::memory_order_relaxed);
+    reg.pool_wait.observe_ns(ns);
+}
+
+// ========== Reading ==========
+
+Snapshot snapshot() {
+    Registry& reg = registry();
+    Snapshot snap;
+
+    auto add_series = [&snap](const RequestSeries& series) {
+        uint64_t count = series.count.load(std::memory_order_relaxed);
+        if (count == 0) {
+            return;
+        }
+        RequestSnapshot request;
+        request.method = series.method;
+        request.endpoint = series.endpoint;
+        request.status = series.status;
+        request.count = count;
+        request.latency = series.latency.snapshot();
+        snap.requests.push_back(std::move(request));
+    };
+    for (const auto& slot : reg.requests) {
+        if (const RequestSeries* series = slot.load(std::memory_order_acquire)) {
+            add_series(*series);
+        }
+    }
+    add_series(reg.overflow);
+    std::sort(snap.requests.begin(), snap.requests.end(), [](const RequestSnapshot& a, const RequestSnapshot& b) {
+        return std::tie(a.endpoint, a.method, a.status) < std::tie(b.endpoint, b.method, b.status);
+    });
+
+    snap.tick_size = cache_snapshot(reg, Cache::TICK_SIZE);
+    snap.neg_risk = cache_snapshot(reg, Cache::NEG_RISK);
+    snap.fee_rate = cache_snapshot(reg, Cache::FEE_RATE);
+    snap.signing = reg.signing.snapshot();
+    snap.orders_posted = reg.orders_posted.load(std::memory_order_relaxed);
+    snap.orders_filled = reg.orders_filled.load(std::memory_order_relaxed);
+    snap.orders_rejected = reg.orders_rejected.load(std::memory_order_relaxed);
+    snap.transport_errors = reg.transport_errors.load(std::memory_order_relaxed);
+    snap.heartbeats_ok = reg.heartbeats_ok.load(std::memory_order_relaxed);
+    snap.heartbeats_failed = reg.heartbeats_failed.load(std::memory_order_relaxed);
+    snap.pool_connections = reg.pool_connections.load(std::memory_order_relaxed);
+    snap.pool_in_use = reg.pool_in_use.load(std::memory_order_relaxed);
+    snap.pool_waits = reg.pool_waits.load(std::memory_order_relaxed);
+    snap.pool_wait = reg.pool_wait.snapshot();
+    return snap;
+}
+
+std::string prometheus_text() {
+    Snapshot snap = snapshot();
+    std::ostringstream out;
+
+    write_header(out, "clob_http_requests_total", "counter", "HTTP requests by endpoint and status (0: no response)");
+    for (const auto& request : snap.requests) {
+        out << "clob_http_requests_total{method=\"" << request.method << "\",endpoint=\""
+            << escape_label(request.endpoint) << "\",status=\"" << request.status << "\"} " << request.count << "\n";
+    }
+    write_header(out, "clob_http_request_duration_seconds", "histogram", "HTTP round trip time");
+    for (const auto& request : snap.requests) {
+        write_histogram(out, "clob_http_request_duration_seconds",
+                        "method=\"" + request.method + "\",endpoint=\"" + escape_label(request.endpoint) +
+                            "\",status=\"" + std::to_string(request.status) + "\"",
+                        request.latency);
+    }
+    write_header(out, "clob_http_transport_errors_total", "counter", "Requests that got no HTTP response");
+    out << "clob_http_transport_errors_total " << snap.transport_errors << "\n";
+
+    write_header(out, "clob_metadata_cache_requests_total", "counter", "Market metadata lookups by cache and result");
+    const std::pair<const char*, const CacheSnapshot*> caches[] = {
+        {"tick_size", &snap.tick_size}, {"neg_risk", &snap.neg_risk}, {"fee_rate", &snap.fee_rate}
+    };
+    for (const auto& [name, cache] : caches) {
+        out << "clob_metadata_cache_requests_total{cache=\"" << name << "\",result=\"hit\"} " << cache->hits << "\n";
+        out << "clob_metadata_cache_requests_total{cache=\"" << name << "\",result=\"miss\"} " << cache->misses << "\n";
+    }
+
+    write_header(out, "clob_order_signing_seconds", "histogram", "EIP-712 hash and signature per order");
+    write_histogram(out, "clob_order_signing_seconds", "", snap.signing);
+
+    write_header(out, "clob_orders_total", "counter", "Orders posted, and their outcome");
+    out << "clob_orders_total{result=\"posted\"} " << snap.orders_posted << "\n";
+    out << "clob_orders_total{result=\"filled\"} " << snap.orders_filled << "\n";
+    out << "clob_orders_total{result=\"rejected\"} " << snap.orders_rejected << "\n";
+
+    write_header(out, "clob_heartbeats_total", "counter", "Keep-alive pings by result");
+    out << "clob_heartbeats_total{result=\"ok\"} " << snap.heartbeats_ok << "\n";
+    out << "clob_heartbeats_total{result=\"error\"} " << snap.heartbeats_failed << "\n";
+
+    write_header(out, "clob_pool_connections", "gauge", "Pooled HTTP connections");
+    out << "clob_pool_connections " << snap.pool_connections << "\n";
+    write_header(out, "clob_pool_connections_in_use", "gauge", "Pooled connections executing a request");
+    out << "clob_pool_connections_in_use " << snap.pool_in_use << "\n";
+    write_header(out, "clob_pool_wait_seconds", "histogram", "Time queued for a busy connection");
+    write_histogram(out, "clob_pool_wait_seconds", "", snap.pool_wait);
+
+    return out.str();
+}
+
+void reset() {
+    Registry& reg = registry();
+    auto reset_series = [](RequestSeries& series) {
+        series.count.store(0, std::memory_order_relaxed);
+        series.latency.reset();
+    };
+    for (auto& slot : reg.requests) {
+        if (RequestSeries* series = slot.load(std::memory_order_acquire)) {
+            reset_series(*series);
+        }
+    }
+    reset_series(reg.overflow);
+
+    for (size_t i = 0; i < reg.cache_hits.size(); ++i) {
+        reg.cache_hits[i].store(0, std::memory_order_relaxed);
+        reg.cache_misses[i].store(0, std::memory_order_relaxed);
+    }
+    reg.signing.reset();
+    reg.orders_posted.store(0, std::memory_order_relaxed);
+    reg.orders_filled.store(0, std::memory_order_relaxed);
+    reg.orders_rejected.store(0, std::memory_order_relaxed);
+    reg.transport_errors.store(0, std::memory_order_relaxed);
+    reg.heartbeats_ok.store(0, std::memory_order_relaxed);
+    reg.heartbeats_failed.store(0, std::memory_order_relaxed);
+    reg.pool_waits.store(0, std::memory_order_relaxed);
+    reg.pool_wait.reset();
+}
+
+std::string normalize_endpoint(const std::string& path) {
+    char endpoint[MAX_ENDPOINT];
+    size_t len = normalize_into(path, endpoint);
+    return std::string(endpoint, len);
+}
+
+// ========== MetricsServer ==========
+
+MetricsServer::MetricsServer() : server_(std::make_unique<httplib::Server>()) {
+    server_->Get("/metrics", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content(prometheus_text(), "text/plain; version=0.0.4");
+    });
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+int MetricsServer::start(const std::string& host, int port) {
+    if (thread_.joinable()) {
+        throw std::runtime_error("MetricsServer already started");
+    }
+    if (port == 0) {
+        port_ = server_->bind_to_any_port(host);
+    } else {
+        port_ = server_->bind_to_port(host, port) ? port : -1;
+    }
+    if (port_ <= 0) {
+        throw std::runtime_error("MetricsServer cannot bind " + host + ":" + std::to_string(port));
+    }
+
+    thread_ = std::thread([this]() { server_->listen_after_bind(); });
+    server_->wait_until_ready();
+    return port_;
+}
+
+void MetricsServer::stop() {
+    server_->stop();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+} // namespace metrics
+} // namespace clob
@@ -1,13 +1,91 @@
 #include "clob/order_builder.hpp"
 #include "clob/constants.hpp"
 #include "clob/utilities.hpp"
-#include "clob/eip712.hpp"
+#include "clob/eip712_struct.hpp"
+#include "clob/hex.hpp"
+#include "clob/metrics.hpp"
+#include "clob/trace.hpp"
 #include <stdexcept>
 #include <ctime>
 #include <random>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 namespace clob {
 
+namespace {
+
+// Workers for SignatureVerification::Parallel, shared by every builder.
+// A recovery costs tens of microseconds, about as much as starting and
+// joining a thread, so checks are queued to long-lived workers instead.
+class VerifierPool {
+public:
+    static VerifierPool& instance() {
+        static VerifierPool pool;
+        return pool;
+    }
+    
+    std::shared_future<bool> submit(std::function<bool()> check) {
+        std::packaged_task<bool()> task(std::move(check));
+        auto result = task.get_future().share();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(task));
+        }
+        cv_.notify_one();
+        return result;
+    }
+    
+    ~VerifierPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+private:
+    static constexpr unsigned MAX_WORKERS = 2;
+    
+    VerifierPool() {
+        unsigned workers = std::max(1u, std::min(MAX_WORKERS, std::thread::hardware_concurrency() / 2));
+        for (unsigned i = 0; i < workers; ++i) {
+            workers_.emplace_back([this]() { run(); });
+        }
+    }
+    
+    void run() {
+        while (true) {
+            std::packaged_task<bool()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) {
+                    return;  // Stopping and drained
+                }
+                task = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            task();
+        }
+    }
+    
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::packaged_task<bool()>> queue_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+};
+
+} // namespace
+
 OrderBuilder::OrderBuilder(
     std::shared_ptr<Signer> signer,
     SignatureType sig_type,
@@ -110,6 +188,7 @@ SignedOrder OrderBuilder::create_order(
     const OrderArgs& args,
     const CreateOrderOptions& options
 ) {
+    CLOB_TRACE_SCOPE("order.create");
     auto it = ROUNDING_CONFIG.find(options.tick_size);
     if (it == ROUNDING_CONFIG.end()) {
         throw std::runtime_error("Invalid tick size");
@@ -123,53 +202,8 @@ SignedOrder OrderBuilder::create_order(
     std::uniform_int_distribution<uint64_t> dis;
     uint64_t salt = dis(gen) & ((1ULL << 53) - 1);  // Mask to 53 bits
     
-    // Get contract config
-    auto contract_config = get_contract_config(signer_->get_chain_id(), options.neg_risk);
-    
-    // Build order struct for signing
-    json order_data = {
-        {"salt", std::to_string(salt)},
-        {"maker", funder_},
-        {"signer", signer_->address()},
-        {"taker", args.taker},
-        {"tokenId", args.token_id},
-        {"makerAmount", amounts.maker_amount},
-        {"takerAmount", amounts.taker_amount},
-        {"side", amounts.side},
-        {"expiration", std::to_string(args.expiration)},
-        {"nonce", std::to_string(args.nonce)},
-        {"feeRateBps", std::to_string(args.fee_rate_bps.value_or(0))},
-        {"signatureType", static_cast<uint8_t>(sig_type_)}
-    };
-    
     // EIP712 domain
-    json domain = {
-        {"name", ORDER_DOMAIN_NAME},
-        {"version", ORDER_VERSION},
-        {"chainId", signer_->get_chain_id()},
-        {"verifyingContract", contract_config.exchange}
-    };
-    
-    // EIP712 types
-    json types = {
-        {"Order", json::array({
-            {{"name", "salt"}, {"type", "uint256"}},
-            {{"name", "maker"}, {"type", "address"}},
-            {{"name", "signer"}, {"type", "address"}},
-            {{"name", "taker"}, {"type", "address"}},
-            {{"name", "tokenId"}, {"type", "uint256"}},
-            {{"name", "makerAmount"}, {"type", "uint256"}},
-            {{"name", "takerAmount"}, {"type", "uint256"}},
-            {{"name", "expiration"}, {"type", "uint256"}},
-            {{"name", "nonce"}, {"type", "uint256"}},
-            {{"name", "feeRateBps"}, {"type", "uint256"}},
-            {{"name", "side"}, {"type", "uint8"}},
-            {{"name", "signatureType"}, {"type", "uint8"}}
-        })}
-    };
-    
-    // Sign
-    std::string signature = signer_->sign_typed_data(domain, "Order", order_data, types);
+    json domain = order_domain(options.neg_risk);
     
     // Build order
     Order order;
@@ -189,9 +223,9 @@ SignedOrder OrderBuilder::create_order(
     // Build signed order
     SignedOrder signed_order;
     signed_order.order = order;
-    signed_order.signature = signature;
     signed_order.order_type = OrderType::GTC;  // Default for limit orders
     signed_order.owner = "";  // Will be filled by client when posting
+    sign_order(domain, signed_order);
     
     return signed_order;
 }
@@ -200,6 +234,7 @@ SignedOrder OrderBuilder::create_market_order(
     const MarketOrderArgs& args,
     const CreateOrderOptions& options
 ) {
+    CLOB_TRACE_SCOPE("order.create_market");
     auto it = ROUNDING_CONFIG.find(options.tick_size);
     if (it == ROUNDING_CONFIG.end()) {
         throw std::runtime_error("Invalid tick size");
@@ -217,53 +252,8 @@ SignedOrder OrderBuilder::create_market_order(
     std::uniform_int_distribution<uint64_t> dis;
     uint64_t salt = dis(gen) & ((1ULL << 53) - 1);  // Mask to 53 bits
     
-    // Get contract config
-    auto contract_config = get_contract_config(signer_->get_chain_id(), options.neg_risk);
-    
-    // Build order struct
-    json order_data = {
-        {"salt", std::to_string(salt)},
-        {"maker", funder_},
-        {"signer", signer_->address()},
-        {"taker", args.taker},
-        {"tokenId", args.token_id},
-        {"makerAmount", amounts.maker_amount},
-        {"takerAmount", amounts.taker_amount},
-        {"side", amounts.side},
-        {"expiration", "0"},  // Market orders have 0 expiration
-        {"nonce", std::to_string(args.nonce)},
-        {"feeRateBps", std::to_string(args.fee_rate_bps.value_or(0))},
-        {"signatureType", static_cast<uint8_t>(sig_type_)}
-    };
-    
     // EIP712 domain
-    json domain = {
-        {"name", ORDER_DOMAIN_NAME},
-        {"version", ORDER_VERSION},
-        {"chainId", signer_->get_chain_id()},
-        {"verifyingContract", contract_config.exchange}
-    };
-    
-    // EIP712 types
-    json types = {
-        {"Order", json::array({
-            {{"name", "salt"}, {"type", "uint256"}},
-            {{"name", "maker"}, {"type", "address"}},
-            {{"name", "signer"}, {"type", "address"}},
-            {{"name", "taker"}, {"type", "address"}},
-            {{"name", "tokenId"}, {"type", "uint256"}},
-            {{"name", "makerAmount"}, {"type", "uint256"}},
-            {{"name", "takerAmount"}, {"type", "uint256"}},
-            {{"name", "expiration"}, {"type", "uint256"}},
-            {{"name", "nonce"}, {"type", "uint256"}},
-            {{"name", "feeRateBps"}, {"type", "uint256"}},
-            {{"name", "side"}, {"type", "uint8"}},
-            {{"name", "signatureType"}, {"type", "uint8"}}
-        })}
-    };
-    
-    // Sign
-    std::string signature = signer_->sign_typed_data(domain, "Order", order_data, types);
+    json domain = order_domain(options.neg_risk);
     
     // Build order
     Order order;
@@ -283,13 +273,100 @@ SignedOrder OrderBuilder::create_market_order(
     // Build signed order
     SignedOrder signed_order;
     signed_order.order = order;
-    signed_order.signature = signature;
     signed_order.order_type = args.order_type;
     signed_order.owner = "";  // Will be filled by client when posting
+    sign_order(domain, signed_order);
     
     return signed_order;
 }
 
+json OrderBuilder::order_domain(bool neg_risk) const {
+    auto contract_config = get_contract_config(signer_->get_chain_id(), neg_risk);
+    return {
+        {"name", ORDER_DOMAIN_NAME},
+        {"version", ORDER_VERSION},
+        {"chainId", signer_->get_chain_id()},
+        {"verifyingContract", contract_config.exchange}
+    };
+}
+
+void OrderBuilder::sign_order(const json& domain, SignedOrder& signed_order) {
+    auto sign_start = std::chrono::steady_clock::now();
+    CLOB_TRACE_SPAN(hashing, "order.hash");
+    auto hash = eip712::signing_hash(eip712::hash_domain(domain), signed_order.order);
+    CLOB_TRACE_END(hashing);
+    
+    CLOB_TRACE_SPAN(signing, "order.sign");
+    signed_order.signature = signer_->sign(hash);
+    CLOB_TRACE_END(signing);
+    metrics::record_signing(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - sign_start).count()));
+    
+    apply_verification(hash, signed_order);
+}
+
+void OrderBuilder::verify_order(SignedOrder& signed_order, bool neg_risk) {
+    auto hash = eip712::signing_hash(eip712::hash_domain(order_domain(neg_risk)), signed_order.order);
+    apply_verification(hash, signed_order);
+}
+
+void OrderBuilder::apply_verification(const std::array<uint8_t, 32>& hash, SignedOrder& signed_order) {
+    switch (verification_) {
+        case SignatureVerification::Off:
+            break;
+        case SignatureVerification::Blocking:
+            if (!verify_signature(signed_order.order.signer, hash, signed_order.signature, *counters_)) {
+                throw std::runtime_error("Order signature does not recover to order signer " +
+                                         signed_order.order.signer);
+            }
+            break;
+        case SignatureVerification::Parallel:
+            // Runs while the caller serializes and sends the order
+            signed_order.verification = VerifierPool::instance().submit(
+                [expected = signed_order.order.signer, counters = counters_, hash,
+                 signature = signed_order.signature]() {
+                    return verify_signature(expected, hash, signature, *counters);
+                }
+            );
+            break;
+    }
+}
+
+bool OrderBuilder::verify_signature(
+    const std::string& expected_signer,
+    const std::array<uint8_t, 32>& hash,
+    const std::string& signature,
+    VerificationCounters& counters
+) {
+    CLOB_TRACE_SCOPE("order.verify");
+    auto start = std::chrono::steady_clock::now();
+    bool ok = false;
+    try {
+        ok = Signer::recover_address(hash, signature) == hex::decode_array<20>(expected_signer);
+    } catch (const std::exception&) {
+        // Malformed signature or signer address
+    }
+    auto ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    
+    counters.count++;
+    counters.total_ns += ns;
+    if (!ok) counters.failures++;
+    uint64_t prev = counters.max_ns.load();
+    while (ns > prev && !counters.max_ns.compare_exchange_weak(prev, ns)) {}
+    
+    return ok;
+}
+
+OrderBuilder::VerificationStats OrderBuilder::get_verification_stats() const {
+    VerificationStats stats;
+    stats.count = counters_->count.load();
+    stats.failures = counters_->failures.load();
+    stats.total_ns = counters_->total_ns.load();
+    stats.max_ns = counters_->max_ns.load();
+    return stats;
+}
+
 double OrderBuilder::calculate_buy_market_price(
     const std::vector<OrderSummary>& positions,
     double amount_to_match,
@@ -0,0 +1,79 @@
+#include "clob/secp256k1_context.hpp"
+#include <openssl/rand.h>
+#include <array>
+#include <stdexcept>
+
+namespace clob {
+namespace secp256k1_ctx {
+
+namespace {
+
+void randomize(secp256k1_context* ctx) {
+    std::array<unsigned char, 32> seed;
+    if (RAND_bytes(seed.data(), static_cast<int>(seed.size())) != 1) {
+        throw std::runtime_error("Failed to generate secp256k1 randomization seed");
+    }
+    if (!secp256k1_context_randomize(ctx, seed.data())) {
+        throw std::runtime_error("Failed to randomize secp256k1 context");
+    }
+}
+
+secp256k1_context* create_shared() {
+    secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    if (!ctx) {
+        throw std::runtime_error("Failed to create secp256k1 context");
+    }
+    try {
+        randomize(ctx);
+    } catch (...) {
+        secp256k1_context_destroy(ctx);
+        throw;
+    }
+    return ctx;
+}
+
+// Owns one thread's clone
+struct LocalContext {
+    secp256k1_context* ctx = nullptr;
+
+    LocalContext() {
+        ctx = secp256k1_context_clone(shared());
+        if (!ctx) {
+            throw std::runtime_error("Failed to clone secp256k1 context");
+        }
+        try {
+            randomize(ctx);
+        } catch (...) {
+            secp256k1_context_destroy(ctx);
+            throw;
+        }
+    }
+
+    ~LocalContext() {
+        secp256k1_context_destroy(ctx);
+    }
+
+    LocalContext(const LocalContext&) = delete;
+    LocalContext& operator=(const LocalContext&) = delete;
+};
+
+} // namespace
+
+const secp256k1_context* shared() {
+    // Intentionally never destroyed: thread-local clones may outlive static
+    // destruction order on exiting threads
+    static secp256k1_context* ctx = create_shared();
+    return ctx;
+}
+
+secp256k1_context* local() {
+    thread_local LocalContext context;
+    return context.ctx;
+}
+
+void rerandomize_local() {
+    randomize(local());
+}
+
+} // namespace secp256k1_ctx
+} // namespace clob
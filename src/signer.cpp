@@ -1,40 +1,37 @@
 #include "clob/signer.hpp"
 #include "clob/eip712.hpp"
+#include "clob/hex.hpp"
+#include "clob/secp256k1_context.hpp"
+#include "clob/utilities.hpp"
 #include <stdexcept>
-#include <sstream>
-#include <iomanip>
 #include <cstring>
+#include <algorithm>
 
 namespace clob {
 
 Signer::Signer(const std::string& private_key_hex, uint64_t chain_id)
     : chain_id_(chain_id) {
     
-    // Create secp256k1 context
-    ctx_ = secp256k1_context_create(SECP256K1_CONTEXT_SIGN);
-    if (!ctx_) {
-        throw std::runtime_error("Failed to create secp256k1 context");
-    }
+    // Shared, pre-randomized context; no per-Signer context creation
+    const secp256k1_context* ctx = secp256k1_ctx::shared();
     
-    // Parse private key
-    auto key_bytes = eip712::hex_to_bytes(private_key_hex);
-    if (key_bytes.size() != 32) {
-        secp256k1_context_destroy(ctx_);
+    // Parse private key straight into place
+    auto key_digits = hex::strip_prefix(private_key_hex);
+    if (key_digits.size() != 64) {
         throw std::runtime_error("Invalid private key length");
     }
-    
-    std::copy(key_bytes.begin(), key_bytes.end(), private_key_.begin());
+    if (!hex::decode_to(key_digits, private_key_.data())) {
+        throw std::runtime_error("Invalid private key");
+    }
     
     // Verify private key is valid
-    if (!secp256k1_ec_seckey_verify(ctx_, private_key_.data())) {
-        secp256k1_context_destroy(ctx_);
+    if (!secp256k1_ec_seckey_verify(ctx, private_key_.data())) {
         throw std::runtime_error("Invalid private key");
     }
     
     // Derive public key and address
     secp256k1_pubkey pubkey;
-    if (!secp256k1_ec_pubkey_create(ctx_, &pubkey, private_key_.data())) {
-        secp256k1_context_destroy(ctx_);
+    if (!secp256k1_ec_pubkey_create(secp256k1_ctx::local(), &pubkey, private_key_.data())) {
         throw std::runtime_error("Failed to derive public key");
     }
     
@@ -42,28 +39,23 @@ Signer::Signer(const std::string& private_key_hex, uint64_t chain_id)
     size_t pub_len = 65;
     std::vector<uint8_t> pub_bytes(pub_len);
     secp256k1_ec_pubkey_serialize(
-        ctx_, pub_bytes.data(), &pub_len, &pubkey, 
+        ctx, pub_bytes.data(), &pub_len, &pubkey, 
         SECP256K1_EC_UNCOMPRESSED
     );
     
-    address_ = compute_address(pub_bytes);
-}
-
-Signer::~Signer() {
-    if (ctx_) {
-        secp256k1_context_destroy(ctx_);
-    }
-}
-
-std::string Signer::address() const {
-    return address_;
+    // All address forms are derived once; hot paths reference them
+    address_bytes_ = compute_address(pub_bytes);
+    address_ = hex::encode(address_bytes_);
+    checksum_address_ = utils::to_checksum_address(address_);
 }
 
 std::string Signer::sign(const std::array<uint8_t, 32>& message_hash) const {
     secp256k1_ecdsa_recoverable_signature sig;
     
+    // Per-thread clone: concurrent signers never share a mutable context
+    secp256k1_context* ctx = secp256k1_ctx::local();
     if (!secp256k1_ecdsa_sign_recoverable(
-            ctx_, &sig, message_hash.data(), private_key_.data(),
+            ctx, &sig, message_hash.data(), private_key_.data(),
             nullptr, nullptr)) {
         throw std::runtime_error("Failed to sign message");
     }
@@ -72,15 +64,15 @@ std::string Signer::sign(const std::array<uint8_t, 32>& message_hash) const {
     std::array<uint8_t, 64> compact;
     int recid;
     secp256k1_ecdsa_recoverable_signature_serialize_compact(
-        ctx_, compact.data(), &recid, &sig
+        ctx, compact.data(), &recid, &sig
     );
     
     // Format as Ethereum signature (r + s + v)
-    std::vector<uint8_t> signature;
-    signature.insert(signature.end(), compact.begin(), compact.end());
-    signature.push_back(static_cast<uint8_t>(recid + 27));  // v = recid + 27
+    std::array<uint8_t, 65> signature;
+    std::copy(compact.begin(), compact.end(), signature.begin());
+    signature[64] = static_cast<uint8_t>(recid + 27);  // v = recid + 27
     
-    return eip712::bytes_to_hex(signature);
+    return hex::encode(signature);
 }
 
 Signer::SignatureComponents Signer::sign_hash(const std::vector<uint8_t>& hash) const {
@@ -88,10 +80,17 @@ Signer::SignatureComponents Signer::sign_hash(const std::vector<uint8_t>& hash)
         throw std::runtime_error("Hash must be 32 bytes");
     }
     
+    std::array<uint8_t, 32> hash_arr;
+    std::copy(hash.begin(), hash.end(), hash_arr.begin());
+    return sign_hash(hash_arr);
+}
+
+Signer::SignatureComponents Signer::sign_hash(const std::array<uint8_t, 32>& hash) const {
     secp256k1_ecdsa_recoverable_signature sig;
     
+    secp256k1_context* ctx = secp256k1_ctx::local();
     if (!secp256k1_ecdsa_sign_recoverable(
-            ctx_, &sig, hash.data(), private_key_.data(),
+            ctx, &sig, hash.data(), private_key_.data(),
             nullptr, nullptr)) {
         throw std::runtime_error("Failed to sign hash");
     }
@@ -100,7 +99,7 @@ Signer::SignatureComponents Signer::sign_hash(const std::vector<uint8_t>& hash)
     std::array<uint8_t, 64> compact;
     int recid;
     secp256k1_ecdsa_recoverable_signature_serialize_compact(
-        ctx_, compact.data(), &recid, &sig
+        ctx, compact.data(), &recid, &sig
     );
     
     SignatureComponents result;
@@ -121,7 +120,42 @@ std::string Signer::sign_typed_data(
     return sign(hash);
 }
 
-std::string Signer::compute_address(const std::vector<uint8_t>& public_key) {
+std::array<uint8_t, 20> Signer::recover_address(
+    const std::array<uint8_t, 32>& message_hash,
+    const std::string& signature_hex
+) {
+    auto signature = hex::decode_array<65>(signature_hex);
+    int recid = signature[64] >= 27 ? signature[64] - 27 : signature[64];
+    if (recid < 0 || recid > 3) {
+        throw std::runtime_error("Invalid signature recovery id");
+    }
+    
+    const secp256k1_context* ctx = secp256k1_ctx::shared();
+    secp256k1_ecdsa_recoverable_signature sig;
+    if (!secp256k1_ecdsa_recoverable_signature_parse_compact(ctx, &sig, signature.data(), recid)) {
+        throw std::runtime_error("Invalid signature encoding");
+    }
+    
+    secp256k1_pubkey pubkey;
+    if (!secp256k1_ecdsa_recover(ctx, &pubkey, &sig, message_hash.data())) {
+        throw std::runtime_error("Failed to recover public key");
+    }
+    
+    size_t pub_len = 65;
+    std::vector<uint8_t> pub_bytes(pub_len);
+    secp256k1_ec_pubkey_serialize(ctx, pub_bytes.data(), &pub_len, &pubkey, SECP256K1_EC_UNCOMPRESSED);
+    return compute_address(pub_bytes);
+}
+
+bool Signer::verify(const std::array<uint8_t, 32>& message_hash, const std::string& signature_hex) const {
+    try {
+        return recover_address(message_hash, signature_hex) == address_bytes_;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+std::array<uint8_t, 20> Signer::compute_address(const std::vector<uint8_t>& public_key) {
     if (public_key.size() != 65 || public_key[0] != 0x04) {
         throw std::runtime_error("Invalid public key format");
     }
@@ -131,9 +165,9 @@ std::string Signer::compute_address(const std::vector<uint8_t>& public_key) {
     auto hash = eip712::keccak256(key_without_prefix);
     
     // Take last 20 bytes
-    std::vector<uint8_t> addr_bytes(hash.end() - 20, hash.end());
-    
-    return eip712::bytes_to_hex(addr_bytes);
+    std::array<uint8_t, 20> address;
+    std::copy(hash.end() - 20, hash.end(), address.begin());
+    return address;
 }
 
 } // namespace clob
@@ -0,0 +1,241 @@
+#include "clob/trace.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace clob {
+namespace trace {
+
+namespace detail {
+
+std::atomic<bool> g_enabled{false};
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace detail
+
+namespace {
+
+// Single-writer ring. Each slot is a seqlock: the owning thread marks it odd
+// while writing, then publishes 2 * (index + 1); a reader keeps a copy only
+// if the sequence matched before and after, so overwritten slots are
+// skipped instead of read torn. Fields are relaxed atomics to keep the
+// concurrent read well-defined. The thread id is stored per slot because a
+// ring passes from an exited thread to a new one and holds spans of both.
+struct Slot {
+    std::atomic<uint64_t> seq{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<const char*> category{nullptr};
+    std::atomic<uint64_t> start_ns{0};
+    std::atomic<uint64_t> duration_ns{0};
+    std::atomic<uint32_t> thread_id{0};
+};
+
+struct ThreadBuffer {
+    explicit ThreadBuffer(size_t capacity) : mask(capacity - 1), slots(new Slot[capacity]) {}
+
+    size_t capacity() const { return mask + 1; }
+
+    size_t mask;
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<uint64_t> head{0};     // spans ever written
+    std::atomic<uint64_t> cleared{0};  // spans below this index were dropped by clear()
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;  // every ring, owned or not; read by collect()
+    std::vector<std::shared_ptr<ThreadBuffer>> free;     // rings of exited threads, awaiting a new owner
+    size_t capacity = 8192;
+    uint32_t next_thread_id = 1;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// A thread's claim on a ring, taken at its first span and returned to the
+// free list when the thread exits. The ring stays in the registry, so its
+// spans remain collectable until the next owner overwrites them.
+struct ThreadState {
+    ThreadState() {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        thread_id = reg.next_thread_id++;
+        auto reusable = std::find_if(reg.free.begin(), reg.free.end(), [&](const auto& ring) {
+            return ring->capacity() == reg.capacity;
+        });
+        if (reusable != reg.free.end()) {
+            buffer = *reusable;
+            reg.free.erase(reusable);
+        } else {
+            buffer = std::make_shared<ThreadBuffer>(reg.capacity);
+            reg.buffers.push_back(buffer);
+        }
+    }
+
+    ~ThreadState() {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.free.push_back(std::move(buffer));
+    }
+
+    ThreadState(const ThreadState&) = delete;
+    ThreadState& operator=(const ThreadState&) = delete;
+
+    std::shared_ptr<ThreadBuffer> buffer;
+    uint32_t thread_id = 0;
+};
+
+ThreadState& this_thread_state() {
+    thread_local ThreadState state;
+    return state;
+}
+
+std::vector<std::shared_ptr<ThreadBuffer>> snapshot_buffers() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return reg.buffers;
+}
+
+void read_buffer(const ThreadBuffer& buffer, std::vector<Event>& out) {
+    uint64_t head = buffer.head.load(std::memory_order_acquire);
+    uint64_t capacity = buffer.capacity();
+    uint64_t first = std::max(head > capacity ? head - capacity : 0,
+                              buffer.cleared.load(std::memory_order_acquire));
+
+    for (uint64_t index = first; index < head; ++index) {
+        const Slot& slot = buffer.slots[index & buffer.mask];
+        uint64_t expected = 2 * (index + 1);
+        if (slot.seq.load(std::memory_order_acquire) != expected) {
+            continue;
+        }
+        Event event;
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.category = slot.category.load(std::memory_order_relaxed);
+        event.start_ns = slot.start_ns.load(std::memory_order_relaxed);
+        event.duration_ns = slot.duration_ns.load(std::memory_order_relaxed);
+        event.thread_id = slot.thread_id.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) == expected) {
+            out.push_back(event);
+        }
+    }
+}
+
+} // namespace
+
+namespace detail {
+
+void record(const char* name, const char* category, uint64_t start_ns, uint64_t end_ns) {
+    ThreadState& state = this_thread_state();
+    ThreadBuffer& buffer = *state.buffer;
+    uint64_t index = buffer.head.load(std::memory_order_relaxed);
+    Slot& slot = buffer.slots[index & buffer.mask];
+
+    slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.start_ns.store(start_ns, std::memory_order_relaxed);
+    slot.duration_ns.store(end_ns - start_ns, std::memory_order_relaxed);
+    slot.thread_id.store(state.thread_id, std::memory_order_relaxed);
+    slot.seq.store(2 * (index + 1), std::memory_order_release);
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+} // namespace detail
+
+void enable(bool on) {
+    detail::g_enabled.store(on, std::memory_order_relaxed);
+}
+
+void set_buffer_capacity(size_t spans) {
+    if (spans == 0) {
+        throw std::runtime_error("Trace buffer capacity must be positive");
+    }
+    size_t capacity = 1;
+    while (capacity < spans) {
+        capacity <<= 1;
+    }
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.capacity = capacity;
+}
+
+size_t buffer_count() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return reg.buffers.size();
+}
+
+std::vector<Event> collect() {
+    std::vector<Event> events;
+    for (const auto& buffer : snapshot_buffers()) {
+        read_buffer(*buffer, events);
+    }
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+        return a.start_ns < b.start_ns;
+    });
+    return events;
+}
+
+void clear() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        buffer->cleared.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    // Unowned rings of a capacity no longer handed out would never be reused
+    auto stale = [&](const std::shared_ptr<ThreadBuffer>& ring) { return ring->capacity() != reg.capacity; };
+    for (const auto& ring : reg.free) {
+        if (stale(ring)) {
+            reg.buffers.erase(std::find(reg.buffers.begin(), reg.buffers.end(), ring));
+        }
+    }
+    reg.free.erase(std::remove_if(reg.free.begin(), reg.free.end(), stale), reg.free.end());
+}
+
+std::string export_chrome_json() {
+    // Timestamps are microseconds (fractional, so ns resolution is kept)
+    // relative to the earliest span
+    auto events = collect();
+    uint64_t origin = events.empty() ? 0 : events.front().start_ns;
+
+    nlohmann::json trace_events = nlohmann::json::array();
+    for (const auto& event : events) {
+        trace_events.push_back({
+            {"name", event.name},
+            {"cat", event.category},
+            {"ph", "X"},
+            {"ts", static_cast<double>(event.start_ns - origin) / 1000.0},
+            {"dur", static_cast<double>(event.duration_ns) / 1000.0},
+            {"pid", 1},
+            {"tid", event.thread_id}
+        });
+    }
+    return nlohmann::json{
+        {"traceEvents", trace_events},
+        {"displayTimeUnit", "ns"}
+    }.dump();
+}
+
+void write_chrome_json(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open trace file: " + path);
+    }
+    file << export_chrome_json();
+}
+
+} // namespace trace
+} // namespace clob
@@ -1,11 +1,17 @@
 #include "clob/utilities.hpp"
 #include "clob/eip712.hpp"
+#include "clob/hex.hpp"
 #include <cmath>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 #include <cctype>
 #include <stdexcept>
+#include <vector>
+#include <openssl/hmac.h>
+#include <openssl/evp.h>
+#include <openssl/bio.h>
+#include <openssl/buffer.h>
 
 namespace clob {
 namespace utils {
@@ -803,7 +809,7 @@ std::string generate_orderbook_summary_hash(const OrderBookSummaryResponse& orde
     std::vector<uint8_t> data(json_str.begin(), json_str.end());
     auto hash = eip712::keccak256(data);
     
-    return eip712::bytes_to_hex(std::vector<uint8_t>(hash.begin(), hash.end()));
+    return hex::encode(hash);
 }
 
 std::string to_checksum_address(const std::string& address) {
@@ -835,6 +841,77 @@ std::string to_checksum_address(const std::string& address) {
     return result;
 }
 
+// ========== L2 Authentication ==========
+
+std::string build_hmac_signature(
+    const std::string& secret,
+    int64_t timestamp,
+    const std::string& method,
+    const std::string& request_path,
+    const std::string& body
+) {
+    // Build message: timestamp + method + path + body
+    std::string message = std::to_string(timestamp) + method + request_path + body;
+    
+    // HMAC-SHA256
+    unsigned char hmac_result[32];
+    
+    // Decode URL-safe base64 secret (API secret uses URL-safe base64: - and _ instead of + and /)
+    std::string secret_copy = secret;
+    // Convert URL-safe base64 to standard base64
+    for (char& c : secret_copy) {
+        if (c == '-') c = '+';
+        if (c == '_') c = '/';
+    }
+    // Add padding if needed
+    while (secret_copy.length() % 4 != 0) {
+        secret_copy += '=';
+    }
+    
+    BIO* bio_decode = BIO_new_mem_buf(secret_copy.data(), secret_copy.length());
+    BIO* b64_decode = BIO_new(BIO_f_base64());
+    BIO_set_flags(b64_decode, BIO_FLAGS_BASE64_NO_NL);
+    bio_decode = BIO_push(b64_decode, bio_decode);
+    
+    std::vector<uint8_t> decoded_secret(256);  // Max size
+    int decoded_len = BIO_read(bio_decode, decoded_secret.data(), 256);
+    BIO_free_all(bio_decode);
+    
+    if (decoded_len <= 0) {
+        throw std::runtime_error("Failed to decode API secret");
+    }
+    decoded_secret.resize(decoded_len);
+    
+    // Compute HMAC
+    unsigned int hmac_len = 32;
+    HMAC(EVP_sha256(),
+         decoded_secret.data(), decoded_secret.size(),
+         reinterpret_cast<const unsigned char*>(message.data()), message.length(),
+         hmac_result, &hmac_len);
+    
+    // Base64 encode the HMAC result (URL-safe base64)
+    BIO* bio = BIO_new(BIO_s_mem());
+    BIO* b64 = BIO_new(BIO_f_base64());
+    BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
+    bio = BIO_push(b64, bio);
+    BIO_write(bio, hmac_result, hmac_len);
+    BIO_flush(bio);
+    
+    BUF_MEM* buffer_ptr;
+    BIO_get_mem_ptr(bio, &buffer_ptr);
+    std::string signature(buffer_ptr->data, buffer_ptr->length);
+    BIO_free_all(bio);
+    
+    // Convert to URL-safe base64 (+ → -, / → _)
+    // NOTE: Must keep base64 "=" padding suffix (required by API)
+    for (char& c : signature) {
+        if (c == '+') c = '-';
+        if (c == '/') c = '_';
+    }
+    
+    return signature;
+}
+
 } // namespace utils
 } // namespace clob
 
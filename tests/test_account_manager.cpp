@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+#include <clob/account_manager.hpp>
+#include <clob/signer.hpp>
+#include <httplib.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <thread>
+
+using namespace clob;
+using json = nlohmann::json;
+
+namespace {
+
+const std::string KEY_A = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+const std::string KEY_B = "0x59c6995e998f97a5a0044966f0945389dc9e86dae88c7a8412f4603b6b78690d";
+
+ApiCreds creds_for(const std::string& api_key) {
+    ApiCreds creds;
+    creds.api_key = api_key;
+    creds.api_secret = "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA=";
+    creds.api_passphrase = "passphrase-" + api_key;
+    return creds;
+}
+
+// Local CLOB stand-in: /tick-size and /auth/api-keys, recording what it sees
+class MockClobServer {
+public:
+    MockClobServer() {
+        svr_.Get("/tick-size", [this](const httplib::Request&, httplib::Response& res) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                tick_size_requests_++;
+            }
+            res.set_content(R"({"minimum_tick_size": 0.01})", "application/json");
+        });
+
+        svr_.Get("/auth/api-keys", [this](const httplib::Request& req, httplib::Response& res) {
+            std::string api_key = req.get_header_value("POLY_API_KEY");
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                addresses_by_key_[api_key] = req.get_header_value("POLY_ADDRESS");
+            }
+            res.set_content(json{{"apiKeys", json::array({api_key})}}.dump(), "application/json");
+        });
+
+        svr_.Get("/auth/derive-api-key", [this](const httplib::Request& req, httplib::Response& res) {
+            std::string address = req.get_header_value("POLY_ADDRESS");
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                derive_requests_++;
+            }
+            if (address == failing_address_) {
+                res.status = 401;
+                res.set_content(R"({"error": "Unauthorized"})", "application/json");
+                return;
+            }
+            json creds = {{"apiKey", "key-" + address}, {"secret", "c2VjcmV0"}, {"passphrase", "pass"}};
+            res.set_content(creds.dump(), "application/json");
+        });
+
+        port_ = svr_.bind_to_any_port("127.0.0.1");
+        thread_ = std::thread([this]() { svr_.listen_after_bind(); });
+        svr_.wait_until_ready();
+    }
+
+    ~MockClobServer() {
+        svr_.stop();
+        if (thread_.joinable()) thread_.join();
+    }
+
+    std::string url() const { return "http://127.0.0.1:" + std::to_string(port_); }
+
+    int tick_size_requests() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tick_size_requests_;
+    }
+
+    int derive_requests() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return derive_requests_;
+    }
+
+    void fail_derive_for(const std::string& address) { failing_address_ = address; }
+
+    std::map<std::string, std::string> addresses_by_key() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return addresses_by_key_;
+    }
+
+private:
+    httplib::Server svr_;
+    std::thread thread_;
+    int port_ = 0;
+    std::mutex mutex_;
+    int tick_size_requests_ = 0;
+    int derive_requests_ = 0;
+    std::string failing_address_;
+    std::map<std::string, std::string> addresses_by_key_;
+};
+
+} // namespace
+
+TEST(TokenBucketTest, BurstThenRefill) {
+    TokenBucket bucket(20.0, 2.0);
+    EXPECT_TRUE(bucket.try_acquire());
+    EXPECT_TRUE(bucket.try_acquire());
+    EXPECT_FALSE(bucket.try_acquire());
+
+    // One token refills in 50ms
+    auto start = std::chrono::steady_clock::now();
+    bucket.acquire();
+    auto waited = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(waited, std::chrono::milliseconds(30));
+
+    EXPECT_THROW(TokenBucket(0.0, 1.0), std::runtime_error);
+    EXPECT_THROW(bucket.acquire(5.0), std::runtime_error);
+}
+
+TEST(AccountManagerTest, RoutesEachAccountWithItsOwnL2Headers) {
+    MockClobServer server;
+    AccountManager manager(server.url());
+
+    auto signer_a = std::make_shared<Signer>(KEY_A, 137);
+    auto signer_b = std::make_shared<Signer>(KEY_B, 137);
+    manager.add_account("a", signer_a, creds_for("key-a"));
+    manager.add_account("b", signer_b, creds_for("key-b"));
+    EXPECT_THROW(manager.add_account("a", signer_a, creds_for("key-a")), std::runtime_error);
+    EXPECT_EQ(manager.size(), 2u);
+
+    auto results = manager.for_each_parallel([](const std::string&, ClobClient& client) {
+        client.get_api_keys();
+    });
+    ASSERT_EQ(results.size(), 2u);
+    for (const auto& result : results) {
+        EXPECT_TRUE(result.success) << result.name << ": " << result.error;
+    }
+
+    auto seen = server.addresses_by_key();
+    EXPECT_EQ(seen["key-a"], signer_a->address());
+    EXPECT_EQ(seen["key-b"], signer_b->address());
+
+    EXPECT_TRUE(manager.remove_account("b"));
+    EXPECT_FALSE(manager.has_account("b"));
+    EXPECT_THROW(manager.account("b"), std::runtime_error);
+}
+
+TEST(AccountManagerTest, SharesMarketMetadataAcrossAccounts) {
+    MockClobServer server;
+    AccountManager manager(server.url());
+    manager.add_account("a", std::make_shared<Signer>(KEY_A, 137), creds_for("key-a"));
+    manager.add_account("b", std::make_shared<Signer>(KEY_B, 137), creds_for("key-b"));
+
+    manager.account("a").get_tick_size("123");
+    manager.account("b").get_tick_size("123");
+    EXPECT_EQ(server.tick_size_requests(), 1);
+    EXPECT_TRUE(manager.metadata().find<TickSizeResponse>("123").has_value());
+}
+
+TEST(AccountManagerTest, EnforcesPerAccountRateLimit) {
+    MockClobServer server;
+    AccountManager manager(server.url());
+    auto& slow = manager.add_account("slow", std::make_shared<Signer>(KEY_A, 137), creds_for("key-a"), 10.0, 1.0);
+    auto& fast = manager.add_account("fast", std::make_shared<Signer>(KEY_B, 137), creds_for("key-b"), 1000.0, 10.0);
+
+    // The slow account waits ~100ms per request after its first
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 3; ++i) slow.get_api_keys();
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(150));
+
+    // The other account's bucket is unaffected
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 3; ++i) fast.get_api_keys();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(150));
+}
+
+TEST(AccountManagerTest, PooledTransportServesConcurrentRequests) {
+    MockClobServer server;
+    AccountManager::Options options;
+    options.pool_size = 3;
+    AccountManager manager(server.url(), options);
+    EXPECT_EQ(manager.transport().pool_size(), 3u);
+
+    std::vector<std::thread> threads;
+    std::atomic<int> ok{0};
+    for (int t = 0; t < 6; ++t) {
+        threads.emplace_back([&]() {
+            auto elem = manager.transport().get_simd("/tick-size");
+            if (elem["minimum_tick_size"].get_double().value() == 0.01) ok++;
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(ok.load(), 6);
+}
+
+TEST(AccountManagerTest, DerivesCredentialsForManyWallets) {
+    MockClobServer server;
+    AccountManager manager(server.url());
+
+    std::vector<std::shared_ptr<Signer>> signers = {
+        std::make_shared<Signer>(KEY_A, 137),
+        std::make_shared<Signer>(KEY_B, 137)
+    };
+    server.fail_derive_for(signers[1]->address());
+
+    auto derived = manager.derive_api_keys(signers);
+    ASSERT_EQ(derived.creds.size(), 1u);
+    EXPECT_EQ(derived.creds[signers[0]->address()].api_key, "key-" + signers[0]->address());
+    ASSERT_EQ(derived.errors.size(), 1u);
+    EXPECT_TRUE(derived.errors.count(signers[1]->address()));
+    EXPECT_EQ(derived.from_store, 0u);
+}
+
+TEST(AccountManagerTest, WarmRestartSkipsDerivationViaCredentialStore) {
+    MockClobServer server;
+    std::string path = testing::TempDir() + "account_manager_creds.json";
+    std::remove(path.c_str());
+    CredentialStore store(path, CredentialStore::Key{42});
+
+    std::vector<std::shared_ptr<Signer>> signers = {
+        std::make_shared<Signer>(KEY_A, 137),
+        std::make_shared<Signer>(KEY_B, 137)
+    };
+
+    {
+        AccountManager manager(server.url());
+        auto derived = manager.derive_api_keys(signers, store);
+        EXPECT_EQ(derived.creds.size(), 2u);
+        EXPECT_EQ(derived.from_store, 0u);
+    }
+    EXPECT_EQ(server.derive_requests(), 2);
+
+    // A second process start finds both wallets on disk
+    AccountManager restarted(server.url());
+    auto derived = restarted.derive_api_keys(signers, store);
+    EXPECT_EQ(derived.creds.size(), 2u);
+    EXPECT_EQ(derived.from_store, 2u);
+    EXPECT_EQ(server.derive_requests(), 2);
+    EXPECT_EQ(derived.creds[signers[1]->address()].api_key, "key-" + signers[1]->address());
+}
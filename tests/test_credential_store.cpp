@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <clob/credential_store.hpp>
+#include <sys/stat.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace clob;
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+    std::string path = testing::TempDir() + name;
+    std::remove(path.c_str());
+    return path;
+}
+
+ApiCreds make_creds(const std::string& id) {
+    return ApiCreds{"key-" + id, "secret-" + id, "passphrase-" + id};
+}
+
+} // namespace
+
+TEST(CredentialStoreTest, KeyFileIsCreatedOnceAndReused) {
+    std::string key_path = temp_path("credential_store_test.key");
+    auto key = CredentialStore::load_or_create_key(key_path);
+    EXPECT_EQ(CredentialStore::load_or_create_key(key_path), key);
+}
+
+TEST(CredentialStoreTest, FilesAreOwnerOnlyRegardlessOfUmask) {
+    std::string key_path = temp_path("credential_store_mode.key");
+    // A stale world-readable tmp file must not be reused as-is
+    std::ofstream(key_path + ".tmp") << "stale";
+    chmod((key_path + ".tmp").c_str(), 0666);
+
+    mode_t old_mask = umask(0);
+    CredentialStore::load_or_create_key(key_path);
+    umask(old_mask);
+
+    struct stat st {};
+    ASSERT_EQ(stat(key_path.c_str(), &st), 0);
+    EXPECT_EQ(st.st_mode & 0777, 0600u);
+}
+
+TEST(CredentialStoreTest, RoundTripsAndMergesByLowercaseAddress) {
+    std::string path = temp_path("credential_store_roundtrip.json");
+    CredentialStore store(path, CredentialStore::Key{1, 2, 3});
+
+    EXPECT_TRUE(store.load().empty());
+
+    store.merge({{"0xABCDEF0000000000000000000000000000000001", make_creds("a")}});
+    store.merge({{"0x0000000000000000000000000000000000000002", make_creds("b")}});
+
+    auto all = store.load();
+    ASSERT_EQ(all.size(), 2u);
+    auto a = store.get("0xabcdef0000000000000000000000000000000001");
+    ASSERT_TRUE(a.has_value());
+    EXPECT_EQ(a->api_key, "key-a");
+    EXPECT_EQ(a->api_secret, "secret-a");
+    EXPECT_EQ(a->api_passphrase, "passphrase-a");
+    EXPECT_FALSE(store.get("0x0000000000000000000000000000000000000003").has_value());
+
+    // Secrets never appear in plaintext on disk
+    std::ifstream in(path);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    EXPECT_EQ(contents.str().find("secret-a"), std::string::npos);
+}
+
+TEST(CredentialStoreTest, RejectsWrongKeyAndTampering) {
+    std::string path = temp_path("credential_store_tamper.json");
+    CredentialStore store(path, CredentialStore::Key{7});
+    store.save({{"0x0000000000000000000000000000000000000001", make_creds("a")}});
+
+    EXPECT_THROW(CredentialStore(path, CredentialStore::Key{8}).load(), std::runtime_error);
+
+    // Flip one ciphertext digit
+    std::ifstream in(path);
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    auto pos = text.find("\"data\":\"") + 8;
+    text[pos] = text[pos] == '0' ? '1' : '0';
+    std::ofstream(path, std::ios::trunc) << text;
+
+    EXPECT_THROW(store.load(), std::runtime_error);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <clob/eip712.hpp>
+#include <clob/eip712_struct.hpp>
 #include <clob/signer.hpp>
 #include <nlohmann/json.hpp>
 
@@ -59,6 +60,35 @@ TEST(EIP712Test, EncodeUint256) {
     }
 }
 
+// Test decimal string uint256 encoding (token ids are 77 digits)
+TEST(EIP712Test, EncodeUint256FromDecimalString) {
+    auto token = encode_uint256("42334954850219754195241248003172889699504912694714162671145392673031415571339");
+    EXPECT_EQ(bytes_to_hex(std::vector<uint8_t>(token.begin(), token.end()), false),
+              "5d98bc3d31f1ad3ede0b4a122653ad5a1842ace677e05d91b7d143576d6aa38b");
+
+    // Crosses a 19-digit chunk boundary
+    auto mid = encode_uint256("12345678901234567890123");
+    EXPECT_EQ(bytes_to_hex(std::vector<uint8_t>(mid.begin(), mid.end()), false),
+              "00000000000000000000000000000000000000000000029d42b64e76714244cb");
+
+    EXPECT_EQ(encode_uint256("18446744073709551615"), encode_uint256(UINT64_MAX));
+    EXPECT_EQ(encode_uint256("0"), encode_uint256(uint64_t{0}));
+
+    auto max = encode_uint256("115792089237316195423570985008687907853269984665640564039457584007913129639935");
+    for (auto b : max) EXPECT_EQ(b, 0xFF);
+
+    std::array<uint8_t, 32> out{};
+    EXPECT_FALSE(parse_uint256("115792089237316195423570985008687907853269984665640564039457584007913129639936", out));
+    EXPECT_FALSE(parse_uint256("12a", out));
+    EXPECT_FALSE(parse_uint256("", out));
+    EXPECT_THROW(encode_uint256("-1"), std::runtime_error);
+
+    // Cached path returns the same encoding
+    const std::string id = "42334954850219754195241248003172889699504912694714162671145392673031415571339";
+    EXPECT_EQ(encode_token_id(id), token);
+    EXPECT_EQ(encode_token_id(id), token);
+}
+
 // Test string encoding (should hash it)
 TEST(EIP712Test, EncodeString) {
     std::string str = "Hello";
@@ -328,6 +358,110 @@ TEST(EIP712Test, CrossValidationWithPython) {
     EXPECT_EQ(signature, signature2);
 }
 
+// Static descriptors must produce the same type string and hashes as the json path
+TEST(EIP712Test, StaticClobAuthMatchesDynamic) {
+    EXPECT_EQ(
+        type_string<clob::ClobAuth>(),
+        "ClobAuth(address address,string timestamp,uint256 nonce,string message)"
+    );
+    
+    clob::ClobAuth auth;
+    auth.address = "0xf39Fd6e51aad88F6F4ce6aB8827279cffFb92266";
+    auth.timestamp = "10000000";
+    auth.nonce = 23;
+    auth.message = "This message attests that I control the given wallet";
+    
+    json message = {
+        {"address", auth.address},
+        {"timestamp", auth.timestamp},
+        {"nonce", 23},
+        {"message", auth.message}
+    };
+    json types = {
+        {"ClobAuth", json::array({
+            {{"name", "address"}, {"type", "address"}},
+            {{"name", "timestamp"}, {"type", "string"}},
+            {{"name", "nonce"}, {"type", "uint256"}},
+            {{"name", "message"}, {"type", "string"}}
+        })}
+    };
+    json domain = {
+        {"name", "ClobAuthDomain"},
+        {"version", "1"},
+        {"chainId", 80002}
+    };
+    
+    EXPECT_EQ(type_hash<clob::ClobAuth>(), type_hash("ClobAuth", types));
+    EXPECT_EQ(hash_struct(auth), hash_struct("ClobAuth", message, types));
+    
+    // Same signature as the Rust client (see FullSigningFlowWithKnownKey)
+    clob::Signer signer("0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80", 80002);
+    EXPECT_EQ(
+        signer.sign(signing_hash(hash_domain(domain), auth)),
+        "0xf62319a987514da40e57e2f4d7529f7bac38f0355bd88bb5adbb3768d80de6c1682518e0af677d5260366425f4361e7b70c25ae232aff0ab2331e2b164a1aedc1b"
+    );
+}
+
+TEST(EIP712Test, StaticOrderMatchesDynamic) {
+    clob::Order order;
+    order.salt = "12345678901234567890";
+    order.maker = "0xf39Fd6e51aad88F6F4ce6aB8827279cffFb92266";
+    order.signer = "0xf39Fd6e51aad88F6F4ce6aB8827279cffFb92266";
+    order.taker = "0x0000000000000000000000000000000000000000";
+    order.token_id = "71321045679252212594626385532706912750332728571942532289631379312455583992563";
+    order.maker_amount = "1000000";
+    order.taker_amount = "2000000";
+    order.expiration = "0";
+    order.nonce = "1";
+    order.fee_rate_bps = "0";
+    order.side = 1;
+    order.signature_type = 2;
+    
+    json message = {
+        {"salt", order.salt},
+        {"maker", order.maker},
+        {"signer", order.signer},
+        {"taker", order.taker},
+        {"tokenId", order.token_id},
+        {"makerAmount", order.maker_amount},
+        {"takerAmount", order.taker_amount},
+        {"expiration", order.expiration},
+        {"nonce", order.nonce},
+        {"feeRateBps", order.fee_rate_bps},
+        {"side", 1},
+        {"signatureType", 2}
+    };
+    json types = {
+        {"Order", json::array({
+            {{"name", "salt"}, {"type", "uint256"}},
+            {{"name", "maker"}, {"type", "address"}},
+            {{"name", "signer"}, {"type", "address"}},
+            {{"name", "taker"}, {"type", "address"}},
+            {{"name", "tokenId"}, {"type", "uint256"}},
+            {{"name", "makerAmount"}, {"type", "uint256"}},
+            {{"name", "takerAmount"}, {"type", "uint256"}},
+            {{"name", "expiration"}, {"type", "uint256"}},
+            {{"name", "nonce"}, {"type", "uint256"}},
+            {{"name", "feeRateBps"}, {"type", "uint256"}},
+            {{"name", "side"}, {"type", "uint8"}},
+            {{"name", "signatureType"}, {"type", "uint8"}}
+        })}
+    };
+    json domain = {
+        {"name", "Polymarket CTF Exchange"},
+        {"version", "1"},
+        {"chainId", 137},
+        {"verifyingContract", "0x4bFb41d5B3570DeFd03C39a9A4D8dE6Bd8B8982E"}
+    };
+    
+    EXPECT_EQ(type_hash<clob::Order>(), type_hash("Order", types));
+    EXPECT_EQ(hash_struct(order), hash_struct("Order", message, types));
+    EXPECT_EQ(signing_hash(hash_domain(domain), order), signing_hash(domain, "Order", message, types));
+    
+    order.maker = "0x1234";
+    EXPECT_THROW(hash_struct(order), std::runtime_error);
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,1093 @@
+#include <gtest/gtest.h>
+#include <clob/eth_rpc.hpp>
+#include <clob/signer.hpp>
+#include <clob/keccak.hpp>
+#include <clob/hex.hpp>
+#include <httplib.h>
+#include <thread>
+#include <mutex>
+#include <set>
+#include <map>
+#include <functional>
+#include <atomic>
+#include <cstdio>
+#include <nlohmann/json.hpp>
+
+using namespace clob;
+using json = nlohmann::json;
+
+// Local JSON-RPC stand-in for an Ethereum node
+class MockRpcServer {
+public:
+    using MethodHandler = std::function<json(const json& params)>;
+
+    explicit MockRpcServer(const std::string& path = "/") : path_(path) {
+        // Default handlers
+        on("eth_chainId", [](const json&) { return json("0x89"); });
+        on("eth_gasPrice", [](const json&) { return json("0x6fc23ac00"); });
+        on("eth_getTransactionCount", [](const json&) { return json("0x5"); });
+
+        svr_.Post(path_, [this](const httplib::Request& req, httplib::Response& res) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                remote_ports_.insert(req.remote_port);
+                request_count_++;
+            }
+
+            json request = json::parse(req.body);
+            json response;
+            if (request.is_array()) {
+                // Real nodes may answer a batch in any order; reverse it to
+                // exercise id matching on the client side
+                response = json::array();
+                for (auto it = request.rbegin(); it != request.rend(); ++it) {
+                    response.push_back(dispatch(*it));
+                }
+            } else {
+                response = dispatch(request);
+            }
+            res.set_content(response.dump(), "application/json");
+        });
+
+        port_ = svr_.bind_to_any_port("127.0.0.1");
+        thread_ = std::thread([this]() { svr_.listen_after_bind(); });
+        svr_.wait_until_ready();
+    }
+
+    ~MockRpcServer() {
+        svr_.stop();
+        if (thread_.joinable()) thread_.join();
+    }
+
+    void on(const std::string& method, MethodHandler handler) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        handlers_[method] = std::move(handler);
+    }
+
+    json dispatch(const json& request) {
+        json response = {{"jsonrpc", "2.0"}, {"id", request["id"]}};
+
+        MethodHandler handler;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = handlers_.find(request["method"].get<std::string>());
+            if (it != handlers_.end()) handler = it->second;
+        }
+
+        if (!handler) {
+            response["error"] = {{"code", -32601}, {"message", "method not found"}};
+        } else {
+            try {
+                response["result"] = handler(request["params"]);
+            } catch (const std::exception& e) {
+                response["error"] = {{"code", -32000}, {"message", e.what()}};
+            }
+        }
+        return response;
+    }
+
+    std::string url() const {
+        return "http://127.0.0.1:" + std::to_string(port_) + (path_ == "/" ? "" : path_);
+    }
+
+    size_t distinct_connections() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return remote_ports_.size();
+    }
+
+    size_t request_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return request_count_;
+    }
+
+private:
+    std::string path_;
+    httplib::Server svr_;
+    int port_ = 0;
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::map<std::string, MethodHandler> handlers_;
+    std::set<int> remote_ports_;
+    size_t request_count_ = 0;
+};
+
+// ==================== Connection Handling ====================
+
+TEST(EthRpcClientTest, PlainHttpUrlWithPortAndPath) {
+    MockRpcServer server("/v2/test-key");
+    EthRpcClient rpc(server.url());
+
+    EXPECT_EQ(rpc.get_chain_id(), 137u);
+    EXPECT_EQ(server.request_count(), 1u);
+}
+
+TEST(EthRpcClientTest, BasicCalls) {
+    MockRpcServer server;
+    EthRpcClient rpc(server.url());
+
+    EXPECT_EQ(rpc.get_nonce("0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266"), 5u);
+    EXPECT_EQ(rpc.get_gas_price(), "0x6fc23ac00");
+}
+
+TEST(EthRpcClientTest, RpcErrorThrows) {
+    MockRpcServer server;
+    server.on("eth_sendRawTransaction", [](const json&) -> json {
+        throw std::runtime_error("nonce too low");
+    });
+    EthRpcClient rpc(server.url());
+
+    try {
+        rpc.send_raw_transaction("0x00");
+        FAIL() << "Expected RPC error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("nonce too low"), std::string::npos);
+    }
+}
+
+TEST(EthRpcClientTest, UnreachableNodeThrows) {
+    EthRpcClient rpc("http://127.0.0.1:1");
+    EXPECT_THROW(rpc.get_chain_id(), std::runtime_error);
+    EXPECT_FALSE(rpc.warm_connection());
+}
+
+TEST(EthRpcClientTest, ReusesPersistentConnection) {
+    MockRpcServer server;
+    EthRpcClient rpc(server.url());
+
+    EXPECT_TRUE(rpc.warm_connection());
+    for (int i = 0; i < 10; ++i) {
+        rpc.get_nonce("0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266");
+    }
+
+    // All calls should have gone over a single keep-alive connection
+    EXPECT_EQ(server.request_count(), 11u);
+    EXPECT_EQ(server.distinct_connections(), 1u);
+
+    auto stats = rpc.get_stats();
+    EXPECT_EQ(stats.total_requests, 11u);
+    EXPECT_TRUE(stats.connection_warm);
+    EXPECT_GE(stats.avg_latency_ms, 0.0);
+}
+
+// ==================== Batching and Multicall ====================
+
+static std::string word(uint64_t value) {
+    char buf[65];
+    snprintf(buf, sizeof(buf), "%064llx", static_cast<unsigned long long>(value));
+    return buf;
+}
+
+// Build an aggregate3 return value: (bool success, bytes returnData)[]
+// where each returnData is a single 32-byte word
+static std::string encode_aggregate3_result(const std::vector<std::pair<bool, uint64_t>>& results) {
+    std::string head = word(0x20) + word(results.size());
+    std::string body;
+    size_t offset = 32 * results.size();
+    for (const auto& r : results) {
+        head += word(offset);
+        std::string tuple = word(r.first ? 1 : 0) + word(0x40) + word(32) + word(r.second);
+        offset += tuple.length() / 2;
+        body += tuple;
+    }
+    return "0x" + head + body;
+}
+
+TEST(EthRpcBatchTest, BatchCallMatchesResponsesById) {
+    MockRpcServer server;
+    server.on("eth_blockNumber", [](const json&) { return json("0x10"); });
+    EthRpcClient rpc(server.url());
+
+    auto results = rpc.batch_call({
+        {"eth_chainId", json::array()},
+        {"eth_blockNumber", json::array()},
+        {"eth_getTransactionCount", {"0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266", "pending"}}
+    });
+
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_EQ(results[0].result, "0x89");
+    EXPECT_EQ(results[1].result, "0x10");
+    EXPECT_EQ(results[2].result, "0x5");
+
+    // Three calls, one round trip
+    EXPECT_EQ(server.request_count(), 1u);
+}
+
+TEST(EthRpcBatchTest, PerCallErrorsDoNotThrow) {
+    MockRpcServer server;
+    EthRpcClient rpc(server.url());
+
+    auto results = rpc.batch_call({
+        {"eth_chainId", json::array()},
+        {"eth_unknownMethod", json::array()}
+    });
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_TRUE(results[0].ok());
+    EXPECT_FALSE(results[1].ok());
+    EXPECT_TRUE(rpc.batch_call({}).empty());
+}
+
+TEST(AbiMulticallTest, EncodeAggregate3) {
+    std::vector<clob::abi::Call> calls = {
+        {"0x4d97dcd97ec945f40cf65f87097ace5ea0476045", "0x1234", false}
+    };
+
+    std::string expected = "0x82ad56cb" +
+        word(0x20) + word(1) + word(0x20) +
+        "0000000000000000000000004d97dcd97ec945f40cf65f87097ace5ea0476045" +
+        word(0) + word(0x60) + word(2) +
+        "1234000000000000000000000000000000000000000000000000000000000000";
+
+    EXPECT_EQ(clob::abi::encode_aggregate3(calls), expected);
+}
+
+TEST(AbiMulticallTest, DecodeAggregate3) {
+    auto results = clob::abi::decode_aggregate3(encode_aggregate3_result({{true, 1}, {false, 0}}));
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_TRUE(results[0].success);
+    EXPECT_TRUE(clob::abi::is_nonzero_word(results[0].return_data));
+    EXPECT_FALSE(results[1].success);
+    EXPECT_FALSE(clob::abi::is_nonzero_word(results[1].return_data));
+
+    EXPECT_THROW(clob::abi::decode_aggregate3("0x1234"), std::runtime_error);
+}
+
+TEST(AbiMulticallTest, ApprovalStatusInOneRoundTrip) {
+    MockRpcServer server;
+    server.on("eth_call", [](const json& params) {
+        std::string to = params[0]["to"].get<std::string>();
+        if (to != polygon_contracts::MULTICALL3) {
+            throw std::runtime_error("expected multicall");
+        }
+        // USDC->exchange granted, USDC->neg risk zero, CTF->exchange true, CTF->neg risk false
+        return json(encode_aggregate3_result({{true, 1000000}, {true, 0}, {true, 1}, {true, 0}}));
+    });
+
+    ApprovalHelper helper(
+        "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80", server.url());
+    auto status = helper.check_approvals();
+
+    EXPECT_TRUE(status.usdc_exchange);
+    EXPECT_FALSE(status.usdc_neg_risk);
+    EXPECT_TRUE(status.ctf_exchange);
+    EXPECT_FALSE(status.ctf_neg_risk);
+    EXPECT_FALSE(status.all());
+    EXPECT_EQ(server.request_count(), 1u);
+}
+
+// ==================== Nonce Management ====================
+
+TEST(NonceManagerTest, FetchesOnceAndIncrementsLocally) {
+    MockRpcServer server;
+    std::atomic<int> nonce_fetches{0};
+    server.on("eth_getTransactionCount", [&](const json&) {
+        nonce_fetches++;
+        return json("0x5");
+    });
+    EthRpcClient rpc(server.url());
+    NonceManager nonces(rpc, "0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266");
+
+    EXPECT_EQ(nonces.next(), 5u);
+    EXPECT_EQ(nonces.next(), 6u);
+    EXPECT_EQ(nonces.next(), 7u);
+    EXPECT_EQ(nonce_fetches.load(), 1);
+
+    nonces.reset(20);
+    EXPECT_EQ(nonces.next(), 20u);
+    EXPECT_EQ(nonce_fetches.load(), 1);
+}
+
+TEST(NonceManagerTest, PipelinesAndTracksInFlight) {
+    MockRpcServer server;
+    std::atomic<int> sent{0};
+    server.on("eth_sendRawTransaction", [&](const json& params) {
+        sent++;
+        return json("0xhash" + params[0].get<std::string>());
+    });
+    EthRpcClient rpc(server.url());
+    NonceManager nonces(rpc, "0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266");
+
+    auto sign = [](uint64_t nonce) { return std::to_string(nonce); };
+    std::string h1 = nonces.send(sign);
+    std::string h2 = nonces.send(sign);
+    std::string h3 = nonces.send(sign);
+
+    EXPECT_EQ(h1, "0xhash5");
+    EXPECT_EQ(h2, "0xhash6");
+    EXPECT_EQ(h3, "0xhash7");
+    EXPECT_EQ(nonces.in_flight(), 3u);
+
+    nonces.mark_confirmed(h2);
+    auto pending = nonces.pending();
+    EXPECT_EQ(pending.size(), 2u);
+    EXPECT_EQ(pending.begin()->first, 5u);
+    EXPECT_EQ(pending.rbegin()->first, 7u);
+}
+
+TEST(NonceManagerTest, ResyncsOnNonceTooLow) {
+    MockRpcServer server;
+    std::atomic<int> fetches{0};
+    server.on("eth_getTransactionCount", [&](const json&) {
+        // Another process used nonces 5 and 6 in the meantime
+        return json(fetches++ == 0 ? "0x5" : "0x7");
+    });
+    server.on("eth_sendRawTransaction", [](const json& params) -> json {
+        std::string tx = params[0].get<std::string>();
+        if (tx != "7") throw std::runtime_error("nonce too low: next nonce 7, tx nonce " + tx);
+        return json("0xabc");
+    });
+    EthRpcClient rpc(server.url());
+    NonceManager nonces(rpc, "0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266");
+
+    std::vector<uint64_t> signed_nonces;
+    std::string tx_hash = nonces.send([&](uint64_t nonce) {
+        signed_nonces.push_back(nonce);
+        return std::to_string(nonce);
+    });
+
+    EXPECT_EQ(tx_hash, "0xabc");
+    ASSERT_EQ(signed_nonces.size(), 2u);
+    EXPECT_EQ(signed_nonces[0], 5u);
+    EXPECT_EQ(signed_nonces[1], 7u);
+    EXPECT_EQ(nonces.next(), 8u);
+}
+
+TEST(NonceManagerTest, OtherErrorsPropagate) {
+    MockRpcServer server;
+    server.on("eth_sendRawTransaction", [](const json&) -> json {
+        throw std::runtime_error("insufficient funds for gas");
+    });
+    EthRpcClient rpc(server.url());
+    NonceManager nonces(rpc, "0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266");
+
+    EXPECT_THROW(nonces.send([](uint64_t n) { return std::to_string(n); }), std::runtime_error);
+    EXPECT_EQ(nonces.in_flight(), 0u);
+    EXPECT_TRUE(NonceManager::is_nonce_too_low("RPC error: {\"message\":\"Nonce too low\"}"));
+    EXPECT_FALSE(NonceManager::is_nonce_too_low("replacement transaction underpriced"));
+}
+
+// ==================== Receipt Tracking ====================
+
+// Chain stand-in: transaction "0xtxN" is mined in block N
+class MockChain {
+public:
+    explicit MockChain(MockRpcServer& server) {
+        server.on("eth_blockNumber", [this](const json&) {
+            char buf[32];
+            snprintf(buf, sizeof(buf), "0x%llx", static_cast<unsigned long long>(block_.load()));
+            return json(buf);
+        });
+        server.on("eth_getTransactionReceipt", [this](const json& params) {
+            std::string tx_hash = params[0].get<std::string>();
+            uint64_t mined_in = std::stoull(tx_hash.substr(4));
+            if (block_.load() < mined_in) return json();
+            return json({{"transactionHash", tx_hash}, {"status", "0x1"}});
+        });
+    }
+
+    void advance() { block_++; }
+
+private:
+    std::atomic<uint64_t> block_{100};
+};
+
+static ReceiptTracker::Options fast_tracker_options() {
+    ReceiptTracker::Options options;
+    options.initial_block_time = std::chrono::milliseconds(50);
+    options.min_poll_interval = std::chrono::milliseconds(5);
+    options.max_poll_interval = std::chrono::milliseconds(100);
+    return options;
+}
+
+TEST(ReceiptTrackerTest, ResolvesManyTransactionsConcurrently) {
+    MockRpcServer server;
+    MockChain chain(server);
+    EthRpcClient rpc(server.url());
+    ReceiptTracker tracker(rpc, fast_tracker_options());
+
+    auto f1 = tracker.track("0xtx100");  // already mined
+    auto f2 = tracker.track("0xtx102");
+    auto f3 = tracker.track("0xtx104");
+
+    std::thread miner([&]() {
+        for (int i = 0; i < 5; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            chain.advance();
+        }
+    });
+
+    EXPECT_EQ(f1.get()["transactionHash"], "0xtx100");
+    EXPECT_EQ(f2.get()["transactionHash"], "0xtx102");
+    EXPECT_EQ(f3.get()["transactionHash"], "0xtx104");
+    miner.join();
+
+    EXPECT_EQ(tracker.pending(), 0u);
+    // Block time estimate should move towards the observed ~50ms interval
+    EXPECT_LT(tracker.estimated_block_time().count(), 200);
+}
+
+TEST(ReceiptTrackerTest, CallbackAndTimeout) {
+    MockRpcServer server;
+    MockChain chain(server);
+    EthRpcClient rpc(server.url());
+    ReceiptTracker tracker(rpc, fast_tracker_options());
+
+    std::promise<std::string> callback_result;
+    tracker.track("0xtx100", [&](const std::string& tx_hash, const json& receipt, std::exception_ptr error) {
+        callback_result.set_value(error ? "error" : receipt["transactionHash"].get<std::string>());
+    });
+    EXPECT_EQ(callback_result.get_future().get(), "0xtx100");
+
+    // Never mined
+    auto never = tracker.track("0xtx999999", std::chrono::seconds(1));
+    EXPECT_THROW(never.get(), std::runtime_error);
+}
+
+TEST(ReceiptTrackerTest, StopFailsPendingWaiters) {
+    MockRpcServer server;
+    MockChain chain(server);
+    EthRpcClient rpc(server.url());
+    ReceiptTracker tracker(rpc, fast_tracker_options());
+
+    auto pending = tracker.track("0xtx999999");
+    tracker.stop();
+    EXPECT_THROW(pending.get(), std::runtime_error);
+    EXPECT_THROW(tracker.track("0xtx100"), std::runtime_error);
+}
+
+TEST(ReceiptTrackerTest, PollsEveryHashBeyondBatchSize) {
+    MockRpcServer server;
+    MockChain chain(server);
+    EthRpcClient rpc(server.url());
+    auto options = fast_tracker_options();
+    options.max_batch_size = 2;
+    ReceiptTracker tracker(rpc, options);
+
+    // Never mined, and more of them than fit in one batch
+    std::vector<std::future<json>> stuck;
+    for (int i = 0; i < 9; ++i) {
+        stuck.push_back(tracker.track("0xtx99999" + std::to_string(i), std::chrono::seconds(30)));
+    }
+    auto mined = tracker.track("0xtx100", std::chrono::seconds(30));
+
+    ASSERT_EQ(mined.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(mined.get()["transactionHash"], "0xtx100");
+    EXPECT_EQ(tracker.pending(), 9u);
+    tracker.stop();
+}
+
+TEST(ReceiptTrackerTest, SurvivesMalformedBlockNumber) {
+    MockRpcServer server;
+    MockChain chain(server);
+    server.on("eth_blockNumber", [](const json&) { return json("0xnot-hex"); });
+    EthRpcClient rpc(server.url());
+    ReceiptTracker tracker(rpc, fast_tracker_options());
+
+    // The bad block number is skipped; receipts in the same batch still resolve
+    auto mined = tracker.track("0xtx100");
+    EXPECT_EQ(mined.get()["transactionHash"], "0xtx100");
+
+    server.on("eth_blockNumber", [](const json&) { return json(""); });
+    auto later = tracker.track("0xtx100");
+    EXPECT_EQ(later.get()["transactionHash"], "0xtx100");
+}
+
+// ==================== RLP / Transaction ====================
+
+static std::string to_hex(const uint8_t* data, size_t len) {
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    for (size_t i = 0; i < len; ++i) {
+        out += digits[data[i] >> 4];
+        out += digits[data[i] & 0x0f];
+    }
+    return out;
+}
+
+TEST(RlpTest, WriterMatchesLegacyEncoder) {
+    std::vector<uint8_t> long_string(60, 0xab);
+    std::vector<uint8_t> single_low = {0x7f};
+    std::vector<uint8_t> single_high = {0x80};
+
+    auto expected = rlp::encode_list({
+        rlp::encode_integer(0),
+        rlp::encode_integer(0x7f),
+        rlp::encode_integer(0x1234),
+        rlp::encode_string(single_low),
+        rlp::encode_string(single_high),
+        rlp::encode_string(long_string),
+    });
+
+    size_t payload = rlp::integer_size(0) + rlp::integer_size(0x7f) + rlp::integer_size(0x1234) +
+                     rlp::string_size(single_low.data(), 1) + rlp::string_size(single_high.data(), 1) +
+                     rlp::string_size(long_string.data(), long_string.size());
+    ASSERT_EQ(rlp::list_header_size(payload) + payload, expected.size());
+
+    std::vector<uint8_t> buf(expected.size());
+    rlp::Writer w(buf.data());
+    w.list_header(payload);
+    w.integer(0);
+    w.integer(0x7f);
+    w.integer(0x1234);
+    w.string(single_low.data(), 1);
+    w.string(single_high.data(), 1);
+    w.string(long_string.data(), long_string.size());
+
+    EXPECT_EQ(w.size(), expected.size());
+    EXPECT_EQ(buf, expected);
+}
+
+TEST(RlpTest, HexFields) {
+    uint8_t buf[32];
+
+    // Numeric fields drop leading zeros; "0x0" is the empty string
+    rlp::Writer zero(buf);
+    zero.hex("0x0", true);
+    EXPECT_EQ(to_hex(buf, zero.size()), "80");
+    EXPECT_EQ(rlp::hex_size("0x0", true), 1u);
+
+    // Odd digit count: first nibble is its own byte
+    rlp::Writer odd(buf);
+    odd.hex("0x4a817c800", true);
+    EXPECT_EQ(to_hex(buf, odd.size()), "8504a817c800");
+    EXPECT_EQ(rlp::hex_size("0x4a817c800", true), 6u);
+
+    // Single byte below 0x80 is encoded as itself
+    rlp::Writer small(buf);
+    small.hex("0x000f", true);
+    EXPECT_EQ(to_hex(buf, small.size()), "0f");
+
+    // Non-numeric fields keep leading zeros
+    rlp::Writer raw(buf);
+    raw.hex("0x0001", false);
+    EXPECT_EQ(to_hex(buf, raw.size()), "820001");
+}
+
+static Transaction eip155_example() {
+    // Example transaction from EIP-155
+    Transaction tx;
+    tx.nonce = 9;
+    tx.gas_price = "0x4a817c800";  // 20 gwei
+    tx.gas_limit = 21000;
+    tx.to = "0x3535353535353535353535353535353535353535";
+    tx.value = "0xde0b6b3a7640000";  // 1 ether
+    tx.data = "0x";
+    tx.chain_id = 1;
+    return tx;
+}
+
+TEST(TransactionTest, Eip155SigningHash) {
+    auto hash = eip155_example().signing_hash();
+    EXPECT_EQ(to_hex(hash.data(), hash.size()),
+              "daf5a779ae972f972197303d7b574746c7ef83eadac0f2791ad23db92e4c8e53");
+}
+
+TEST(TransactionTest, Eip155SignedTransaction) {
+    const std::string key = "0x4646464646464646464646464646464646464646464646464646464646464646";
+    const std::string expected =
+        "0xf86c098504a817c800825208943535353535353535353535353535353535353535880de0b6b3a7640000"
+        "8025a028ef61340bd939bc2195fe537567866003e1a15d3c71ff63e1590620aa636276a067cbe9d8997f"
+        "761aecb703304b3800ccf555c9f3dc64214b297fb1966a3b6d83";
+
+    auto tx = eip155_example();
+    Signer signer(key, 1);
+    EXPECT_EQ(tx.sign(signer), expected);
+    EXPECT_EQ(tx.sign(key), expected);
+}
+
+static std::vector<uint8_t> from_hex(const std::string& hex) {
+    std::vector<uint8_t> out;
+    for (size_t i = 2; i + 1 < hex.size(); i += 2) {
+        out.push_back(static_cast<uint8_t>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+    }
+    return out;
+}
+
+static Eip1559Transaction eip1559_example() {
+    Eip1559Transaction tx;
+    tx.chain_id = 137;
+    tx.nonce = 42;
+    tx.max_priority_fee_per_gas = 30000000000;   // 30 gwei
+    tx.max_fee_per_gas = 100000000000;           // 100 gwei
+    tx.gas_limit = 100000;
+    tx.to = "0x2791Bca1f2de4661ED88A30C99A7a9449Aa84174";
+    tx.value = "0x0";
+    tx.data = "0x095ea7b3" + std::string(128, 'f');
+    return tx;
+}
+
+// Reference encoding built with the legacy item-by-item encoder
+static std::vector<std::vector<uint8_t>> eip1559_reference_fields(const Eip1559Transaction& tx) {
+    return {
+        rlp::encode_integer(tx.chain_id),
+        rlp::encode_integer(tx.nonce),
+        rlp::encode_integer(tx.max_priority_fee_per_gas),
+        rlp::encode_integer(tx.max_fee_per_gas),
+        rlp::encode_integer(tx.gas_limit),
+        rlp::encode_string(from_hex(tx.to)),
+        rlp::encode_string({}),
+        rlp::encode_string(from_hex(tx.data)),
+        rlp::encode_list({}),
+    };
+}
+
+TEST(TransactionTest, Eip1559SigningHash) {
+    auto tx = eip1559_example();
+
+    std::vector<uint8_t> payload = {0x02};
+    auto list = rlp::encode_list(eip1559_reference_fields(tx));
+    payload.insert(payload.end(), list.begin(), list.end());
+
+    EXPECT_EQ(tx.signing_hash(), keccak::hash256(payload));
+}
+
+TEST(TransactionTest, Eip1559SignedTransaction) {
+    const std::string key = "0x4646464646464646464646464646464646464646464646464646464646464646";
+    auto tx = eip1559_example();
+    Signer signer(key, 137);
+
+    // Signing is deterministic (RFC 6979), so the reference can reuse the signature
+    auto sig = signer.sign_hash(tx.signing_hash());
+    auto strip = [](std::vector<uint8_t> bytes) {
+        while (!bytes.empty() && bytes[0] == 0) bytes.erase(bytes.begin());
+        return bytes;
+    };
+    auto fields = eip1559_reference_fields(tx);
+    fields.push_back(rlp::encode_integer(sig.v));
+    fields.push_back(rlp::encode_string(strip(sig.r)));
+    fields.push_back(rlp::encode_string(strip(sig.s)));
+    auto list = rlp::encode_list(fields);
+
+    std::string signed_tx = tx.sign(signer);
+    EXPECT_EQ(signed_tx, "0x02" + to_hex(list.data(), list.size()));
+    EXPECT_EQ(tx.sign(key), signed_tx);
+}
+
+// ==================== Fee Oracle ====================
+
+static json fee_history_result() {
+    return {
+        {"oldestBlock", "0x64"},
+        {"baseFeePerGas", {"0x1", "0x2", "0x3", "0x4", "0x5", "0x6fc23ac00"}},  // pending: 30 gwei
+        {"gasUsedRatio", {0.5, 0.5, 0.5, 0.5, 0.5}},
+        {"reward", {{"0x9502f9000"}, {"0xba43b7400"}, {"0xba43b7400"}, {"0xdf8475800"}, {"0x0"}}},
+    };
+}
+
+TEST(FeeOracleTest, CachesWithinTtl) {
+    MockRpcServer server;
+    std::atomic<int> calls{0};
+    server.on("eth_feeHistory", [&](const json& params) {
+        calls++;
+        EXPECT_EQ(params[0], "0x5");
+        EXPECT_EQ(params[1], "latest");
+        return fee_history_result();
+    });
+    EthRpcClient rpc(server.url());
+
+    FeeOracle::Options options;
+    options.ttl = std::chrono::milliseconds(60000);
+    options.min_priority_fee = 30000000000;
+    FeeOracle oracle(rpc, options);
+
+    auto fees = oracle.get();
+    EXPECT_EQ(fees.base_fee, 30000000000u);
+    EXPECT_EQ(fees.max_priority_fee_per_gas, 50000000000u);  // median reward
+    EXPECT_EQ(fees.max_fee_per_gas, 2 * 30000000000u + 50000000000u);
+
+    for (int i = 0; i < 10; ++i) oracle.get();
+    EXPECT_EQ(calls.load(), 1);
+
+    oracle.invalidate();
+    oracle.get();
+    EXPECT_EQ(calls.load(), 2);
+}
+
+TEST(FeeOracleTest, PriorityFeeFloorAndExpiry) {
+    MockRpcServer server;
+    std::atomic<int> calls{0};
+    server.on("eth_feeHistory", [&](const json&) {
+        calls++;
+        return fee_history_result();
+    });
+    EthRpcClient rpc(server.url());
+
+    FeeOracle::Options options;
+    options.ttl = std::chrono::milliseconds(0);
+    options.min_priority_fee = 80000000000;  // above every reward
+    FeeOracle oracle(rpc, options);
+
+    EXPECT_EQ(oracle.get().max_priority_fee_per_gas, 80000000000u);
+    oracle.get();
+    EXPECT_EQ(calls.load(), 2);
+}
+
+TEST(FeeOracleTest, MalformedFeeHistory) {
+    MockRpcServer server;
+    json history = fee_history_result();
+    history["reward"][4][0] = "";  // skipped, median stays 50 gwei
+    server.on("eth_feeHistory", [&](const json&) { return history; });
+    EthRpcClient rpc(server.url());
+    FeeOracle oracle(rpc);
+
+    EXPECT_EQ(oracle.get().max_priority_fee_per_gas, 50000000000u);
+
+    history["baseFeePerGas"][5] = "0xzz";
+    EXPECT_THROW(oracle.refresh(), std::runtime_error);
+}
+
+// ==================== Gas Cache ====================
+
+TEST(GasCacheTest, KeyIgnoresArgumentValues) {
+    auto approve_a = clob::abi::encode_approve(polygon_contracts::EXCHANGE, "ff");
+    auto approve_b = clob::abi::encode_approve(polygon_contracts::NEG_RISK_EXCHANGE, "01");
+    auto set_approval = clob::abi::encode_set_approval_for_all(polygon_contracts::EXCHANGE, true);
+
+    EXPECT_EQ(GasCache::key(polygon_contracts::USDC, approve_a), GasCache::key(polygon_contracts::USDC, approve_b));
+    EXPECT_NE(GasCache::key(polygon_contracts::USDC, approve_a), GasCache::key(polygon_contracts::CTF, approve_a));
+    EXPECT_NE(GasCache::key(polygon_contracts::USDC, approve_a), GasCache::key(polygon_contracts::USDC, set_approval));
+    EXPECT_EQ(GasCache::key("0xABC", "0x095EA7B3"), "0xabc:095ea7b3:4");
+}
+
+TEST(GasCacheTest, EstimatesOnceWithHeadroom) {
+    MockRpcServer server;
+    std::atomic<int> estimates{0};
+    server.on("eth_estimateGas", [&](const json& params) {
+        estimates++;
+        EXPECT_EQ(params[0]["from"], "0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266");
+        return json("0xc350");  // 50000
+    });
+    EthRpcClient rpc(server.url());
+
+    GasCache::Options options;
+    options.headroom = 1.2;
+    GasCache cache(rpc, options);
+
+    const std::string from = "0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266";
+    auto data = clob::abi::encode_approve(polygon_contracts::EXCHANGE, "ff");
+    EXPECT_EQ(cache.gas_limit(from, polygon_contracts::USDC, data), 60000u);
+
+    auto other = clob::abi::encode_approve(polygon_contracts::NEG_RISK_EXCHANGE, "ff");
+    EXPECT_EQ(cache.gas_limit(from, polygon_contracts::USDC, other), 60000u);
+    EXPECT_EQ(estimates.load(), 1);
+
+    cache.invalidate(polygon_contracts::USDC, data);
+    EXPECT_FALSE(cache.lookup(polygon_contracts::USDC, other).has_value());
+    cache.gas_limit(from, polygon_contracts::USDC, data);
+    EXPECT_EQ(estimates.load(), 2);
+}
+
+TEST(GasCacheTest, ConcurrentInvalidateDuringEstimate) {
+    MockRpcServer server;
+    server.on("eth_estimateGas", [](const json&) { return json("0xc350"); });
+    EthRpcClient rpc(server.url());
+
+    GasCache::Options options;
+    options.headroom = 1.2;
+    GasCache cache(rpc, options);
+
+    const std::string from = "0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266";
+    auto data = clob::abi::encode_approve(polygon_contracts::EXCHANGE, "ff");
+    std::atomic<bool> done{false};
+    std::thread invalidator([&]() {
+        while (!done.load()) {
+            cache.invalidate(polygon_contracts::USDC, data);
+        }
+    });
+
+    // Every miss estimates and returns its own limit even if the entry is
+    // dropped before gas_limit returns
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(cache.gas_limit(from, polygon_contracts::USDC, data), 60000u);
+    }
+    done = true;
+    invalidator.join();
+}
+
+TEST(GasCacheTest, PersistsAcrossInstances) {
+    MockRpcServer server;
+    std::atomic<int> estimates{0};
+    server.on("eth_estimateGas", [&](const json&) {
+        estimates++;
+        return json("0x186a0");  // 100000
+    });
+    EthRpcClient rpc(server.url());
+
+    GasCache::Options options;
+    options.headroom = 1.0;
+    options.path = testing::TempDir() + "gas_cache_test.json";
+    std::remove(options.path.c_str());
+
+    const std::string from = "0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266";
+    auto data = clob::abi::encode_set_approval_for_all(polygon_contracts::EXCHANGE, true);
+    {
+        GasCache cache(rpc, options);
+        EXPECT_EQ(cache.gas_limit(from, polygon_contracts::CTF, data), 100000u);
+    }
+
+    GasCache restored(rpc, options);
+    EXPECT_EQ(restored.size(), 1u);
+    EXPECT_EQ(restored.gas_limit(from, polygon_contracts::CTF, data), 100000u);
+    EXPECT_EQ(estimates.load(), 1);
+
+    std::remove(options.path.c_str());
+}
+
+TEST(GasCacheTest, UnwritablePathIsIgnored) {
+    MockRpcServer server;
+    server.on("eth_estimateGas", [](const json&) { return json("0x186a0"); });
+    EthRpcClient rpc(server.url());
+
+    GasCache::Options options;
+    options.headroom = 1.0;
+    options.path = testing::TempDir() + "no-such-dir/gas_cache.json";
+    GasCache cache(rpc, options);
+
+    const std::string from = "0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266";
+    auto data = clob::abi::encode_set_approval_for_all(polygon_contracts::EXCHANGE, true);
+    EXPECT_EQ(cache.gas_limit(from, polygon_contracts::CTF, data), 100000u);
+    EXPECT_NO_THROW(cache.invalidate(polygon_contracts::CTF, data));
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+// ==================== Approval Provisioning ====================
+
+// Two hardhat test wallets: the first fully approved, the second not at all
+static void setup_provisioning_chain(MockRpcServer& server) {
+    server.on("eth_call", [](const json&) {
+        return json(encode_aggregate3_result({
+            {true, 1}, {true, 1}, {true, 1}, {true, 1},
+            {true, 0}, {true, 0}, {true, 0}, {true, 0},
+        }));
+    });
+    server.on("eth_feeHistory", [](const json&) { return fee_history_result(); });
+    server.on("eth_estimateGas", [](const json&) { return json("0xc350"); });
+}
+
+static const std::vector<std::string> provisioning_keys = {
+    "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80",
+    "0x59c6995e998f97a0a44496d9bbbea2c46f1c3ffa87bcbb7ae2d9a8fb4e0e5e45",
+};
+
+TEST(ApprovalProvisionerTest, ChecksAllWalletsInOneMulticall) {
+    MockRpcServer server;
+    setup_provisioning_chain(server);
+    ApprovalProvisioner provisioner(server.url());
+
+    auto statuses = provisioner.check_approvals({
+        "0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266",
+        "0x70997970c51812dc3a010c7d01b50e0d17dc79c8",
+    });
+
+    ASSERT_EQ(statuses.size(), 2u);
+    EXPECT_TRUE(statuses[0].all());
+    EXPECT_FALSE(statuses[1].usdc_exchange);
+    EXPECT_FALSE(statuses[1].ctf_neg_risk);
+    EXPECT_EQ(server.request_count(), 1u);
+}
+
+TEST(ApprovalProvisionerTest, ProvisionsMissingApprovals) {
+    MockRpcServer server;
+    MockChain chain(server);
+    setup_provisioning_chain(server);
+
+    std::atomic<int> nonce_fetches{0};
+    std::atomic<int> sent{0};
+    server.on("eth_getTransactionCount", [&](const json& params) {
+        nonce_fetches++;
+        EXPECT_EQ(params[1], "pending");
+        return json("0x5");
+    });
+    server.on("eth_sendRawTransaction", [&](const json& params) {
+        EXPECT_EQ(params[0].get<std::string>().substr(0, 4), "0x02");
+        return json("0xtx" + std::to_string(++sent));  // already mined
+    });
+
+    ApprovalProvisioner provisioner(server.url());
+    auto results = provisioner.provision(provisioning_keys, std::chrono::seconds(10));
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_TRUE(results[0].success);
+    EXPECT_TRUE(results[0].tx_hashes.empty());
+    EXPECT_TRUE(results[1].success) << results[1].error;
+    EXPECT_EQ(results[1].tx_hashes.size(), 4u);
+    EXPECT_FALSE(results[1].before.all());
+
+    // Only the wallet that needed transactions fetched a nonce
+    EXPECT_EQ(nonce_fetches.load(), 1);
+    EXPECT_EQ(sent.load(), 4);
+}
+
+TEST(ApprovalProvisionerTest, ReportsFailuresPerWallet) {
+    MockRpcServer server;
+    MockChain chain(server);
+    setup_provisioning_chain(server);
+    server.on("eth_sendRawTransaction", [](const json&) -> json {
+        throw std::runtime_error("insufficient funds for gas * price + value");
+    });
+
+    ApprovalProvisioner provisioner(server.url());
+    auto results = provisioner.provision(provisioning_keys, std::chrono::seconds(10));
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_TRUE(results[0].success);
+    EXPECT_FALSE(results[1].success);
+    EXPECT_NE(results[1].error.find("insufficient funds"), std::string::npos);
+}
+
+// Nonce of a signed type-2 transaction: 0x02 || rlp([chain_id, nonce, ...]),
+// assuming chain id 137 and a nonce below 0x80
+static uint64_t small_tx_nonce(const std::string& raw_tx) {
+    auto bytes = clob::hex::decode(raw_tx);
+    size_t pos = 1;
+    pos += bytes[pos] >= 0xf8 ? 1 + (bytes[pos] - 0xf7) : 1;  // list header
+    pos += 2;                                                   // 0x81 0x89
+    return bytes[pos] == 0x80 ? 0 : bytes[pos];
+}
+
+TEST(ApprovalProvisionerTest, SigningFailureSendsNothingForTheWallet) {
+    MockRpcServer server;
+    MockChain chain(server);
+    setup_provisioning_chain(server);
+    // The first approval estimates fine, the second fails
+    std::atomic<int> estimates{0};
+    server.on("eth_estimateGas", [&](const json&) -> json {
+        if (estimates++ == 1) throw std::runtime_error("execution reverted");
+        return json("0xc350");
+    });
+    std::atomic<int> sent{0};
+    server.on("eth_sendRawTransaction", [&](const json&) {
+        sent++;
+        return json("0xtx100");
+    });
+
+    ApprovalProvisioner provisioner(server.url());
+    auto results = provisioner.provision(provisioning_keys, std::chrono::seconds(10));
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_FALSE(results[1].success);
+    EXPECT_NE(results[1].error.find("execution reverted"), std::string::npos);
+    EXPECT_TRUE(results[1].tx_hashes.empty());
+    EXPECT_EQ(sent.load(), 0);
+}
+
+TEST(ApprovalProvisionerTest, BroadcastFailureStopsLaterNonces) {
+    MockRpcServer server;
+    MockChain chain(server);
+    setup_provisioning_chain(server);
+    std::atomic<int> sent{0};
+    server.on("eth_sendRawTransaction", [&](const json& params) -> json {
+        sent++;
+        switch (small_tx_nonce(params[0].get<std::string>())) {
+            case 5: return json("0xtx100");
+            case 6: throw std::runtime_error("replacement transaction underpriced");
+            default: return json("0xtx999999");  // would sit behind the gap, never mined
+        }
+    });
+
+    ApprovalProvisioner provisioner(server.url());
+    auto start = std::chrono::steady_clock::now();
+    auto results = provisioner.provision(provisioning_keys, std::chrono::seconds(30));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_FALSE(results[1].success);
+    EXPECT_NE(results[1].error.find("underpriced"), std::string::npos);
+    ASSERT_EQ(results[1].tx_hashes.size(), 1u);
+    EXPECT_EQ(results[1].tx_hashes[0], "0xtx100");
+    // Nonces 7 and 8 are never broadcast, so a re-run can sign them afresh
+    EXPECT_EQ(sent.load(), 2);
+    EXPECT_LT(elapsed, std::chrono::seconds(10));
+}
+
+// ==================== Balance Poller ====================
+
+TEST(BalancePollerTest, EncodesBalanceCalls) {
+    EXPECT_EQ(clob::abi::encode_balance_of("0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266"),
+              "0x70a08231000000000000000000000000f39fd6e51aad88f6f4ce6ab8827279cfffb92266");
+    EXPECT_EQ(clob::abi::encode_erc1155_balance_of("0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266", "255"),
+              "0x00fdd58e000000000000000000000000f39fd6e51aad88f6f4ce6ab8827279cfffb92266"
+              "00000000000000000000000000000000000000000000000000000000000000ff");
+    EXPECT_EQ(clob::abi::decode_uint64(word(1500000)), 1500000u);
+    EXPECT_THROW(clob::abi::decode_uint64("0x" + std::string(64, 'f')), std::runtime_error);
+}
+
+TEST(BalancePollerTest, ReportsOnlyChanges) {
+    MockRpcServer server;
+    std::atomic<uint64_t> usdc{1000000};
+    std::atomic<uint64_t> position{0};
+    std::atomic<int> multicalls{0};
+    server.on("eth_call", [&](const json& params) {
+        multicalls++;
+        auto calls = params[0]["data"].get<std::string>();
+        EXPECT_NE(calls.find("70a08231"), std::string::npos);
+        EXPECT_NE(calls.find("00fdd58e"), std::string::npos);
+        return json(encode_aggregate3_result({{true, usdc.load()}, {true, position.load()}}));
+    });
+    EthRpcClient rpc(server.url());
+    BalancePoller poller(rpc);
+
+    const std::string wallet = "0xF39Fd6e51aad88F6F4ce6aB8827279cffFb92266";
+    poller.add_wallet(wallet);
+    poller.add_position(wallet, "12345");
+    poller.add_wallet(wallet);  // duplicate is ignored
+
+    std::vector<BalancePoller::BalanceChange> seen;
+    poller.on_change([&](const BalancePoller::BalanceChange& c) { seen.push_back(c); });
+
+    // First read: only non-zero balances are reported
+    auto changes = poller.poll_once();
+    ASSERT_EQ(changes.size(), 1u);
+    EXPECT_EQ(changes[0].token_id, "");
+    EXPECT_EQ(changes[0].current, 1000000u);
+    EXPECT_EQ(poller.usdc_balance(wallet), 1000000u);
+    EXPECT_EQ(poller.position_balance(wallet, "12345"), 0u);
+
+    // Nothing moved
+    EXPECT_TRUE(poller.poll_once().empty());
+
+    // Position filled
+    position = 5000000;
+    changes = poller.poll_once();
+    ASSERT_EQ(changes.size(), 1u);
+    EXPECT_EQ(changes[0].token_id, "12345");
+    EXPECT_EQ(changes[0].previous, 0u);
+    EXPECT_EQ(changes[0].current, 5000000u);
+
+    EXPECT_EQ(seen.size(), 2u);
+    EXPECT_EQ(multicalls.load(), 3);
+}
+
+TEST(BalancePollerTest, BackgroundPolling) {
+    MockRpcServer server;
+    std::atomic<uint64_t> usdc{1};
+    server.on("eth_call", [&](const json&) {
+        return json(encode_aggregate3_result({{true, usdc.load()}}));
+    });
+    EthRpcClient rpc(server.url());
+
+    BalancePoller::Options options;
+    options.interval = std::chrono::milliseconds(10);
+    BalancePoller poller(rpc, options);
+    poller.add_wallet("0xf39fd6e51aad88f6f4ce6ab8827279cfffb92266");
+
+    std::promise<uint64_t> changed;
+    std::atomic<bool> fired{false};
+    poller.on_change([&](const BalancePoller::BalanceChange& c) {
+        if (c.current == 2 && !fired.exchange(true)) changed.set_value(c.previous);
+    });
+
+    poller.poll_once();  // Seed the table before the background thread runs
+    poller.start();
+    usdc = 2;
+    auto future = changed.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(future.get(), 1u);
+    poller.stop();
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <clob/hex.hpp>
+
+using namespace clob;
+
+TEST(HexTest, EncodeLowercaseWithOptionalPrefix) {
+    std::vector<uint8_t> bytes = {0x00, 0x0f, 0xa0, 0xde, 0xad, 0xbe, 0xef, 0xff};
+    EXPECT_EQ(hex::encode(bytes), "0x000fa0deadbeefff");
+    EXPECT_EQ(hex::encode(bytes, false), "000fa0deadbeefff");
+    EXPECT_EQ(hex::encode(std::vector<uint8_t>{}), "0x");
+
+    std::array<uint8_t, 2> arr = {0x12, 0x34};
+    EXPECT_EQ(hex::encode(arr, false), "1234");
+
+    char out[4];
+    hex::encode_to(arr.data(), arr.size(), out);
+    EXPECT_EQ(std::string(out, 4), "1234");
+}
+
+TEST(HexTest, DecodeAcceptsPrefixAndMixedCase) {
+    EXPECT_EQ(hex::decode("0xDeadBEEF"), (std::vector<uint8_t>{0xde, 0xad, 0xbe, 0xef}));
+    EXPECT_EQ(hex::decode("0Xff00"), (std::vector<uint8_t>{0xff, 0x00}));
+    EXPECT_EQ(hex::decode("0102"), (std::vector<uint8_t>{0x01, 0x02}));
+    EXPECT_TRUE(hex::decode("0x").empty());
+    EXPECT_TRUE(hex::decode("").empty());
+}
+
+TEST(HexTest, RejectsInvalidInput) {
+    EXPECT_THROW(hex::decode("0x123"), std::runtime_error);     // odd length
+    EXPECT_THROW(hex::decode("0xzz"), std::runtime_error);      // not hex
+    EXPECT_THROW(hex::decode("12 4"), std::runtime_error);
+    EXPECT_THROW(hex::decode_array<4>("0x010203"), std::runtime_error);
+
+    EXPECT_TRUE(hex::is_valid("0xabCD"));
+    EXPECT_FALSE(hex::is_valid("0xabc"));
+    EXPECT_FALSE(hex::is_valid("0xg0"));
+
+    uint8_t out[1];
+    EXPECT_FALSE(hex::decode_to("0x1g", out));
+}
+
+TEST(HexTest, RoundTripAllBytes) {
+    std::vector<uint8_t> all(256);
+    for (int i = 0; i < 256; ++i) all[i] = static_cast<uint8_t>(i);
+
+    EXPECT_EQ(hex::decode(hex::encode(all)), all);
+
+    auto arr = hex::decode_array<4>("0x01020304");
+    EXPECT_EQ(arr[0], 0x01);
+    EXPECT_EQ(arr[3], 0x04);
+    EXPECT_EQ(hex::digit_value('F'), 15);
+    EXPECT_EQ(hex::digit_value('g'), -1);
+}
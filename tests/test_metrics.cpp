@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include <clob/client.hpp>
+#include <clob/eth_rpc.hpp>
+#include <clob/http_client.hpp>
+#include <clob/metrics.hpp>
+#include <clob/signer.hpp>
+#include <httplib.h>
+#include <mock_exchange.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace clob;
+using clob::mock::MockExchange;
+
+namespace {
+
+const std::string PRIVATE_KEY = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+const std::string TOKEN_ID = "71321045679252212594626385532706912750332728571942532289631379312455583992563";
+
+// The registry is process-wide: every test starts from zeroed counters
+class MetricsTest : public ::testing::Test {
+protected:
+    void SetUp() override { metrics::reset(); }
+};
+
+const metrics::RequestSnapshot* find_request(const metrics::Snapshot& snap, const std::string& method,
+                                             const std::string& endpoint, int status) {
+    for (const auto& request : snap.requests) {
+        if (request.method == method && request.endpoint == endpoint && request.status == status) {
+            return &request;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST_F(MetricsTest, NormalizesIdSegments) {
+    EXPECT_EQ(metrics::normalize_endpoint("/book"), "/book");
+    EXPECT_EQ(metrics::normalize_endpoint("/data/order/0xabc123"), "/data/order/:id");
+    EXPECT_EQ(metrics::normalize_endpoint("/markets/0x5f65177b394277fd294cd75650044e32ba009a95022d88a0c1d565897d72f8f1"),
+              "/markets/:id");
+    EXPECT_EQ(metrics::normalize_endpoint("/tick-size/" + TOKEN_ID), "/tick-size/:id");
+    EXPECT_EQ(metrics::normalize_endpoint("/data/orders?next_cursor=MA=="), "/data/orders");
+    EXPECT_EQ(metrics::normalize_endpoint("/v1/2024"), "/v1/2024");
+}
+
+TEST_F(MetricsTest, CollapsesHighEntropySegments) {
+    // RPC provider keys and UUIDs never become labels
+    EXPECT_EQ(metrics::normalize_endpoint("/v2/k3Jx9QpLm2Zt7RwYb4Nc"), "/v2/:id");
+    EXPECT_EQ(metrics::normalize_endpoint("/v3/9aa3d95b3bc440fa88ea12eaa4456161"), "/v3/:id");
+    EXPECT_EQ(metrics::normalize_endpoint("/auth/api-key/123e4567-e89b-12d3-a456-426614174000"),
+              "/auth/api-key/:id");
+    // Long words without digits are endpoint names, not ids
+    EXPECT_EQ(metrics::normalize_endpoint("/cancel-market-orders"), "/cancel-market-orders");
+    EXPECT_EQ(metrics::normalize_endpoint("/prices-history"), "/prices-history");
+}
+
+TEST_F(MetricsTest, HttpClientCanRedactOrSkipRequests) {
+    MockExchange exchange;
+    exchange.start();
+
+    HttpClient redacted(exchange.url());
+    redacted.set_request_metrics(RequestMetrics::Redacted);
+    redacted.get("/time");
+
+    HttpClient off(exchange.url());
+    off.set_request_metrics(RequestMetrics::Off);
+    off.get("/time");
+
+    auto snap = metrics::snapshot();
+    const auto* hidden = find_request(snap, "GET", "redacted", 200);
+    ASSERT_NE(hidden, nullptr);
+    EXPECT_EQ(hidden->count, 1u);
+    EXPECT_EQ(find_request(snap, "GET", "/time", 200), nullptr);
+}
+
+TEST_F(MetricsTest, RpcClientPathsAreRedacted) {
+    MockExchange exchange;
+    exchange.start();
+
+    // The mock serves no JSON-RPC; the request fails but is still counted
+    EthRpcClient rpc(exchange.url() + "/v2/my-secret-provider-key");
+    EXPECT_THROW(rpc.get_chain_id(), std::exception);
+
+    auto snap = metrics::snapshot();
+    ASSERT_EQ(snap.requests.size(), 1u);
+    EXPECT_EQ(snap.requests[0].method, "POST");
+    EXPECT_EQ(snap.requests[0].endpoint, "redacted");
+    EXPECT_EQ(metrics::prometheus_text().find("secret"), std::string::npos);
+}
+
+TEST_F(MetricsTest, CountsRequestsFromManyThreads) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < 1000; ++i) {
+                metrics::record_request("POST", "/order", t % 2 ? 200 : 400, 2000000);  // 2 ms
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto snap = metrics::snapshot();
+    const auto* ok = find_request(snap, "POST", "/order", 200);
+    const auto* bad = find_request(snap, "POST", "/order", 400);
+    ASSERT_NE(ok, nullptr);
+    ASSERT_NE(bad, nullptr);
+    EXPECT_EQ(ok->count, 4000u);
+    EXPECT_EQ(bad->count, 4000u);
+    EXPECT_EQ(ok->latency.count, 4000u);
+    EXPECT_NEAR(ok->latency.mean_seconds(), 0.002, 1e-9);
+
+    // 2 ms falls in the (0.001, 0.0025] bucket
+    size_t bucket = 0;
+    while (metrics::Histogram::BOUNDS[bucket] < 0.002) {
+        ++bucket;
+    }
+    EXPECT_EQ(ok->latency.buckets[bucket], 4000u);
+}
+
+TEST_F(MetricsTest, RendersPrometheusText) {
+    metrics::record_request("GET", "/book", 200, 300000);
+    metrics::record_request("GET", "/book", 0, 5000000000ULL);
+    metrics::record_cache(metrics::Cache::TICK_SIZE, true);
+    metrics::record_cache(metrics::Cache::TICK_SIZE, false);
+    metrics::record_orders(3, 1, 1);
+    metrics::record_heartbeat(false);
+
+    std::string text = metrics::prometheus_text();
+    EXPECT_NE(text.find("# TYPE clob_http_requests_total counter"), std::string::npos);
+    EXPECT_NE(text.find("clob_http_requests_total{method=\"GET\",endpoint=\"/book\",status=\"200\"} 1\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("clob_http_request_duration_seconds_bucket{method=\"GET\",endpoint=\"/book\","
+                        "status=\"0\",le=\"+Inf\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("clob_http_request_duration_seconds_bucket{method=\"GET\",endpoint=\"/book\","
+                        "status=\"0\",le=\"1\"} 0\n"), std::string::npos);
+    EXPECT_NE(text.find("clob_http_transport_errors_total 1\n"), std::string::npos);
+    EXPECT_NE(text.find("clob_metadata_cache_requests_total{cache=\"tick_size\",result=\"hit\"} 1\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("clob_orders_total{result=\"posted\"} 3\n"), std::string::npos);
+    EXPECT_NE(text.find("clob_heartbeats_total{result=\"error\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE clob_pool_connections gauge"), std::string::npos);
+
+    auto snap = metrics::snapshot();
+    EXPECT_DOUBLE_EQ(snap.tick_size.hit_rate(), 0.5);
+}
+
+TEST_F(MetricsTest, ClientRecordsRequestsOrdersAndCacheHits) {
+    MockExchange exchange;
+    exchange.start();
+    exchange.add_book(TOKEN_ID, {{"0.40", "100"}}, {{"0.60", "100"}});
+
+    auto signer = std::make_shared<Signer>(PRIVATE_KEY, POLYGON);
+    ApiCreds creds = ClobClient(exchange.url(), signer).create_or_derive_api_creds();
+    ClobClient client(exchange.url(), signer, creds);
+
+    client.get_tick_size(TOKEN_ID);
+    client.get_tick_size(TOKEN_ID);
+
+    OrderArgs limit;
+    limit.token_id = TOKEN_ID;
+    limit.price = 0.45;
+    limit.size = 10.0;
+    limit.side = Side::BUY;
+    EXPECT_TRUE(client.create_and_post_order(limit, {"0.01", false}).success);
+
+    MarketOrderArgs market;
+    market.token_id = TOKEN_ID;
+    market.amount = 10.0;
+    market.side = Side::BUY;
+    market.price = 0.60;
+    auto fok = client.create_market_order(market, {"0.01", false});
+    EXPECT_EQ(client.post_order(fok, OrderType::FOK).status, OrderStatusType::MATCHED);
+
+    auto tampered = client.create_order(limit, {"0.01", false});
+    tampered.order.maker_amount = std::to_string(std::stoull(tampered.order.maker_amount) + 1);
+    try {
+        client.post_order(tampered);
+    } catch (const std::exception&) {
+        // Counted as rejected either way
+    }
+
+    auto snap = metrics::snapshot();
+    EXPECT_EQ(snap.tick_size.hits, 1u);
+    EXPECT_EQ(snap.tick_size.misses, 1u);
+    EXPECT_EQ(snap.orders_posted, 3u);
+    EXPECT_EQ(snap.orders_filled, 1u);
+    EXPECT_EQ(snap.orders_rejected, 1u);
+    EXPECT_EQ(snap.signing.count, 3u);
+    EXPECT_GE(snap.pool_connections, 1);
+    EXPECT_EQ(snap.pool_in_use, 0);
+
+    const auto* posts = find_request(snap, "POST", "/order", 200);
+    ASSERT_NE(posts, nullptr);
+    EXPECT_GE(posts->count, 2u);
+    EXPECT_NE(find_request(snap, "GET", "/tick-size", 200), nullptr);
+}
+
+TEST_F(MetricsTest, ServesPrometheusEndpoint) {
+    metrics::record_orders(1, 0, 0);
+
+    metrics::MetricsServer server;
+    int port = server.start();
+    httplib::Client http("127.0.0.1", port);
+    auto res = http.Get("/metrics");
+    ASSERT_TRUE(res);
+    EXPECT_EQ(res->status, 200);
+    EXPECT_NE(res->body.find("clob_orders_total{result=\"posted\"} 1"), std::string::npos);
+    server.stop();
+}
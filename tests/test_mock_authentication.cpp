@@ -1,9 +1,12 @@
 #include <gtest/gtest.h>
 #include <clob/client.hpp>
 #include <clob/signer.hpp>
+#include <clob/eip712_struct.hpp>
 #include <httplib.h>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 using namespace clob;
@@ -14,6 +17,15 @@ const std::string TEST_API_KEY = "12345678-1234-1234-1234-123456789012";
 const std::string TEST_SECRET = "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA=";
 const std::string TEST_PASSPHRASE = "test-passphrase";
 
+// L1 headers seen by /auth/derive-api-key: (timestamp, nonce, signature)
+struct SeenL1Headers {
+    std::string timestamp;
+    std::string nonce;
+    std::string signature;
+};
+std::mutex g_seen_mutex;
+std::vector<SeenL1Headers> g_seen_l1;
+
 // Simple mock HTTP server for testing
 class MockServer {
 public:
@@ -34,6 +46,14 @@ public:
                     req.has_header("POLY_SIGNATURE") &&
                     req.has_header("POLY_TIMESTAMP") &&
                     req.has_header("POLY_NONCE")) {
+                    {
+                        std::lock_guard<std::mutex> lock(g_seen_mutex);
+                        g_seen_l1.push_back({
+                            req.get_header_value("POLY_TIMESTAMP"),
+                            req.get_header_value("POLY_NONCE"),
+                            req.get_header_value("POLY_SIGNATURE")
+                        });
+                    }
                     
                     json response = {
                         {"apiKey", TEST_API_KEY},
@@ -119,6 +139,41 @@ TEST(MockAuthenticationTest, L1HeadersShouldBeCreated) {
     });
 }
 
+TEST(MockAuthenticationTest, L1SignatureReusedWithinSameSecond) {
+    MockServer server;
+    server.start();
+    {
+        std::lock_guard<std::mutex> lock(g_seen_mutex);
+        g_seen_l1.clear();
+    }
+    
+    auto signer = std::make_shared<Signer>(TEST_PRIVATE_KEY, POLYGON);
+    ClobClient client(server.url(), signer);
+    client.derive_api_key(7);
+    client.derive_api_key(7);
+    client.derive_api_key(8);
+    
+    std::lock_guard<std::mutex> lock(g_seen_mutex);
+    ASSERT_EQ(g_seen_l1.size(), 3u);
+    
+    // Every signature, cached or fresh, is a valid ClobAuth signature
+    json domain = {{"name", "ClobAuthDomain"}, {"version", "1"}, {"chainId", POLYGON}};
+    for (const auto& seen : g_seen_l1) {
+        ClobAuth auth;
+        auth.address = signer->address();
+        auth.timestamp = seen.timestamp;
+        auth.nonce = std::stoull(seen.nonce);
+        auth.message = "This message attests that I control the given wallet";
+        auto hash = eip712::signing_hash(eip712::hash_domain(domain), auth);
+        EXPECT_TRUE(signer->verify(hash, seen.signature));
+    }
+    
+    if (g_seen_l1[0].timestamp == g_seen_l1[1].timestamp) {
+        EXPECT_EQ(g_seen_l1[0].signature, g_seen_l1[1].signature);
+    }
+    EXPECT_NE(g_seen_l1[1].signature, g_seen_l1[2].signature);
+}
+
 TEST(MockAuthenticationTest, L2HeadersShouldBeCreated) {
     MockServer server;
     server.start();
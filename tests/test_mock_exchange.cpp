@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <clob/client.hpp>
+#include <clob/signer.hpp>
+#include <mock_exchange.hpp>
+#include <chrono>
+#include <memory>
+
+using namespace clob;
+using clob::mock::MockExchange;
+
+namespace {
+
+const std::string PRIVATE_KEY = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+const std::string OTHER_KEY = "0x59c6995e998f97a5a0044966f0945389dc9e86dae88c7a8412f4603b6b78690d";
+const std::string TOKEN_ID = "71321045679252212594626385532706912750332728571942532289631379312455583992563";
+
+OrderArgs buy_args(double price, double size) {
+    OrderArgs args;
+    args.token_id = TOKEN_ID;
+    args.price = price;
+    args.size = size;
+    args.side = Side::BUY;
+    return args;
+}
+
+// L2 client for a wallet, with credentials derived from the exchange itself
+std::unique_ptr<ClobClient> authenticated_client(const MockExchange& exchange, const std::string& key) {
+    auto signer = std::make_shared<Signer>(key, POLYGON);
+    ClobClient l1(exchange.url(), signer);
+    ApiCreds creds = l1.create_or_derive_api_creds();
+    return std::make_unique<ClobClient>(exchange.url(), signer, creds);
+}
+
+} // namespace
+
+TEST(MockExchangeTest, DerivedCredentialsAuthenticateL2Requests) {
+    MockExchange exchange;
+    exchange.start();
+
+    auto client = authenticated_client(exchange, PRIVATE_KEY);
+    auto keys = client->get_api_keys();
+    ASSERT_TRUE(keys.keys.has_value());
+    EXPECT_EQ(keys.keys->size(), 1u);
+    EXPECT_EQ(exchange.stats().auth_failures, 0u);
+
+    // Same address, wrong secret: HMAC check fails
+    auto signer = std::make_shared<Signer>(PRIVATE_KEY, POLYGON);
+    ApiCreds forged = MockExchange::credentials_for(signer->address());
+    forged.api_secret = "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA=";
+    ClobClient bad(exchange.url(), signer, forged);
+    EXPECT_THROW(bad.get_api_keys(), std::runtime_error);
+    EXPECT_EQ(exchange.stats().auth_failures, 1u);
+}
+
+TEST(MockExchangeTest, OrderLifecycleOverRealSockets) {
+    MockExchange exchange;
+    exchange.start();
+    exchange.add_book(TOKEN_ID, {{"0.40", "100"}}, {{"0.60", "100"}});
+
+    auto client = authenticated_client(exchange, PRIVATE_KEY);
+    EXPECT_GT(client->get_server_time(), 0);
+
+    auto response = client->create_and_post_order(buy_args(0.45, 10.0), {"0.01", false});
+    EXPECT_TRUE(response.success);
+    EXPECT_EQ(response.status, OrderStatusType::LIVE);
+    EXPECT_EQ(response.order_id.size(), 66u);
+
+    auto book = client->get_order_book(TOKEN_ID);
+    ASSERT_EQ(book.bids.size(), 2u);
+    EXPECT_EQ(book.bids.back().price, "0.45");
+    EXPECT_EQ(book.bids.back().size, "10");
+
+    auto orders = client->get_orders();
+    ASSERT_EQ(orders.data.size(), 1u);
+    EXPECT_EQ(orders.data[0].id, response.order_id);
+    EXPECT_EQ(orders.data[0].price, "0.45");
+
+    auto canceled = client->cancel_all();
+    EXPECT_EQ(canceled.canceled.size(), 1u);
+    EXPECT_TRUE(client->get_orders().data.empty());
+    EXPECT_EQ(client->get_order_book(TOKEN_ID).bids.size(), 1u);
+}
+
+TEST(MockExchangeTest, CancelsOrdersInBatch) {
+    MockExchange exchange;
+    exchange.start();
+
+    auto client = authenticated_client(exchange, PRIVATE_KEY);
+    auto first = client->create_and_post_order(buy_args(0.45, 10.0), {"0.01", false});
+    auto second = client->create_and_post_order(buy_args(0.44, 10.0), {"0.01", false});
+    auto third = client->create_and_post_order(buy_args(0.43, 10.0), {"0.01", false});
+    ASSERT_EQ(exchange.open_orders(), 3u);
+
+    const std::string unknown = "0x" + std::string(64, 'f');
+    auto canceled = client->cancel_orders({first.order_id, unknown, second.order_id});
+    ASSERT_EQ(canceled.canceled.size(), 2u);
+    EXPECT_EQ(canceled.canceled[0], first.order_id);
+    EXPECT_EQ(canceled.canceled[1], second.order_id);
+    ASSERT_EQ(canceled.not_canceled.size(), 1u);
+    EXPECT_EQ(canceled.not_canceled.count(unknown), 1u);
+
+    // Already canceled ids are reported, not canceled twice
+    canceled = client->cancel_orders({first.order_id});
+    EXPECT_TRUE(canceled.canceled.empty());
+    EXPECT_EQ(canceled.not_canceled.count(first.order_id), 1u);
+
+    auto orders = client->get_orders();
+    ASSERT_EQ(orders.data.size(), 1u);
+    EXPECT_EQ(orders.data[0].id, third.order_id);
+    EXPECT_EQ(exchange.stats().orders_canceled, 2u);
+
+    // Another account cannot cancel it
+    auto other = authenticated_client(exchange, OTHER_KEY);
+    EXPECT_TRUE(other->cancel_orders({third.order_id}).canceled.empty());
+    EXPECT_EQ(exchange.open_orders(), 1u);
+}
+
+TEST(MockExchangeTest, CancelsMarketOrders) {
+    const std::string other_token = "1234";
+    MockExchange exchange;
+    exchange.start();
+
+    auto client = authenticated_client(exchange, PRIVATE_KEY);
+    client->create_and_post_order(buy_args(0.45, 10.0), {"0.01", false});
+    client->create_and_post_order(buy_args(0.44, 10.0), {"0.01", false});
+    OrderArgs other = buy_args(0.30, 10.0);
+    other.token_id = other_token;
+    auto kept = client->create_and_post_order(other, {"0.01", false});
+
+    auto canceled = client->cancel_market_orders("", TOKEN_ID);
+    EXPECT_EQ(canceled.canceled.size(), 2u);
+    auto orders = client->get_orders();
+    ASSERT_EQ(orders.data.size(), 1u);
+    EXPECT_EQ(orders.data[0].id, kept.order_id);
+
+    canceled = client->cancel_market_orders(orders.data[0].market);
+    EXPECT_EQ(canceled.canceled.size(), 1u);
+    EXPECT_EQ(exchange.open_orders(), 0u);
+}
+
+TEST(MockExchangeTest, RejectsTamperedOrderSignature) {
+    MockExchange exchange;
+    exchange.start();
+
+    auto client = authenticated_client(exchange, PRIVATE_KEY);
+    auto order = client->create_order(buy_args(0.45, 10.0), {"0.01", false});
+    order.order.maker_amount = std::to_string(std::stoull(order.order.maker_amount) + 1);
+
+    EXPECT_THROW(client->post_order(order), std::runtime_error);
+    EXPECT_EQ(exchange.stats().signature_failures, 1u);
+    EXPECT_EQ(exchange.open_orders(), 0u);
+}
+
+TEST(MockExchangeTest, OrdersAreScopedToTheirApiKey) {
+    MockExchange exchange;
+    exchange.start();
+
+    auto alice = authenticated_client(exchange, PRIVATE_KEY);
+    auto bob = authenticated_client(exchange, OTHER_KEY);
+    alice->create_and_post_order(buy_args(0.45, 10.0), {"0.01", false});
+
+    EXPECT_TRUE(bob->get_orders().data.empty());
+    EXPECT_TRUE(bob->cancel_all().canceled.empty());
+    EXPECT_EQ(alice->get_orders().data.size(), 1u);
+}
+
+TEST(MockExchangeTest, InjectsLatencyAndErrors) {
+    MockExchange exchange;
+    exchange.start();
+    ClobClient client(exchange.url());
+
+    exchange.set_latency(std::chrono::milliseconds(30));
+    auto start = std::chrono::steady_clock::now();
+    client.get_server_time();
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(30));
+
+    exchange.set_latency(std::chrono::microseconds(0));
+    exchange.set_error_rate(1.0);
+    EXPECT_THROW(client.get_server_time(), std::runtime_error);
+    EXPECT_EQ(exchange.stats().injected_errors, 1u);
+
+    exchange.set_error_rate(0.0);
+    EXPECT_NO_THROW(client.get_server_time());
+}
@@ -2,6 +2,7 @@
 #include <clob/order_builder.hpp>
 #include <clob/signer.hpp>
 #include <clob/constants.hpp>
+#include <vector>
 
 // Test order builder initialization
 TEST(OrderBuilderTest, Initialization) {
@@ -36,6 +37,129 @@ TEST(OrderBuilderTest, CreateValidOrder) {
     });
 }
 
+static clob::OrderArgs verification_order_args() {
+    clob::OrderArgs args;
+    args.token_id = "42334954850219754195241248003172889699504912694714162671145392673031415571339";
+    args.price = 0.50;
+    args.size = 100.0;
+    args.side = clob::Side::BUY;
+    return args;
+}
+
+// Test blocking signature self-check and its timing stats
+TEST(OrderBuilderTest, BlockingSignatureVerification) {
+    std::string pk = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+    auto signer = std::make_shared<clob::Signer>(pk, clob::POLYGON);
+    clob::OrderBuilder builder(signer);
+    builder.set_signature_verification(clob::SignatureVerification::Blocking);
+    
+    clob::CreateOrderOptions options;
+    options.tick_size = "0.01";
+    
+    auto order = builder.create_order(verification_order_args(), options);
+    EXPECT_FALSE(order.verification.valid());  // checked inline, nothing pending
+    
+    auto stats = builder.get_verification_stats();
+    EXPECT_EQ(stats.count, 1u);
+    EXPECT_EQ(stats.failures, 0u);
+    EXPECT_GT(stats.total_ns, 0u);
+    EXPECT_GE(stats.max_ns, stats.total_ns);
+}
+
+// Test parallel signature self-check
+TEST(OrderBuilderTest, ParallelSignatureVerification) {
+    std::string pk = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+    auto signer = std::make_shared<clob::Signer>(pk, clob::POLYGON);
+    clob::OrderBuilder builder(signer);
+    builder.set_signature_verification(clob::SignatureVerification::Parallel);
+    
+    clob::CreateOrderOptions options;
+    options.tick_size = "0.01";
+    
+    auto order = builder.create_order(verification_order_args(), options);
+    ASSERT_TRUE(order.verification.valid());
+    EXPECT_TRUE(order.verification.get());
+    EXPECT_EQ(builder.get_verification_stats().count, 1u);
+    
+    // Off by default
+    clob::OrderBuilder plain(signer);
+    EXPECT_FALSE(plain.create_order(verification_order_args(), options).verification.valid());
+    EXPECT_EQ(plain.get_verification_stats().count, 0u);
+}
+
+// The check targets the order's signer field, not the maker (funder)
+TEST(OrderBuilderTest, VerificationChecksOrderSigner) {
+    std::string pk = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+    auto signer = std::make_shared<clob::Signer>(pk, clob::POLYGON);
+    std::string funder = "0x70997970C51812dc3A010C7d01b50e0d17dc79C8";
+    clob::OrderBuilder builder(signer, clob::SignatureType::PROXY, funder);
+    builder.set_signature_verification(clob::SignatureVerification::Parallel);
+    
+    clob::CreateOrderOptions options;
+    options.tick_size = "0.01";
+    
+    // Many in flight at once share the pool's workers
+    std::vector<clob::SignedOrder> orders;
+    for (int i = 0; i < 32; ++i) {
+        orders.push_back(builder.create_order(verification_order_args(), options));
+    }
+    for (auto& order : orders) {
+        EXPECT_EQ(order.order.maker, funder);
+        EXPECT_EQ(order.order.signer, signer->address());
+        EXPECT_TRUE(order.verification.get());
+    }
+    EXPECT_EQ(builder.get_verification_stats().count, 32u);
+    EXPECT_EQ(builder.get_verification_stats().failures, 0u);
+}
+
+// A signature that does not recover to the order signer is caught
+TEST(OrderBuilderTest, BlockingVerificationRejectsMismatch) {
+    std::string pk = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+    auto signer = std::make_shared<clob::Signer>(pk, clob::POLYGON);
+    clob::OrderBuilder builder(signer);
+    builder.set_signature_verification(clob::SignatureVerification::Blocking);
+    
+    clob::CreateOrderOptions options;
+    options.tick_size = "0.01";
+    
+    auto order = builder.create_order(verification_order_args(), options);
+    EXPECT_NO_THROW(builder.verify_order(order));
+    
+    // Signer field differs from the signing key
+    auto wrong_signer = order;
+    wrong_signer.order.signer = "0x70997970c51812dc3a010c7d01b50e0d17dc79c8";
+    EXPECT_THROW(builder.verify_order(wrong_signer), std::runtime_error);
+    
+    // Corrupted signature (flip a nibble of r)
+    auto corrupted = order;
+    corrupted.signature[4] = corrupted.signature[4] == 'a' ? 'b' : 'a';
+    EXPECT_THROW(builder.verify_order(corrupted), std::runtime_error);
+    
+    auto stats = builder.get_verification_stats();
+    EXPECT_EQ(stats.count, 4u);
+    EXPECT_EQ(stats.failures, 2u);
+}
+
+// Parallel reports a mismatch through the future instead of throwing
+TEST(OrderBuilderTest, ParallelVerificationReportsMismatch) {
+    std::string pk = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+    auto signer = std::make_shared<clob::Signer>(pk, clob::POLYGON);
+    clob::OrderBuilder builder(signer);
+    builder.set_signature_verification(clob::SignatureVerification::Parallel);
+    
+    clob::CreateOrderOptions options;
+    options.tick_size = "0.01";
+    
+    auto order = builder.create_order(verification_order_args(), options);
+    ASSERT_TRUE(order.verification.get());
+    
+    order.order.signer = "0x70997970c51812dc3a010c7d01b50e0d17dc79c8";
+    EXPECT_NO_THROW(builder.verify_order(order));
+    ASSERT_TRUE(order.verification.valid());
+    EXPECT_FALSE(order.verification.get());
+    EXPECT_EQ(builder.get_verification_stats().failures, 1u);
+}
+
 // Test market price calculations
 TEST(OrderBuilderTest, CalculateBuyMarketPrice) {
     std::string pk = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
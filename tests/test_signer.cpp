@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <clob/signer.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 // Test signer initialization with valid private key
 TEST(SignerTest, InitializeWithValidKey) {
@@ -40,6 +43,67 @@ TEST(SignerTest, AddressDerivation) {
     EXPECT_EQ(signer.address(), expected);
 }
 
+// Test cached address forms (lowercase, EIP-55 checksum, raw bytes)
+TEST(SignerTest, CachedAddressForms) {
+    std::string private_key = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+    clob::Signer signer(private_key, clob::POLYGON);
+    
+    EXPECT_EQ(signer.checksum_address(), "0xf39Fd6e51aad88F6F4ce6aB8827279cffFb92266");
+    EXPECT_EQ(signer.address_bytes()[0], 0xf3);
+    EXPECT_EQ(signer.address_bytes()[19], 0x66);
+    
+    // References to the same cached string on every call
+    EXPECT_EQ(&signer.address(), &signer.address());
+}
+
+// Test concurrent signing from many threads (per-thread contexts)
+TEST(SignerTest, ConcurrentSigningIsDeterministic) {
+    std::string private_key = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+    clob::Signer signer(private_key, clob::POLYGON);
+    
+    std::array<uint8_t, 32> hash{};
+    hash.fill(0x42);
+    std::string expected = signer.sign(hash);
+    
+    std::vector<std::thread> threads;
+    std::atomic<int> mismatches{0};
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 50; ++i) {
+                if (signer.sign(hash) != expected) mismatches++;
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    
+    EXPECT_EQ(mismatches.load(), 0);
+    
+    // Signers no longer own a context, so copies are independent and valid
+    clob::Signer copy = signer;
+    EXPECT_EQ(copy.sign(hash), expected);
+}
+
+// Test public key recovery based verification
+TEST(SignerTest, VerifyRecoversSignerAddress) {
+    clob::Signer signer("0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80", clob::POLYGON);
+    clob::Signer other("0x59c6995e998f97a0a44496d9bbbea2c46f1c3ffa87bcbb7ae2d9a8fb4e0e5e45", clob::POLYGON);
+    
+    std::array<uint8_t, 32> hash{};
+    hash.fill(0x17);
+    std::string signature = signer.sign(hash);
+    
+    EXPECT_EQ(clob::Signer::recover_address(hash, signature), signer.address_bytes());
+    EXPECT_TRUE(signer.verify(hash, signature));
+    EXPECT_FALSE(other.verify(hash, signature));
+    
+    // Different message, malformed signature
+    std::array<uint8_t, 32> other_hash{};
+    other_hash.fill(0x18);
+    EXPECT_FALSE(signer.verify(other_hash, signature));
+    EXPECT_FALSE(signer.verify(hash, "0x1234"));
+    EXPECT_THROW(clob::Signer::recover_address(hash, "0x1234"), std::runtime_error);
+}
+
 // Test chain ID is stored correctly
 TEST(SignerTest, ChainIdStorage) {
     std::string private_key = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <clob/order_builder.hpp>
+#include <clob/signer.hpp>
+#include <clob/trace.hpp>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace clob;
+
+namespace {
+
+const std::string PRIVATE_KEY = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+
+// Tracing state is process-wide: every test starts enabled and empty
+class TraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        trace::enable(true);
+        trace::clear();
+    }
+
+    void TearDown() override {
+        trace::enable(false);
+        trace::clear();
+    }
+};
+
+size_t count_named(const std::vector<trace::Event>& events, const std::string& name) {
+    return std::count_if(events.begin(), events.end(), [&](const trace::Event& e) { return name == e.name; });
+}
+
+} // namespace
+
+TEST_F(TraceTest, RecordsNestedSpans) {
+    {
+        trace::Span outer("outer");
+        trace::Span inner("inner", "test");
+        inner.end();
+    }
+
+    auto events = trace::collect();
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_STREQ(events[0].name, "outer");
+    EXPECT_STREQ(events[1].name, "inner");
+    EXPECT_STREQ(events[1].category, "test");
+    EXPECT_LE(events[0].start_ns, events[1].start_ns);
+    EXPECT_GE(events[0].start_ns + events[0].duration_ns, events[1].start_ns + events[1].duration_ns);
+    EXPECT_EQ(events[0].thread_id, events[1].thread_id);
+}
+
+TEST_F(TraceTest, DisabledSpansAreNotRecorded) {
+    trace::enable(false);
+    { trace::Span span("ignored"); }
+    EXPECT_TRUE(trace::collect().empty());
+
+    // A span opened while disabled stays unrecorded even if tracing turns on
+    trace::Span span("opened_disabled");
+    trace::enable(true);
+    span.end();
+    EXPECT_TRUE(trace::collect().empty());
+}
+
+TEST_F(TraceTest, ThreadsRecordIntoSeparateBuffers) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 100; ++i) {
+                trace::Span span("worker");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Spans of finished threads are still collected
+    auto events = trace::collect();
+    EXPECT_EQ(count_named(events, "worker"), 400u);
+    std::set<uint32_t> thread_ids;
+    for (const auto& event : events) {
+        thread_ids.insert(event.thread_id);
+    }
+    EXPECT_EQ(thread_ids.size(), 4u);
+    EXPECT_TRUE(std::is_sorted(events.begin(), events.end(), [](const trace::Event& a, const trace::Event& b) {
+        return a.start_ns < b.start_ns;
+    }));
+}
+
+TEST_F(TraceTest, ExitedThreadsHandOverTheirBuffers) {
+    { trace::Span span("main"); }
+    size_t before = trace::buffer_count();
+    for (int i = 0; i < 50; ++i) {
+        std::thread([] { trace::Span span("short_lived"); }).join();
+    }
+    EXPECT_LE(trace::buffer_count(), before + 1);
+
+    // Reused rings keep earlier owners' spans, each under its own thread id
+    auto events = trace::collect();
+    EXPECT_EQ(count_named(events, "short_lived"), 50u);
+    std::set<uint32_t> thread_ids;
+    for (const auto& event : events) {
+        if (std::string(event.name) == "short_lived") {
+            thread_ids.insert(event.thread_id);
+        }
+    }
+    EXPECT_EQ(thread_ids.size(), 50u);
+}
+
+TEST_F(TraceTest, RingKeepsNewestSpans) {
+    trace::set_buffer_capacity(5);  // rounded up to 8
+    std::thread([] {
+        for (int i = 0; i < 20; ++i) {
+            trace::Span span(i < 12 ? "old" : "new");
+        }
+    }).join();
+    trace::set_buffer_capacity(8192);
+
+    auto events = trace::collect();
+    EXPECT_EQ(count_named(events, "old"), 0u);
+    EXPECT_EQ(count_named(events, "new"), 8u);
+}
+
+TEST_F(TraceTest, ExportsChromeTraceJson) {
+    { trace::Span span("http.post", "clob"); }
+
+    auto exported = nlohmann::json::parse(trace::export_chrome_json());
+    ASSERT_TRUE(exported.contains("traceEvents"));
+    ASSERT_EQ(exported["traceEvents"].size(), 1u);
+    const auto& event = exported["traceEvents"][0];
+    EXPECT_EQ(event["name"], "http.post");
+    EXPECT_EQ(event["cat"], "clob");
+    EXPECT_EQ(event["ph"], "X");
+    EXPECT_EQ(event["ts"].get<double>(), 0.0);
+    EXPECT_GE(event["dur"].get<double>(), 0.0);
+    EXPECT_TRUE(event.contains("tid"));
+}
+
+TEST_F(TraceTest, OrderCreationEmitsStageSpans) {
+    OrderBuilder builder(std::make_shared<Signer>(PRIVATE_KEY, POLYGON));
+    OrderArgs args;
+    args.token_id = "1234";
+    args.price = 0.5;
+    args.size = 10.0;
+    args.side = Side::BUY;
+    builder.create_order(args, {"0.01", false});
+
+    auto events = trace::collect();
+#if CLOB_ENABLE_TRACING
+    EXPECT_EQ(count_named(events, "order.create"), 1u);
+    EXPECT_EQ(count_named(events, "order.hash"), 1u);
+    EXPECT_EQ(count_named(events, "order.sign"), 1u);
+#else
+    EXPECT_TRUE(events.empty());
+#endif
+}